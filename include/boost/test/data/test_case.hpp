@@ -148,12 +148,12 @@ private:                                                                \
     static void _impl(BOOST_DATA_TEST_CASE_PARAMS( params ));           \
 };                                                                      \
                                                                         \
-BOOST_AUTO_TU_REGISTRAR( test_name )(                                   \
+BOOST_AUTO_TU_REGISTRATION( test_name, (                                \
     boost::unit_test::data::ds_detail::make_test_case_gen<test_name>(   \
           BOOST_STRINGIZE( test_name ),                                 \
           __FILE__, __LINE__,                                           \
           boost::unit_test::data::make(dataset) ),                      \
-    boost::unit_test::decorator::collector::instance() );               \
+    boost::unit_test::decorator::collector::instance() ) );             \
                                                                         \
     template<BOOST_PP_ENUM_PARAMS(arity, typename Arg)>                 \
     void test_name::_impl( BOOST_DATA_TEST_CASE_PARAMS( params ) )      \
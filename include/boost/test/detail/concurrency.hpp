@@ -0,0 +1,69 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//!@file
+//!@brief synchronization primitives used for concurrent execution of test cases
+// ***************************************************************************
+
+#ifndef BOOST_TEST_CONCURRENCY_HPP_101615GER
+#define BOOST_TEST_CONCURRENCY_HPP_101615GER
+
+// Boost.Test
+#include <boost/test/detail/config.hpp>
+
+#if !defined(BOOST_NO_CXX11_HDR_THREAD) && !defined(BOOST_NO_CXX11_HDR_MUTEX) && \
+    !defined(BOOST_NO_CXX11_HDR_ATOMIC) && !defined(BOOST_NO_CXX11_THREAD_LOCAL) && \
+    !defined(BOOST_TEST_DISABLE_CONCURRENT_EXECUTION)
+#  define BOOST_TEST_CONCURRENT_EXECUTION
+#endif
+
+#ifdef BOOST_TEST_CONCURRENT_EXECUTION
+
+// STL
+#  include <mutex>
+
+#  define BOOST_TEST_THREAD_LOCAL thread_local
+#else
+#  define BOOST_TEST_THREAD_LOCAL
+#endif
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+namespace ut_detail {
+
+#ifdef BOOST_TEST_CONCURRENT_EXECUTION
+
+typedef std::recursive_mutex                        recursive_mutex;
+typedef std::lock_guard<std::recursive_mutex>       scoped_lock;
+
+#else
+
+struct recursive_mutex {
+    void    lock()      {}
+    void    unlock()    {}
+};
+
+struct scoped_lock {
+    explicit scoped_lock( recursive_mutex& ) {}
+};
+
+#endif
+
+/// Serializes access to the test observers and the log while test cases are executed concurrently
+BOOST_TEST_DECL recursive_mutex& framework_mutex();
+
+} // namespace ut_detail
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_CONCURRENCY_HPP_101615GER
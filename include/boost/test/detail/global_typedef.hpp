@@ -44,7 +44,17 @@ enum report_level  { INV_REPORT_LEVEL, CONFIRMATION_REPORT, SHORT_REPORT, DETAIL
 enum output_format { OF_INVALID,
                      OF_CLF, ///< compiler log format
                      OF_XML, ///< XML format for report and log,
-                     OF_DOT  ///< dot format for output content 
+                     OF_DOT, ///< dot format for output content 
+                     OF_BIN, ///< binary format for log
+                     OF_JSON ///< JSON lines format for log
+};
+
+//____________________________________________________________________________//
+
+enum flush_mode { FLUSH_LINE,   ///< flush after each log record
+                  FLUSH_UNIT,   ///< flush at the test units boundaries
+                  FLUSH_BYTES,  ///< flush each time the given amount of output is buffered
+                  FLUSH_END     ///< flush at the end of the test run
 };
 
 //____________________________________________________________________________//
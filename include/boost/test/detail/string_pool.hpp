@@ -0,0 +1,66 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//!@file
+//!@brief defines the pool of the strings the test units refer to
+// ***************************************************************************
+
+#ifndef BOOST_TEST_DETAIL_STRING_POOL_HPP
+#define BOOST_TEST_DETAIL_STRING_POOL_HPP
+
+// Boost.Test
+#include <boost/test/detail/config.hpp>
+#include <boost/test/utils/basic_cstring/basic_cstring.hpp>
+#include <boost/test/utils/basic_cstring/compare.hpp>
+
+// STL
+#include <string>
+#include <list>
+#include <set>
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+namespace ut_detail {
+
+// ************************************************************************** //
+// **************                  string_pool                 ************** //
+// ************************************************************************** //
+
+/// Module lifetime storage for the file names of the test units
+
+/// Each string is stored once and stays valid till the end of the module, even if the buffer it was passed in
+/// goes away. Like the registration of the test units, the pool is not synchronized.
+class BOOST_TEST_DECL string_pool {
+public:
+    /// The pool of the module
+    static string_pool& instance();
+
+    /// Returns the stored copy of the string, which is added on the first request
+    const_string    intern( const_string s );
+
+private:
+    string_pool() {}
+    string_pool( string_pool const& );
+    void            operator=( string_pool const& );
+
+    // Data members
+    std::list<std::string>  m_storage;
+    std::set<const_string>  m_strings;
+    const_string            m_last_interned;    ///< the consecutive test units mostly come from the same file
+};
+
+} // namespace ut_detail
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_DETAIL_STRING_POOL_HPP
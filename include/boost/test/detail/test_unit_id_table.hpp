@@ -0,0 +1,119 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//!@file
+//!@brief defines a table of values indexed by test unit id
+// ***************************************************************************
+
+#ifndef BOOST_TEST_DETAIL_TEST_UNIT_ID_TABLE_HPP
+#define BOOST_TEST_DETAIL_TEST_UNIT_ID_TABLE_HPP
+
+// Boost.Test
+#include <boost/test/detail/global_typedef.hpp>
+
+// STL
+#include <vector>
+#include <algorithm>
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+namespace ut_detail {
+
+// ************************************************************************** //
+// **************              test_unit_id_table              ************** //
+// ************************************************************************** //
+
+/// Values indexed by test unit id
+
+/// Test case and test suite ids are handed out sequentially starting from MIN_TEST_CASE_ID and MIN_TEST_SUITE_ID,
+/// so the values for each kind of test units are kept in a contiguous table indexed by (id - base). Slots are never
+/// removed: the ids are not reused.
+template<typename T>
+class test_unit_id_table {
+public:
+    typedef typename std::vector<T>::size_type size_type;
+
+    explicit    test_unit_id_table( T const& empty_value = T() ) : m_empty_value( empty_value ) {}
+
+    /// Returns the slot of the test unit, or 0 if there is none for this id
+    T*          find( test_unit_id id )
+    {
+        std::vector<T>& t = table( id );
+        size_type       i = index( id );
+
+        return i < t.size() ? &t[i] : 0;
+    }
+    T const*    find( test_unit_id id ) const
+    {
+        return const_cast<test_unit_id_table*>( this )->find( id );
+    }
+
+    /// Returns the slot of the test unit; the missing slots up to it are added with the empty value.
+    /// The id has to be a valid test unit id
+    T&          operator[]( test_unit_id id )
+    {
+        std::vector<T>& t = table( id );
+        size_type       i = index( id );
+
+        if( i >= t.size() )
+            t.resize( i + 1, m_empty_value );
+
+        return t[i];
+    }
+
+    /// Adds the slots for the test units with ids below the given ones, so that
+    /// the references to the slots are not invalidated by operator[] for those ids
+    void        reserve( test_unit_id next_test_case_id, test_unit_id next_test_suite_id )
+    {
+        if( next_test_case_id > MIN_TEST_CASE_ID && m_test_cases.size() < next_test_case_id - MIN_TEST_CASE_ID )
+            m_test_cases.resize( next_test_case_id - MIN_TEST_CASE_ID, m_empty_value );
+        if( next_test_suite_id > MIN_TEST_SUITE_ID && m_test_suites.size() < next_test_suite_id - MIN_TEST_SUITE_ID )
+            m_test_suites.resize( next_test_suite_id - MIN_TEST_SUITE_ID, m_empty_value );
+    }
+
+    /// Resets all the slots to the empty value
+    void        reset()
+    {
+        std::fill( m_test_cases.begin(), m_test_cases.end(), m_empty_value );
+        std::fill( m_test_suites.begin(), m_test_suites.end(), m_empty_value );
+    }
+
+    /// Applies the function to every slot, test suites first
+    template<typename F>
+    void        for_each( F f )
+    {
+        for( size_type i = 0; i < m_test_suites.size(); ++i )
+            f( static_cast<test_unit_id>( MIN_TEST_SUITE_ID + i ), m_test_suites[i] );
+        for( size_type i = 0; i < m_test_cases.size(); ++i )
+            f( static_cast<test_unit_id>( MIN_TEST_CASE_ID + i ), m_test_cases[i] );
+    }
+
+private:
+    std::vector<T>& table( test_unit_id id )    { return test_id_2_unit_type( id ) == TUT_SUITE ? m_test_suites : m_test_cases; }
+    static size_type index( test_unit_id id )
+    {
+        // ids below the base wrap around to the values no table reaches
+        return static_cast<size_type>( id - (test_id_2_unit_type( id ) == TUT_SUITE ? MIN_TEST_SUITE_ID : MIN_TEST_CASE_ID) );
+    }
+
+    // Data members
+    std::vector<T>  m_test_cases;
+    std::vector<T>  m_test_suites;
+    T               m_empty_value;
+};
+
+} // namespace ut_detail
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_DETAIL_TEST_UNIT_ID_TABLE_HPP
@@ -27,6 +27,10 @@
 #include <boost/cstdlib.hpp>
 #include <boost/function/function0.hpp>
 
+// STL
+#include <vector>
+#include <limits>
+
 #include <boost/test/detail/suppress_warnings.hpp>
 
 #ifdef BOOST_SEH_BASED_SIGNAL_HANDLING
@@ -197,6 +201,18 @@ protected:
     std::string                 m_tag;
 };
 
+// signal handling set up for a monitoring session; defined by the implementation
+class signal_session;
+
+// converts the time-out in seconds into milliseconds; the ones not representable are saturated
+inline unsigned
+timeout_in_ms( unsigned timeout )
+{
+    unsigned const max_timeout = (std::numeric_limits<unsigned>::max)();
+
+    return timeout > max_timeout / 1000 ? max_timeout : timeout * 1000;
+}
+
 } // namespace detail
 
 // ************************************************************************** //
@@ -313,6 +329,11 @@ public:
     /// or indefinite loops. This feature is only available for some operating systems (not yet Microsoft Windows).
     unit_test::readwrite_property<unsigned>  p_timeout;
 
+    ///  Specifies the milliseconds that elapse before a timer_error occurs.
+    ///
+    /// The @em p_timeout_ms property is the same timeout with millisecond granularity. If non-zero, it takes precedence over @em p_timeout.
+    unit_test::readwrite_property<unsigned>  p_timeout_ms;
+
     ///  Should monitor use alternative stack for the signal catching.
     ///
     /// The @em p_use_alt_stack property is a boolean flag (default value is false) specifying whether or not execution_monitor should use an alternative stack
@@ -349,6 +370,32 @@ public:
     void         vexecute( boost::function<void ()> const& F );
     // @}
 
+    // @name Monitoring session
+
+    /// @brief Starts a monitoring session
+    ///
+    /// Installs the signal handlers and the alternative stack once for all the calls to execute made until the session
+    /// is stopped, instead of on every call. Within the session each call only arms and disarms the timeout. The properties
+    /// the session was started with are expected to stay unchanged until it is stopped. Sessions can be nested.
+    void        start_session();
+
+    /// @brief Stops the monitoring session started last
+    ///
+    /// Restores the signal handling and the properties of the enclosing session, if any.
+    void        stop_session();
+
+    /// Returns true if a monitoring session is in progress
+    bool        in_session() const { return !m_sessions.empty(); }
+    // @}
+
+    /// @brief Sets the function called before the process is terminated by a signal arriving outside of the monitored calls
+    ///
+    /// The function is meant to write out the buffered output. It is called from the signal handler, which may interrupt
+    /// any code including the one the function would use, so it has to restrict itself to async-signal-safe functions:
+    /// no locks, no memory allocations and no streams.
+    /// @param[in] hook  function to call or 0
+    static void set_fatal_signal_hook( void (*hook)() );
+
     // @name Exception translator registration
 
     /// @brief Registers custom (user supplied) exception translator
@@ -390,13 +437,31 @@ public:
     //@}
 #endif
 
+    /// @brief Makes this monitor use the same custom exception translators as another one
+
+    /// @param[in] em   execution monitor to share the translators with
+    void        share_exception_translators( execution_monitor const& em )
+    {
+        m_custom_translators = em.m_custom_translators;
+    }
+
 private:
     // implementation helpers
     int         catch_signals( boost::function<int ()> const& F );
+    void        start_signal_session();
+
+    struct session {
+        bool                                        m_catch_system_errors;
+        bool                                        m_auto_start_dbg;
+        bool                                        m_use_alt_stack;
+        unsigned                                    m_detect_fp_exceptions;
+        boost::shared_ptr<detail::signal_session>   m_signals;
+    };
 
     // Data members
     detail::translator_holder_base_ptr  m_custom_translators;
     boost::scoped_array<char>           m_alt_stack;
+    std::vector<session>                m_sessions;
 }; // execution_monitor
 
 // ************************************************************************** //
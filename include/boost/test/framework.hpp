@@ -20,6 +20,9 @@
 
 #include <boost/test/utils/trivial_singleton.hpp>
 
+// Boost
+#include <boost/shared_ptr.hpp>
+
 #include <boost/test/detail/suppress_warnings.hpp>
 
 // STL
@@ -162,6 +165,13 @@ private:
 /// @param[in] sticky is this sticky frame or not
 /// @returns id of the newly created frame
 BOOST_TEST_DECL int                 add_context( lazy_ostream const& context_descr, bool sticky );
+/// Records context frame message, which is formatted only if the context is reported.
+
+/// The message holds copies of the values it prints (see lazy_ostream_value).
+/// @param[in] context_descr context frame message
+/// @param[in] sticky is this sticky frame or not
+/// @returns id of the newly created frame
+BOOST_TEST_DECL int                 add_context( boost::shared_ptr<lazy_ostream const> const& context_descr, bool sticky );
 /// Erases context frame (when test exits context scope)
 
 /// If context_id is passed clears that specific context frame identified by this id, otherwise clears all non sticky contexts.
@@ -236,6 +246,22 @@ BOOST_TEST_DECL void                test_unit_aborted( test_unit const& );
 namespace impl {
 // exclusively for self test
 BOOST_TEST_DECL void                setup_for_execution( test_unit const& );
+
+// makes the calling thread, which does not execute test cases, report the given test case as the current one;
+// used by the thread writing the log on behalf of the test cases
+BOOST_TEST_DECL void                set_current_test_case( test_unit_id tc_id );
+
+// makes the given test case the current one for the calling thread and returns the previous one; used to write the
+// log recorded on behalf of the test case after it is finished
+BOOST_TEST_DECL test_unit_id        exchange_current_test_case( test_unit_id tc_id );
+
+// returns the id the next registered test unit of the given type (TUT_CASE or TUT_SUITE) gets; used to size the
+// tables indexed by test unit id
+BOOST_TEST_DECL test_unit_id        next_test_unit_id( test_unit_type t );
+
+// returns the number of test cases enabled in the test tree with the given root, as of the last time the run status
+// was deduced; used to account for the test cases of a skipped test suite
+BOOST_TEST_DECL counter_t           enabled_test_cases( test_unit_id tu_id );
 } // namespace impl
 
 // ************************************************************************** //
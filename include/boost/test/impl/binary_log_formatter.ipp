@@ -0,0 +1,677 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : implements OF_BIN Log formatter and the reader of the binary log
+// ***************************************************************************
+
+#ifndef BOOST_TEST_BINARY_LOG_FORMATTER_IPP_101615GER
+#define BOOST_TEST_BINARY_LOG_FORMATTER_IPP_101615GER
+
+// Boost.Test
+#include <boost/test/output/binary_log_formatter.hpp>
+#include <boost/test/execution_monitor.hpp>
+#include <boost/test/framework.hpp>
+#include <boost/test/tree/test_unit.hpp>
+#include <boost/test/detail/throw_exception.hpp>
+#include <boost/test/utils/foreach.hpp>
+#include <boost/test/utils/lazy_ostream.hpp>
+
+// Boost
+#include <boost/version.hpp>
+
+// STL
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+namespace output {
+
+namespace {
+
+// longer strings are always written in place
+const std::size_t   max_interned_size   = 256;
+
+// bounds the memory used by the string table; the strings which do not fit are written in place
+const std::size_t   max_strings_num     = 0x10000;
+const std::size_t   max_seen_num        = 0x40000;
+
+const_string        header_magic( "BTLG" );
+
+//____________________________________________________________________________//
+
+void
+append_number( std::string& buffer, uintmax_t value )
+{
+    while( value >= 0x80 ) {
+        buffer += static_cast<char>( (value & 0x7F) | 0x80 );
+        value >>= 7;
+    }
+
+    buffer += static_cast<char>( value );
+}
+
+//____________________________________________________________________________//
+
+void
+append_string( std::string& buffer, const_string value )
+{
+    append_number( buffer, (static_cast<uintmax_t>( value.size() ) << 1) | 1 );
+    buffer.append( value.begin(), value.size() );
+}
+
+//____________________________________________________________________________//
+
+test_unit_id
+current_test_case_id()
+{
+    return framework::test_in_progress() ? framework::current_test_case_id() : INV_TEST_UNIT_ID;
+}
+
+} // local namespace
+
+// ************************************************************************** //
+// **************             binary_log_formatter             ************** //
+// ************************************************************************** //
+
+std::size_t
+binary_log_formatter::string_hash::operator()( const_string s ) const
+{
+    // FNV-1a
+    std::size_t res = 2166136261U;
+
+    BOOST_TEST_FOREACH( char, c, s ) {
+        res ^= static_cast<unsigned char>( c );
+        res *= 16777619U;
+    }
+
+    return res;
+}
+
+//____________________________________________________________________________//
+
+binary_log_formatter::binary_log_formatter()
+: m_record_type( binary_log::HEADER )
+, m_stream( 0 )
+, m_value_stream( &m_value_buffer )
+{
+    m_record.reserve( 1024 );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::set_stream( std::ostream& ostr )
+{
+    // the log written into another stream does not refer to the strings and test units defined in the previous one
+    if( &ostr != m_stream ) {
+        m_stream = &ostr;
+        m_string_ids.clear();
+        m_strings.clear();
+        m_seen_strings.clear();
+        m_defined_units.clear();
+
+        m_record.clear();
+        append_string( m_record, header_magic );
+        append_number( m_record, binary_log::format_version );
+        append_record( binary_log::HEADER, m_record );
+    }
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::start_record( std::ostream& ostr, binary_log::record_type type )
+{
+    set_stream( ostr );
+
+    m_record_type = type;
+    m_record.clear();
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::finish_record( std::ostream& ostr )
+{
+    append_record( m_record_type, m_record );
+
+    // everything produced by single formatter call is written at once
+    ostr.write( m_output.data(), static_cast<std::streamsize>( m_output.size() ) );
+    m_output.clear();
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::append_record( binary_log::record_type type, std::string const& payload )
+{
+    m_output += static_cast<char>( type );
+    append_number( m_output, payload.size() );
+    m_output.append( payload );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::put_number( uintmax_t value )
+{
+    append_number( m_record, value );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::put_unit_id( test_unit_id id )
+{
+    // the test case ids become small numbers
+    put_number( id ^ MIN_TEST_CASE_ID );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::put_string( const_string value, bool intern )
+{
+    if( !intern || value.size() > max_interned_size ) {
+        append_string( m_record, value );
+        return;
+    }
+
+    string_ids::const_iterator it = m_string_ids.find( value );
+    if( it != m_string_ids.end() ) {
+        put_number( static_cast<uintmax_t>( it->second ) << 1 );
+        return;
+    }
+
+    // only the strings seen before are defined, so that the unique values (like the context descriptions
+    // with the loop counter) do not bloat the log and the table; a hash collision just defines the string earlier
+    if( m_strings.size() == max_strings_num || !seen_before( value ) ) {
+        append_string( m_record, value );
+        return;
+    }
+
+    std::size_t id = m_strings.size();
+    m_strings.push_back( std::string( value.begin(), value.size() ) );
+    m_string_ids[m_strings.back()] = id;
+
+    // the definition goes ahead of the record being built
+    m_definition.clear();
+    append_number( m_definition, id );
+    append_string( m_definition, value );
+    append_record( binary_log::STRING, m_definition );
+
+    put_number( static_cast<uintmax_t>( id ) << 1 );
+}
+
+//____________________________________________________________________________//
+
+bool
+binary_log_formatter::seen_before( const_string value )
+{
+    // starting over just delays the definitions
+    if( m_seen_strings.size() == max_seen_num )
+        m_seen_strings.clear();
+
+    return !m_seen_strings.insert( string_hash()( value ) ).second;
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::define_unit( std::ostream& ostr, test_unit_id id )
+{
+    set_stream( ostr );
+
+    if( m_defined_units.count( id ) != 0 )
+        return;
+
+    test_unit const& tu = framework::get( id, TUT_ANY );
+
+    test_unit_id parent_id = tu.p_parent_id;
+    if( parent_id == framework::master_test_suite().p_id )
+        parent_id = INV_TEST_UNIT_ID;
+    else if( parent_id != INV_TEST_UNIT_ID )
+        define_unit( ostr, parent_id );
+
+    m_defined_units.insert( id );
+
+    start_record( ostr, binary_log::UNIT );
+    put_unit_id( id );
+    put_number( tu.p_type );
+    put_string( tu.p_type_name );
+    put_string( tu.p_name.get() );
+    put_string( tu.p_file_name );
+    put_number( tu.p_line_num );
+    put_unit_id( parent_id );
+    finish_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_start( std::ostream& ostr, counter_t test_cases_amount )
+{
+    // the log starts anew even if written into the same stream
+    m_stream = 0;
+
+    start_record( ostr, binary_log::LOG_START );
+    put_number( test_cases_amount );
+    finish_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_finish( std::ostream& ostr )
+{
+    start_record( ostr, binary_log::LOG_FINISH );
+    finish_record( ostr );
+
+    ostr.flush();
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_build_info( std::ostream& ostr )
+{
+    start_record( ostr, binary_log::BUILD_INFO );
+    put_string( BOOST_PLATFORM, false );
+    put_string( BOOST_COMPILER, false );
+    put_string( BOOST_STDLIB, false );
+    put_number( BOOST_VERSION );
+    finish_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::test_unit_start( std::ostream& ostr, test_unit const& tu )
+{
+    define_unit( ostr, tu.p_id );
+
+    start_record( ostr, binary_log::UNIT_START );
+    put_unit_id( tu.p_id );
+    finish_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::test_unit_finish( std::ostream& ostr, test_unit const& tu, elapsed_time const& elapsed )
+{
+    define_unit( ostr, tu.p_id );
+
+    start_record( ostr, binary_log::UNIT_FINISH );
+    put_unit_id( tu.p_id );
+    put_number( elapsed.wall );
+    put_number( elapsed.user );
+    put_number( elapsed.system );
+    finish_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::test_unit_finish( std::ostream& ostr, test_unit const& tu, unsigned long wall_time )
+{
+    elapsed_time elapsed;
+    elapsed.wall = static_cast<elapsed_time::nanoseconds>( wall_time ) * 1000;
+
+    test_unit_finish( ostr, tu, elapsed );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::test_unit_skipped( std::ostream& ostr, test_unit const& tu, const_string reason )
+{
+    define_unit( ostr, tu.p_id );
+
+    start_record( ostr, binary_log::UNIT_SKIPPED );
+    put_unit_id( tu.p_id );
+    put_string( reason );
+    finish_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_exception_start( std::ostream& ostr, log_checkpoint_data const& checkpoint_data, execution_exception const& ex )
+{
+    execution_exception::location const& loc = ex.where();
+
+    test_unit_id tc_id = current_test_case_id();
+    if( tc_id != INV_TEST_UNIT_ID )
+        define_unit( ostr, tc_id );
+
+    start_record( ostr, binary_log::EXCEPTION_START );
+    put_unit_id( tc_id );
+    put_string( loc.m_file_name );
+    put_number( loc.m_line_num );
+    put_string( loc.m_function );
+    put_number( ex.code() );
+    put_string( ex.what(), false );
+    put_string( checkpoint_data.m_file_name );
+    put_number( checkpoint_data.m_line_num );
+    put_string( checkpoint_data.m_message );
+    finish_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_exception_finish( std::ostream& ostr )
+{
+    start_record( ostr, binary_log::EXCEPTION_FINISH );
+    finish_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_entry_start( std::ostream& ostr, log_entry_data const& entry_data, log_entry_types let )
+{
+    test_unit_id tc_id = current_test_case_id();
+    if( tc_id != INV_TEST_UNIT_ID )
+        define_unit( ostr, tc_id );
+
+    start_record( ostr, binary_log::ENTRY_START );
+    put_unit_id( tc_id );
+    put_number( let );
+    put_string( entry_data.m_file_name );
+    put_number( entry_data.m_line_num );
+    put_number( entry_data.m_level );
+    finish_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_entry_value( std::ostream& ostr, const_string value )
+{
+    start_record( ostr, binary_log::ENTRY_VALUE );
+    put_string( value );
+    finish_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_entry_value( std::ostream& ostr, lazy_ostream const& value )
+{
+    // rendered the way it would be in the log stream
+    m_value_stream.flags( ostr.flags() );
+    m_value_stream.precision( ostr.precision() );
+    m_value_stream.fill( ostr.fill() );
+
+    m_value_buffer.m_value.clear();
+    m_value_stream << value;
+
+    log_entry_value( ostr, m_value_buffer.m_value );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_entry_finish( std::ostream& ostr )
+{
+    start_record( ostr, binary_log::ENTRY_FINISH );
+    finish_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::entry_context_start( std::ostream& ostr, log_level l )
+{
+    start_record( ostr, binary_log::CONTEXT_START );
+    put_number( l );
+    finish_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_entry_context( std::ostream& ostr, const_string context_descr )
+{
+    start_record( ostr, binary_log::CONTEXT_VALUE );
+    put_string( context_descr );
+    finish_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::entry_context_finish( std::ostream& ostr )
+{
+    start_record( ostr, binary_log::CONTEXT_FINISH );
+    finish_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_content( std::ostream& ostr, const_string content )
+{
+    set_stream( ostr );
+
+    // the content is a complete log written into another stream with the definitions of its own, which the reader
+    // drops at the end of this record
+    m_output += static_cast<char>( binary_log::CONTENT );
+    append_number( m_output, content.size() );
+
+    ostr.write( m_output.data(), static_cast<std::streamsize>( m_output.size() ) );
+    ostr.write( content.begin(), static_cast<std::streamsize>( content.size() ) );
+    m_output.clear();
+}
+
+// ************************************************************************** //
+// **************               binary_log_reader              ************** //
+// ************************************************************************** //
+
+namespace {
+
+// operands of each record type: 'n' - number, 'u' - test unit id, 's' - string
+char const* record_operands[binary_log::RECORD_TYPES_NUM] = {
+    "sn",           // HEADER
+    "ns",           // STRING
+    "n",            // LOG_START
+    "",             // LOG_FINISH
+    "sssn",         // BUILD_INFO
+    "unsssnu",      // UNIT
+    "u",            // UNIT_START
+    "unnn",         // UNIT_FINISH
+    "us",           // UNIT_SKIPPED
+    "usnsnssns",    // EXCEPTION_START
+    "",             // EXCEPTION_FINISH
+    "unsnn",        // ENTRY_START
+    "s",            // ENTRY_VALUE
+    "",             // ENTRY_FINISH
+    "n",            // CONTEXT_START
+    "s",            // CONTEXT_VALUE
+    "",             // CONTEXT_FINISH
+    ""              // CONTENT
+};
+
+// guards against the memory exhaustion on the malformed input
+const std::size_t max_string_id = 0x1000000;
+
+inline void
+check_log( bool condition, char const* msg )
+{
+    if( !condition )
+        BOOST_TEST_IMPL_THROW( std::runtime_error( std::string( "malformed binary log: " ) + msg ) );
+}
+
+} // local namespace
+
+//____________________________________________________________________________//
+
+binary_log_reader::binary_log_reader( const_string log )
+: m_log( log )
+, m_pos( log.begin() )
+{
+    check_log( m_log.is_empty() || static_cast<binary_log::record_type>( *m_pos ) == binary_log::HEADER, "no header" );
+}
+
+//____________________________________________________________________________//
+
+uintmax_t
+binary_log_reader::get_number( char const*& pos, char const* end )
+{
+    uintmax_t   res = 0;
+    unsigned    shift = 0;
+
+    while( true ) {
+        check_log( pos != end, "truncated number" );
+        check_log( shift < sizeof(uintmax_t) * 8, "number is too long" );
+
+        unsigned char c = static_cast<unsigned char>( *pos++ );
+
+        res |= static_cast<uintmax_t>( c & 0x7F ) << shift;
+        if( (c & 0x80) == 0 )
+            return res;
+
+        shift += 7;
+    }
+}
+
+//____________________________________________________________________________//
+
+const_string
+binary_log_reader::get_string( char const*& pos, char const* end )
+{
+    uintmax_t value = get_number( pos, end );
+
+    if( (value & 1) == 0 ) {
+        uintmax_t id = value >> 1;
+        check_log( id < m_strings.size(), "undefined string" );
+
+        return m_strings[static_cast<std::size_t>( id )];
+    }
+
+    uintmax_t size = value >> 1;
+    check_log( size <= static_cast<uintmax_t>( end - pos ), "truncated string" );
+
+    const_string res( pos, static_cast<std::size_t>( size ) );
+    pos += size;
+
+    return res;
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_reader::define_string( std::size_t id, const_string value )
+{
+    check_log( id < max_string_id, "invalid string id" );
+
+    // the value may refer to the table itself
+    std::string new_value( value.begin(), value.size() );
+
+    if( id >= m_strings.size() )
+        m_strings.resize( id + 1 );
+
+    // the definitions within CONTENT are undone at its end
+    if( !m_scopes.empty() )
+        m_undo.push_back( std::make_pair( id, m_strings[id] ) );
+
+    m_strings[id].swap( new_value );
+}
+
+//____________________________________________________________________________//
+
+bool
+binary_log_reader::next( record& r )
+{
+    while( true ) {
+        while( !m_scopes.empty() && m_pos == m_scopes.back().m_end ) {
+            while( m_undo.size() > m_scopes.back().m_undo_size ) {
+                m_strings[m_undo.back().first].swap( m_undo.back().second );
+                m_undo.pop_back();
+            }
+
+            m_scopes.pop_back();
+        }
+
+        if( m_pos == m_log.end() )
+            return false;
+
+        char const* end = m_scopes.empty() ? m_log.end() : m_scopes.back().m_end;
+
+        unsigned char type = static_cast<unsigned char>( *m_pos++ );
+        uintmax_t size = get_number( m_pos, end );
+        check_log( size <= static_cast<uintmax_t>( end - m_pos ), "truncated record" );
+
+        char const* record_end = m_pos + size;
+
+        // records of the types introduced later are skipped
+        if( type >= binary_log::RECORD_TYPES_NUM ) {
+            m_pos = record_end;
+            continue;
+        }
+
+        if( type == binary_log::CONTENT ) {
+            scope s = { record_end, m_undo.size() };
+            m_scopes.push_back( s );
+            continue;
+        }
+
+        r.m_type = static_cast<binary_log::record_type>( type );
+        r.m_numbers.clear();
+        r.m_strings.clear();
+
+        for( char const* op = record_operands[type]; *op != 0; ++op ) {
+            switch( *op ) {
+            case 'n':
+                r.m_numbers.push_back( get_number( m_pos, record_end ) );
+                break;
+            case 'u':
+                r.m_numbers.push_back( static_cast<test_unit_id>( get_number( m_pos, record_end ) ) ^ MIN_TEST_CASE_ID );
+                break;
+            case 's':
+                r.m_strings.push_back( get_string( m_pos, record_end ) );
+                break;
+            }
+        }
+
+        // operands appended by the later versions of the format are skipped
+        m_pos = record_end;
+
+        switch( r.m_type ) {
+        case binary_log::HEADER:
+            check_log( r.m_strings[0] == header_magic, "invalid header" );
+            check_log( r.m_numbers[0] <= binary_log::format_version, "unsupported format version" );
+            break;
+        case binary_log::STRING:
+            define_string( static_cast<std::size_t>( r.m_numbers[0] ), r.m_strings[0] );
+            break;
+        default:
+            return true;
+        }
+    }
+}
+
+//____________________________________________________________________________//
+
+} // namespace output
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_BINARY_LOG_FORMATTER_IPP_101615GER
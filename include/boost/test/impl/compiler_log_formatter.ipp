@@ -30,6 +30,7 @@
 
 // STL
 #include <iostream>
+#include <sstream>
 
 #include <boost/test/detail/suppress_warnings.hpp>
 
@@ -48,7 +49,25 @@ namespace {
 std::string
 test_phase_identifier()
 {
-    return framework::test_in_progress() ? framework::current_test_case().full_name() : std::string( "Test setup" );
+    return framework::test_in_progress() && framework::current_test_case_id() != INV_TEST_UNIT_ID
+            ? framework::current_test_case().full_name()
+            : std::string( "Test setup" );
+}
+
+//____________________________________________________________________________//
+
+std::string
+print_time( elapsed_time::nanoseconds value )
+{
+    elapsed_time::nanoseconds us = value / 1000;
+
+    std::ostringstream res;
+    if( us != 0 && us % 1000 == 0 )
+        res << us/1000 << "ms";
+    else
+        res << us << "us";
+
+    return res.str();
 }
 
 } // local namespace
@@ -81,7 +100,7 @@ compiler_log_formatter::log_build_info( std::ostream& output )
             << "STL     : " << BOOST_STDLIB              << '\n'
             << "Boost   : " << BOOST_VERSION/100000      << "."
                             << BOOST_VERSION/100 % 1000  << "."
-                            << BOOST_VERSION % 100       << std::endl;
+                            << BOOST_VERSION % 100       << '\n';
 }
 
 //____________________________________________________________________________//
@@ -93,29 +112,46 @@ compiler_log_formatter::test_unit_start( std::ostream& output, test_unit const&
 
     print_prefix( output, tu.p_file_name, tu.p_line_num );
 
-    output << "Entering test " << tu.p_type_name << " \"" << tu.p_name << "\"" << std::endl;
+    output << "Entering test " << tu.p_type_name << " \"" << tu.p_name << "\"\n";
 }
 
 //____________________________________________________________________________//
 
 void
-compiler_log_formatter::test_unit_finish( std::ostream& output, test_unit const& tu, unsigned long elapsed )
+compiler_log_formatter::test_unit_finish( std::ostream& output, test_unit const& tu, elapsed_time const& elapsed )
 {
+    // dispatch through the wall clock only interface, which formatters derived from this one may have customized
+    m_elapsed = elapsed;
+    test_unit_finish( output, tu, elapsed.microseconds() );
+    m_elapsed = elapsed_time();
+}
+
+//____________________________________________________________________________//
+
+void
+compiler_log_formatter::test_unit_finish( std::ostream& output, test_unit const& tu, unsigned long wall_time )
+{
+    // CPU times are only known if invoked through the interface above
+    elapsed_time elapsed = m_elapsed;
+    if( elapsed.microseconds() != wall_time ) {
+        elapsed = elapsed_time();
+        elapsed.wall = static_cast<elapsed_time::nanoseconds>( wall_time ) * 1000;
+    }
+
     BOOST_TEST_SCOPE_SETCOLOR( output, term_attr::BRIGHT, term_color::BLUE );
 
     print_prefix( output, tu.p_file_name, tu.p_line_num );
 
     output << "Leaving test " << tu.p_type_name << " \"" << tu.p_name << "\"";
 
-    if( elapsed > 0 ) {
-        output << "; testing time: ";
-        if( elapsed % 1000 == 0 )
-            output << elapsed/1000 << "ms";
-        else
-            output << elapsed << "us";
+    if( elapsed.microseconds() > 0 ) {
+        output << "; testing time: " << print_time( elapsed.wall );
+
+        if( elapsed.user != 0 || elapsed.system != 0 )
+            output << "; CPU time: " << print_time( elapsed.user ) << " user, " << print_time( elapsed.system ) << " system";
     }
 
-    output << std::endl;
+    output << '\n';
 }
 
 //____________________________________________________________________________//
@@ -127,7 +163,7 @@ compiler_log_formatter::test_unit_skipped( std::ostream& output, test_unit const
 
     print_prefix( output, tu.p_file_name, tu.p_line_num );
 
-    output  << "Test " << tu.p_type_name << " \"" << tu.full_name() << "\"" << " is skipped because " << reason << std::endl;
+    output  << "Test " << tu.p_type_name << " \"" << tu.full_name() << "\"" << " is skipped because " << reason << '\n';
 }
 
 //____________________________________________________________________________//
@@ -163,7 +199,7 @@ compiler_log_formatter::log_exception_start( std::ostream& output, log_checkpoin
 void
 compiler_log_formatter::log_exception_finish( std::ostream& output )
 {
-    output << std::endl;
+    output << '\n';
 }
 
 //____________________________________________________________________________//
@@ -227,7 +263,7 @@ compiler_log_formatter::log_entry_finish( std::ostream& output )
     if( runtime_config::color_output() )
         output << setcolor();
 
-    output << std::endl;
+    output << '\n';
 }
 
 
@@ -259,9 +295,8 @@ compiler_log_formatter::entry_context_start( std::ostream& output, log_level l )
 //____________________________________________________________________________//
 
 void
-compiler_log_formatter::entry_context_finish( std::ostream& output )
+compiler_log_formatter::entry_context_finish( std::ostream& )
 {
-    output.flush();
 }
 
 //____________________________________________________________________________//
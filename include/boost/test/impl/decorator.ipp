@@ -110,6 +110,18 @@ timeout::apply( test_unit& tu )
 
 //____________________________________________________________________________//
 
+// ************************************************************************** //
+// **************             decorator::timeout_ms            ************** //
+// ************************************************************************** //
+
+void
+timeout_ms::apply( test_unit& tu )
+{
+    tu.p_timeout_ms.value = m_timeout;
+}
+
+//____________________________________________________________________________//
+
 // ************************************************************************** //
 // **************            decorator::description            ************** //
 // ************************************************************************** //
@@ -193,6 +205,18 @@ precondition::apply( test_unit& tu )
 
 //____________________________________________________________________________//
 
+// ************************************************************************** //
+// **************             decorator::concurrent            ************** //
+// ************************************************************************** //
+
+void
+concurrent::apply( test_unit& tu )
+{
+    tu.p_concurrent.value = true;
+}
+
+//____________________________________________________________________________//
+
 } // namespace decorator
 } // namespace unit_test
 } // namespace boost
@@ -130,6 +130,7 @@ namespace { void _set_se_translator( void* ) {} }
 #  include <unistd.h>
 #  include <signal.h>
 #  include <setjmp.h>
+#  include <sys/time.h>
 
 #  if defined(__FreeBSD__)
 
@@ -206,6 +207,9 @@ void throw_exception( std::exception const & e ) { abort(); }
 
 namespace detail {
 
+// called before the process is terminated by a signal arriving outside of the monitored calls
+static void (*s_fatal_signal_hook)() = 0;
+
 #ifdef __BORLANDC__
 #  define BOOST_TEST_VSNPRINTF( a1, a2, a3, a4 ) std::vsnprintf( (a1), (a2), (a3), (a4) )
 #elif BOOST_WORKAROUND(_MSC_VER, <= 1310) || \
@@ -630,6 +634,9 @@ public:
     signal_action( int sig, bool install, bool attach_dbg, char* alt_stack );
     ~signal_action();
 
+    // reinstalls the action if it was replaced since it was installed
+    void                reassert();
+
 private:
     // Data members
     int                 m_sig;
@@ -685,37 +692,44 @@ signal_action::~signal_action()
 
 //____________________________________________________________________________//
 
+void
+signal_action::reassert()
+{
+    if( !m_installed )
+        return;
+
+    struct sigaction current;
+    if( ::sigaction( m_sig, sigaction_ptr(), &current ) == -1 )
+        return;
+
+    if( (current.sa_flags & SA_SIGINFO) && current.sa_sigaction == m_new_action.sa_sigaction )
+        return;
+
+    ::sigaction( m_sig, &m_new_action, sigaction_ptr() );
+}
+
+//____________________________________________________________________________//
+
 // ************************************************************************** //
-// **************        boost::detail::signal_handler         ************** //
+// **************        boost::detail::signal_session         ************** //
 // ************************************************************************** //
 
-class signal_handler {
+// Signal actions and alternative stack installed either for a single monitored call or, within a
+// monitoring session, once for all the calls
+class signal_session {
 public:
     // Constructor
-    explicit signal_handler( bool catch_system_errors, bool detect_fpe, unsigned timeout, bool attach_dbg, char* alt_stack );
+    signal_session( bool install, bool catch_system_errors, bool detect_fpe, bool catch_alarm, bool attach_dbg, char* alt_stack );
 
     // Destructor
-    ~signal_handler();
+    ~signal_session();
 
-    // access methods
-    static sigjmp_buf&      jump_buffer()
-    {
-        assert( !!s_active_handler );
-
-        return s_active_handler->m_sigjmp_buf;
-    }
-
-    static system_signal_exception&  sys_sig()
-    {
-        assert( !!s_active_handler );
-
-        return s_active_handler->m_sys_sig;
-    }
+    // reinstalls the signal actions replaced by the monitored function
+    void                    reassert();
 
 private:
     // Data members
-    signal_handler*         m_prev_handler;
-    unsigned                m_timeout;
+    bool                    m_alt_stack_enabled;
 
     // Note: We intentionality do not catch SIGCHLD. Users have to deal with it themselves
     signal_action           m_ILL_action;
@@ -726,41 +740,24 @@ private:
     signal_action           m_POLL_action;
     signal_action           m_ABRT_action;
     signal_action           m_ALRM_action;
-
-    sigjmp_buf              m_sigjmp_buf;
-    system_signal_exception m_sys_sig;
-
-    static signal_handler*  s_active_handler;
 };
 
-// !! need to be placed in thread specific storage
-typedef signal_handler* signal_handler_ptr;
-signal_handler* signal_handler::s_active_handler = signal_handler_ptr();
-
 //____________________________________________________________________________//
 
-signal_handler::signal_handler( bool catch_system_errors, bool detect_fpe, unsigned timeout, bool attach_dbg, char* alt_stack )
-: m_prev_handler( s_active_handler )
-, m_timeout( timeout )
-, m_ILL_action ( SIGILL , catch_system_errors, attach_dbg, alt_stack )
-, m_FPE_action ( SIGFPE , detect_fpe         , attach_dbg, alt_stack )
-, m_SEGV_action( SIGSEGV, catch_system_errors, attach_dbg, alt_stack )
-, m_BUS_action ( SIGBUS , catch_system_errors, attach_dbg, alt_stack )
+signal_session::signal_session( bool install, bool catch_system_errors, bool detect_fpe, bool catch_alarm, bool attach_dbg, char* alt_stack )
+: m_alt_stack_enabled( false )
+, m_ILL_action ( SIGILL , install && catch_system_errors, attach_dbg, alt_stack )
+, m_FPE_action ( SIGFPE , install && detect_fpe         , attach_dbg, alt_stack )
+, m_SEGV_action( SIGSEGV, install && catch_system_errors, attach_dbg, alt_stack )
+, m_BUS_action ( SIGBUS , install && catch_system_errors, attach_dbg, alt_stack )
 #ifdef BOOST_TEST_CATCH_SIGPOLL
-, m_POLL_action( SIGPOLL, catch_system_errors, attach_dbg, alt_stack )
+, m_POLL_action( SIGPOLL, install && catch_system_errors, attach_dbg, alt_stack )
 #endif
-, m_ABRT_action( SIGABRT, catch_system_errors, attach_dbg, alt_stack )
-, m_ALRM_action( SIGALRM, timeout > 0        , attach_dbg, alt_stack )
+, m_ABRT_action( SIGABRT, install && catch_system_errors, attach_dbg, alt_stack )
+, m_ALRM_action( SIGALRM, install && catch_alarm        , attach_dbg, alt_stack )
 {
-    s_active_handler = this;
-
-    if( m_timeout > 0 ) {
-        ::alarm( 0 );
-        ::alarm( timeout );
-    }
-
 #ifdef BOOST_TEST_USE_ALT_STACK
-    if( alt_stack ) {
+    if( install && alt_stack ) {
         stack_t sigstk;
         std::memset( &sigstk, 0, sizeof(stack_t) );
 
@@ -771,6 +768,8 @@ signal_handler::signal_handler( bool catch_system_errors, bool detect_fpe, unsig
             sigstk.ss_size  = BOOST_TEST_ALT_STACK_SIZE;
             sigstk.ss_flags = 0;
             BOOST_TEST_SYS_ASSERT( ::sigaltstack( &sigstk, 0 ) != -1 );
+
+            m_alt_stack_enabled = true;
         }
     }
 #endif
@@ -778,14 +777,13 @@ signal_handler::signal_handler( bool catch_system_errors, bool detect_fpe, unsig
 
 //____________________________________________________________________________//
 
-signal_handler::~signal_handler()
+signal_session::~signal_session()
 {
-    assert( s_active_handler == this );
-
-    if( m_timeout > 0 )
-        ::alarm( 0 );
-
 #ifdef BOOST_TEST_USE_ALT_STACK
+    // leave the alternative stack enabled by the enclosing session alone
+    if( !m_alt_stack_enabled )
+        return;
+
 #ifdef __GNUC__
     // We shouldn't need to explicitly initialize all the members here,
     // but gcc warns if we don't, so add initializers for each of the
@@ -804,6 +802,127 @@ signal_handler::~signal_handler()
                   << "\t" << std::strerror( error_n ) << std::endl;
     }
 #endif
+}
+
+//____________________________________________________________________________//
+
+void
+signal_session::reassert()
+{
+    m_ILL_action.reassert();
+    m_FPE_action.reassert();
+    m_SEGV_action.reassert();
+    m_BUS_action.reassert();
+#ifdef BOOST_TEST_CATCH_SIGPOLL
+    m_POLL_action.reassert();
+#endif
+    m_ABRT_action.reassert();
+    m_ALRM_action.reassert();
+}
+
+//____________________________________________________________________________//
+
+// the monitored function may install its own signal handlers or reset them to the default ones; the ones of the
+// session are reinstalled once it returns, so that they keep watching the following calls
+struct signal_session_keeper {
+    explicit signal_session_keeper( signal_session* signals ) : m_signals( signals ) {}
+    ~signal_session_keeper()
+    {
+        if( m_signals )
+            m_signals->reassert();
+    }
+
+    signal_session* m_signals;
+};
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************        boost::detail::signal_handler         ************** //
+// ************************************************************************** //
+
+class signal_handler {
+public:
+    // Constructor; within a monitoring session signal actions are already installed
+    explicit signal_handler( bool catch_system_errors, bool detect_fpe, unsigned timeout, bool attach_dbg, char* alt_stack, bool in_session );
+
+    // Destructor
+    ~signal_handler();
+
+    // access methods
+    static bool             active()
+    {
+        return !!s_active_handler;
+    }
+
+    static sigjmp_buf&      jump_buffer()
+    {
+        assert( !!s_active_handler );
+
+        return s_active_handler->m_sigjmp_buf;
+    }
+
+    static system_signal_exception&  sys_sig()
+    {
+        assert( !!s_active_handler );
+
+        return s_active_handler->m_sys_sig;
+    }
+
+private:
+    // Data members
+    signal_handler*         m_prev_handler;
+    unsigned                m_timeout; // in milliseconds
+
+    signal_session          m_signals;
+
+    sigjmp_buf              m_sigjmp_buf;
+    system_signal_exception m_sys_sig;
+
+    static signal_handler*  s_active_handler;
+};
+
+// !! need to be placed in thread specific storage
+typedef signal_handler* signal_handler_ptr;
+signal_handler* signal_handler::s_active_handler = signal_handler_ptr();
+
+//____________________________________________________________________________//
+
+// arms (or disarms, if timeout is 0) the one shot real time timer delivering SIGALRM; unlike alarm()
+// it is not limited to whole seconds
+static void
+set_alarm_timer( unsigned timeout_ms )
+{
+    itimerval timer;
+    std::memset( &timer, 0, sizeof(itimerval) );
+
+    timer.it_value.tv_sec   = timeout_ms / 1000;
+    timer.it_value.tv_usec  = (timeout_ms % 1000) * 1000;
+
+    BOOST_TEST_SYS_ASSERT( ::setitimer( ITIMER_REAL, &timer, 0 ) != -1 );
+}
+
+//____________________________________________________________________________//
+
+signal_handler::signal_handler( bool catch_system_errors, bool detect_fpe, unsigned timeout, bool attach_dbg, char* alt_stack, bool in_session )
+: m_prev_handler( s_active_handler )
+, m_timeout( timeout )
+, m_signals( !in_session, catch_system_errors, detect_fpe, timeout > 0, attach_dbg, alt_stack )
+{
+    s_active_handler = this;
+
+    if( m_timeout > 0 )
+        set_alarm_timer( m_timeout );
+}
+
+//____________________________________________________________________________//
+
+signal_handler::~signal_handler()
+{
+    assert( s_active_handler == this );
+
+    if( m_timeout > 0 )
+        set_alarm_timer( 0 );
 
     s_active_handler = m_prev_handler;
 }
@@ -818,6 +937,18 @@ extern "C" {
 
 static void boost_execution_monitor_jumping_signal_handler( int sig, siginfo_t* info, void* context )
 {
+    // within a monitoring session the signal actions stay installed between the monitored calls;
+    // outside of them the signal gets its default treatment once this handler returns
+    if( !signal_handler::active() ) {
+        BOOST_TEST_SYS_ASSERT( ::signal( sig, SIG_DFL ) != SIG_ERR );
+
+        if( s_fatal_signal_hook )
+            s_fatal_signal_hook();
+
+        ::raise( sig );
+        return;
+    }
+
     signal_handler::sys_sig()( info, context );
 
     siglongjmp( signal_handler::jump_buffer(), sig );
@@ -853,6 +984,12 @@ execution_monitor::catch_signals( boost::function<int ()> const& F )
     p_catch_system_errors.value = false;
 #endif
 
+    unsigned timeout_ms = p_timeout_ms != 0 ? p_timeout_ms.get() : detail::timeout_in_ms( p_timeout );
+
+    // nothing to intercept; leave process wide signal handling alone
+    if( !p_catch_system_errors && p_detect_fp_exceptions == fpe::BOOST_FPE_OFF && timeout_ms == 0 )
+        return detail::do_invoke( m_custom_translators , F );
+
 #ifdef BOOST_TEST_USE_ALT_STACK
     if( !!p_use_alt_stack && !m_alt_stack )
         m_alt_stack.reset( new char[BOOST_TEST_ALT_STACK_SIZE] );
@@ -860,11 +997,14 @@ execution_monitor::catch_signals( boost::function<int ()> const& F )
     p_use_alt_stack.value = false;
 #endif
 
+    signal_session_keeper session_keeper( m_sessions.empty() ? 0 : m_sessions.back().m_signals.get() );
+
     signal_handler local_signal_handler( p_catch_system_errors,
                                          p_catch_system_errors || (p_detect_fp_exceptions != fpe::BOOST_FPE_OFF),
-                                         p_timeout,
+                                         timeout_ms,
                                          p_auto_start_dbg,
-                                         !p_use_alt_stack ? 0 : m_alt_stack.get() );
+                                         !p_use_alt_stack ? 0 : m_alt_stack.get(),
+                                         !m_sessions.empty() );
 
     if( !sigsetjmp( signal_handler::jump_buffer(), 1 ) )
         return detail::do_invoke( m_custom_translators , F );
@@ -874,6 +1014,31 @@ execution_monitor::catch_signals( boost::function<int ()> const& F )
 
 //____________________________________________________________________________//
 
+void
+execution_monitor::start_signal_session()
+{
+#if defined(__CYGWIN__)
+    p_catch_system_errors.value = false;
+#endif
+
+#ifdef BOOST_TEST_USE_ALT_STACK
+    if( !!p_use_alt_stack && !m_alt_stack )
+        m_alt_stack.reset( new char[BOOST_TEST_ALT_STACK_SIZE] );
+#else
+    p_use_alt_stack.value = false;
+#endif
+
+    // the timeout is armed by each call, so SIGALRM is always intercepted
+    m_sessions.back().m_signals.reset( new detail::signal_session( true,
+                                                                   p_catch_system_errors,
+                                                                   p_catch_system_errors || (p_detect_fp_exceptions != fpe::BOOST_FPE_OFF),
+                                                                   true,
+                                                                   p_auto_start_dbg,
+                                                                   !p_use_alt_stack ? 0 : m_alt_stack.get() ) );
+}
+
+//____________________________________________________________________________//
+
 #elif defined(BOOST_SEH_BASED_SIGNAL_HANDLING)
 
 // ************************************************************************** //
@@ -1159,6 +1324,14 @@ execution_monitor::catch_signals( boost::function<int ()> const& F )
 
 //____________________________________________________________________________//
 
+void
+execution_monitor::start_signal_session()
+{
+    // structured exceptions handling is set up for each call anyway
+}
+
+//____________________________________________________________________________//
+
 #else  // default signal handler
 
 namespace detail {
@@ -1178,6 +1351,13 @@ execution_monitor::catch_signals( boost::function<int ()> const& F )
 
 //____________________________________________________________________________//
 
+void
+execution_monitor::start_signal_session()
+{
+}
+
+//____________________________________________________________________________//
+
 #endif  // choose signal handler
 
 // ************************************************************************** //
@@ -1188,16 +1368,68 @@ execution_monitor::execution_monitor()
 : p_catch_system_errors( true )
 , p_auto_start_dbg( false )
 , p_timeout( 0 )
+, p_timeout_ms( 0 )
 , p_use_alt_stack( true )
 , p_detect_fp_exceptions( fpe::BOOST_FPE_OFF )
 {}
 
 //____________________________________________________________________________//
 
+void
+execution_monitor::start_session()
+{
+    // looking for the debugger is expensive, so it is done once for the whole session
+    if( debug::under_debugger() )
+        p_catch_system_errors.value = false;
+
+    session s;
+    s.m_catch_system_errors     = p_catch_system_errors;
+    s.m_auto_start_dbg          = p_auto_start_dbg;
+    s.m_use_alt_stack           = p_use_alt_stack;
+    s.m_detect_fp_exceptions    = p_detect_fp_exceptions;
+
+    m_sessions.push_back( s );
+
+    start_signal_session();
+}
+
+//____________________________________________________________________________//
+
+void
+execution_monitor::set_fatal_signal_hook( void (*hook)() )
+{
+    detail::s_fatal_signal_hook = hook;
+}
+
+//____________________________________________________________________________//
+
+void
+execution_monitor::stop_session()
+{
+    if( m_sessions.empty() )
+        return;
+
+    m_sessions.pop_back();
+
+    if( m_sessions.empty() )
+        return;
+
+    // back to the configuration of the enclosing session
+    session const& s = m_sessions.back();
+
+    p_catch_system_errors.value     = s.m_catch_system_errors;
+    p_auto_start_dbg.value          = s.m_auto_start_dbg;
+    p_use_alt_stack.value           = s.m_use_alt_stack;
+    p_detect_fp_exceptions.value    = s.m_detect_fp_exceptions;
+}
+
+//____________________________________________________________________________//
+
 int
 execution_monitor::execute( boost::function<int ()> const& F )
 {
-    if( debug::under_debugger() )
+    // within a session it is done once by start_session
+    if( m_sessions.empty() && debug::under_debugger() )
         p_catch_system_errors.value = false;
 
     BOOST_TEST_IMPL_TRY {
@@ -26,12 +26,15 @@
 #include <boost/test/results_collector.hpp>
 #include <boost/test/progress_monitor.hpp>
 #include <boost/test/results_reporter.hpp>
+#include <boost/test/timer.hpp>
+#include <boost/test/timing_db.hpp>
 
 #include <boost/test/tree/observer.hpp>
 #include <boost/test/tree/test_unit.hpp>
 #include <boost/test/tree/visitor.hpp>
 #include <boost/test/tree/traverse.hpp>
 #include <boost/test/tree/test_case_counter.hpp>
+#include <boost/test/tree/static_registration.hpp>
 
 #if BOOST_TEST_SUPPORT_TOKEN_ITERATOR
 #include <boost/test/utils/iterator/token_iterator.hpp>
@@ -42,22 +45,56 @@
 
 #include <boost/test/detail/global_typedef.hpp>
 #include <boost/test/detail/throw_exception.hpp>
+#include <boost/test/detail/concurrency.hpp>
+#include <boost/test/detail/test_unit_id_table.hpp>
 
 // Boost
-#include <boost/timer.hpp>
 #include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
 
 // STL
 #include <limits>
+#include <algorithm>
 #include <map>
 #include <set>
+#include <deque>
+#include <list>
+#include <vector>
+#include <utility>
+#include <sstream>
+#include <fstream>
+#include <iostream>
 #include <cstdlib>
 #include <ctime>
 
+#ifdef BOOST_TEST_CONCURRENT_EXECUTION
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
+#include <functional>
+#endif
+
 #ifdef BOOST_NO_STDC_NAMESPACE
 namespace std { using ::time; using ::srand; }
 #endif
 
+#if defined(BOOST_HAS_UNISTD_H) && !defined(BOOST_TEST_DISABLE_WORKER_PROCESSES)
+
+#  define BOOST_TEST_HAS_WORKER_PROCESSES
+
+// SYSTEM API
+#  include <unistd.h>
+#  include <errno.h>
+#  include <signal.h>
+#  include <poll.h>
+#  include <sys/types.h>
+#  include <sys/wait.h>
+#  include <sys/time.h>
+
+#endif
+
 #include <boost/test/detail/suppress_warnings.hpp>
 
 //____________________________________________________________________________//
@@ -169,6 +206,9 @@ assign_sibling_rank( test_unit_id tu_id, order_info_per_tu& tuoi )
 static void
 invoke_init_func( init_unit_test_func init_func )
 {
+    // the statically registered test units are added before, just as the automatically registered ones are
+    ut_detail::static_test_units_registrar::register_test_units();
+
 #ifdef BOOST_TEST_ALTERNATIVE_INIT_API
     if( !(*init_func)() )
         BOOST_TEST_IMPL_THROW( std::runtime_error( "test module initialization failed" ) );
@@ -415,6 +455,270 @@ parse_filters( test_unit_id master_tu_id, test_unit_id_list& tu_to_enable, test_
     return had_selector_filter;
 }
 
+// ************************************************************************** //
+// **************                 shard filter                 ************** //
+// ************************************************************************** //
+
+class enabled_tc_collector : public test_tree_visitor {
+public:
+    explicit enabled_tc_collector( test_unit_id_list& targ_list )
+    : m_targ_list( targ_list )
+    {}
+
+private:
+    // test_tree_visitor interface
+    virtual void    visit( test_case const& tc ) { m_targ_list.push_back( tc.p_id ); }
+
+    // Data members
+    test_unit_id_list&  m_targ_list;
+};
+
+//____________________________________________________________________________//
+
+struct shard_group {
+    shard_group() : weight( 0 ), first_pos( 0 ) {}
+
+    double              weight;
+    std::size_t         first_pos;  // position of the first test case in the test tree order
+    test_unit_id_list   test_cases;
+};
+
+//____________________________________________________________________________//
+
+static std::size_t
+group_root( std::vector<std::size_t>& groups, std::size_t pos )
+{
+    while( groups[pos] != pos )
+        pos = groups[pos] = groups[groups[pos]];
+
+    return pos;
+}
+
+//____________________________________________________________________________//
+
+static bool
+heavier_group( shard_group const* lhs, shard_group const* rhs )
+{
+    return lhs->weight > rhs->weight || (lhs->weight == rhs->weight && lhs->first_pos < rhs->first_pos);
+}
+
+//____________________________________________________________________________//
+
+static void
+select_shard( test_unit_id master_tu_id )
+{
+    // 10. Parse shard specification
+    std::istringstream spec( runtime_config::shard() );
+    unsigned shard_index = 0, shard_count = 0;
+    char     separator = 0;
+
+    spec >> shard_index >> separator >> shard_count;
+
+    BOOST_TEST_SETUP_ASSERT( spec && spec.peek() == std::char_traits<char>::eof() && separator == '/' &&
+                             shard_index >= 1 && shard_index <= shard_count,
+                             "Invalid shard specification: " + runtime_config::shard() );
+
+    // 20. Collect enabled test cases in the test tree order
+    test_unit_id_list tcs;
+    enabled_tc_collector collector( tcs );
+    traverse_test_tree( master_tu_id, collector );
+
+    std::map<test_unit_id,std::size_t> tc_pos;
+    for( std::size_t pos = 0; pos < tcs.size(); ++pos )
+        tc_pos[tcs[pos]] = pos;
+
+    // 30. Merge test cases depending on each other into the same group, including dependencies of
+    // their parent suites; a suite dependency is a dependency of each test case in the suite
+    std::vector<std::size_t> groups( tcs.size() );
+    for( std::size_t pos = 0; pos < tcs.size(); ++pos )
+        groups[pos] = pos;
+
+    for( std::size_t pos = 0; pos < tcs.size(); ++pos ) {
+        for( test_unit_id tu_id = tcs[pos]; tu_id != master_tu_id && tu_id != INV_TEST_UNIT_ID; tu_id = get_tu_parent( tu_id ) ) {
+            BOOST_TEST_FOREACH( test_unit_id, dep_id, framework::get( tu_id, TUT_ANY ).p_dependencies.get() ) {
+                test_unit_id_list dep_tcs;
+                enabled_tc_collector dep_collector( dep_tcs );
+                traverse_test_tree( dep_id, dep_collector );
+
+                BOOST_TEST_FOREACH( test_unit_id, dep_tc_id, dep_tcs ) {
+                    std::map<test_unit_id,std::size_t>::const_iterator it = tc_pos.find( dep_tc_id );
+
+                    if( it != tc_pos.end() )
+                        groups[group_root( groups, it->second )] = group_root( groups, pos );
+                }
+            }
+        }
+    }
+
+    // 40. Estimate expected duration of each test case from the timing history given explicitly for the
+    // sharding; the history of timing_db is local to the machine and rewritten by each run, so it can't be
+    // relied upon to produce the same partitioning in all shards. Without the history for any of the test
+    // cases, all of them weight the same and the shards are balanced by the number of test cases
+    timing_db_t::records_t records;
+
+    BOOST_TEST_SETUP_ASSERT( runtime_config::balance_shards().empty() ||
+                             timing_db_t::read( runtime_config::balance_shards(), records ),
+                             "Can't read shard weights from " + runtime_config::balance_shards() );
+
+    std::vector<double> weights( tcs.size(), -1 );
+    double known_sum = 0;
+    std::size_t known_count = 0;
+
+    for( std::size_t pos = 0; pos < tcs.size(); ++pos ) {
+        timing_db_t::records_t::const_iterator tr = records.find( framework::get( tcs[pos], TUT_CASE ).full_name() );
+
+        if( tr != records.end() && !tr->second.m_durations.empty() ) {
+            weights[pos] = tr->second.m_mean;
+            known_sum += tr->second.m_mean;
+            ++known_count;
+        }
+    }
+
+    double default_weight = known_count > 0 ? known_sum / known_count : 1.;
+
+    // 50. Build the groups
+    std::map<std::size_t,shard_group> group_by_root;
+
+    for( std::size_t pos = 0; pos < tcs.size(); ++pos ) {
+        std::size_t root = group_root( groups, pos );
+        shard_group& group = group_by_root[root];
+
+        if( group.test_cases.empty() )
+            group.first_pos = pos;
+
+        group.test_cases.push_back( tcs[pos] );
+        group.weight += weights[pos] >= 0 ? weights[pos] : default_weight;
+    }
+
+    // 60. Assign heaviest groups first to the least loaded shard; ties are broken by the test tree order and
+    // the shard index, so the partitioning is the same for all shards
+    std::vector<shard_group const*> ordered_groups;
+    for( std::map<std::size_t,shard_group>::const_iterator it = group_by_root.begin(); it != group_by_root.end(); ++it )
+        ordered_groups.push_back( &it->second );
+
+    std::sort( ordered_groups.begin(), ordered_groups.end(), &heavier_group );
+
+    std::vector<double> shard_load( shard_count, 0 );
+
+    BOOST_TEST_FOREACH( shard_group const*, group, ordered_groups ) {
+        std::size_t target = static_cast<std::size_t>( std::min_element( shard_load.begin(), shard_load.end() ) - shard_load.begin() );
+
+        shard_load[target] += group->weight;
+
+        if( target == shard_index - 1 )
+            continue;
+
+        BOOST_TEST_FOREACH( test_unit_id, tc_id, group->test_cases )
+            framework::get( tc_id, TUT_CASE ).p_run_status.value = test_unit::RS_DISABLED;
+    }
+}
+
+// ************************************************************************** //
+// **************             failed test cases list           ************** //
+// ************************************************************************** //
+
+class full_name_filter : public test_tree_visitor {
+public:
+    full_name_filter( test_unit_id_list& targ_list, std::set<std::string> const& full_names )
+    : m_targ_list( targ_list )
+    , m_full_names( full_names )
+    {}
+
+private:
+    // test_tree_visitor interface
+    virtual void    visit( test_case const& tc )
+    {
+        if( tc.is_enabled() && m_full_names.count( tc.full_name() ) != 0 )
+            m_targ_list.push_back( tc.p_id );
+    }
+
+    // Data members
+    test_unit_id_list&              m_targ_list;
+    std::set<std::string> const&    m_full_names;
+};
+
+//____________________________________________________________________________//
+
+class failed_tc_writer : public test_tree_visitor {
+public:
+    failed_tc_writer( std::ostream& out, std::set<std::string> const& prev_failed )
+    : m_out( out )
+    , m_prev_failed( prev_failed )
+    {}
+
+private:
+    // test_tree_visitor interface
+    virtual void    visit( test_case const& tc )
+    {
+        test_results const& tr = results_collector.results( tc.p_id );
+
+        // aborted test cases are reported as failed as well; the ones not selected for this run keep their
+        // outcome of the previous one
+        if( tc.is_enabled() ? !tr.passed() && !tr.p_skipped : m_prev_failed.count( tc.full_name() ) != 0 )
+            m_out << tc.full_name() << '\n';
+    }
+
+    // Data members
+    std::ostream&                   m_out;
+    std::set<std::string> const&    m_prev_failed;
+};
+
+//____________________________________________________________________________//
+
+// Reads full names of the test cases listed in the file, one per line
+static std::set<std::string>
+read_test_case_names( std::string const& file_name )
+{
+    std::ifstream in( file_name.c_str() );
+
+    std::set<std::string> full_names;
+    std::string           line;
+
+    while( std::getline( in, line ) ) {
+        if( !line.empty() )
+            full_names.insert( line );
+    }
+
+    return full_names;
+}
+
+//____________________________________________________________________________//
+
+// Adds the enabled test cases listed in the file as failed during the previous run to the list of tu to enable.
+// Returns false if there are none, which is the case for the first run or after successful one
+static bool
+select_failed_test_cases( test_unit_id master_tu_id, std::string const& file_name, test_unit_id_list& tu_to_enable )
+{
+    std::set<std::string> const& full_names = read_test_case_names( file_name );
+
+    std::size_t prev_size = tu_to_enable.size();
+
+    full_name_filter fnf( tu_to_enable, full_names );
+    traverse_test_tree( master_tu_id, fnf, true );
+
+    return tu_to_enable.size() != prev_size;
+}
+
+//____________________________________________________________________________//
+
+// Writes full names of the test cases failed or aborted during the run, along with the ones failed during the
+// previous run which were not selected for this one, one per line
+static void
+save_failed_test_cases( test_unit_id master_tu_id, std::string const& file_name )
+{
+    std::set<std::string> const& prev_failed = read_test_case_names( file_name );
+
+    std::ofstream out( file_name.c_str(), std::ios::out | std::ios::trunc );
+
+    failed_tc_writer writer( out, prev_failed );
+    traverse_test_tree( master_tu_id, writer, true );
+
+    out.close();
+
+    if( out.fail() )
+        BOOST_TEST_LOG_ENTRY( log_warnings ) << "Failed to save the list of failed test cases into " << file_name;
+}
+
 //____________________________________________________________________________//
 
 } // namespace impl
@@ -428,11 +732,15 @@ unsigned const TIMEOUT_EXCEEDED = static_cast<unsigned>( -1 );
 class state {
 public:
     state()
-    : m_curr_test_case( INV_TEST_UNIT_ID )
-    , m_next_test_case_id( MIN_TEST_CASE_ID )
+    : m_next_test_case_id( MIN_TEST_CASE_ID )
     , m_next_test_suite_id( MIN_TEST_SUITE_ID )
     , m_test_in_progress( false )
-    , m_context_idx( 0 )
+    , m_jobs( 1 )
+    , m_isolate( false )
+    , m_preverified_tu( INV_TEST_UNIT_ID )
+    , m_max_failures( 0 )
+    , m_failed_test_cases( 0 )
+    , m_notify_passed_assertions( false )
     {
     }
 
@@ -440,20 +748,34 @@ public:
 
     void            clear()
     {
-        while( !m_test_units.empty() ) {
-            test_unit_store::value_type const& tu     = *m_test_units.begin();
-            test_unit const*                   tu_ptr = tu.second;
+        m_test_units.for_each( &state::delete_test_unit );
+    }
 
-            // the delete will erase this element from map
-            if( ut_detail::test_id_2_unit_type( tu.second->p_id ) == TUT_SUITE )
-                delete static_cast<test_suite const*>(tu_ptr);
-            else
-                delete static_cast<test_case const*>(tu_ptr);
-        }
+    // the delete resets the slot of the test unit
+    static void     delete_test_unit( test_unit_id id, test_unit* tu_ptr )
+    {
+        if( !tu_ptr )
+            return;
+
+        if( ut_detail::test_id_2_unit_type( id ) == TUT_SUITE )
+            delete static_cast<test_suite const*>(tu_ptr);
+        else
+            delete static_cast<test_case const*>(tu_ptr);
     }
 
     void            set_tu_id( test_unit& tu, test_unit_id id ) { tu.p_id.value = id; }
 
+    // passed assertions are only counted, unless some observer besides the framework's own ones may need them
+    void            observers_changed()
+    {
+        m_notify_passed_assertions = false;
+
+        BOOST_TEST_FOREACH( test_observer*, to, m_observers ) {
+            if( to != &results_collector && to != &unit_test_log && to != &progress_monitor && to != &timing_db )
+                m_notify_passed_assertions = true;
+        }
+    }
+
     //////////////////////////////////////////////////////////////////
 
     // Validates the dependency graph and deduces the sibling dependency rank for each child
@@ -489,244 +811,1388 @@ public:
     {
         test_unit& tu = framework::get( tu_id, TUT_ANY );
 
-        if( tu.p_default_status == test_suite::RS_INHERIT )
-            tu.p_default_status.value = parent_status;
+        if( tu.p_default_status == test_suite::RS_INHERIT )
+            tu.p_default_status.value = parent_status;
+
+        // go through list of children
+        if( tu.p_type == TUT_SUITE ) {
+            bool has_enabled_child = false;
+            BOOST_TEST_FOREACH( test_unit_id, chld_id, static_cast<test_suite const&>(tu).m_children )
+                has_enabled_child |= finalize_default_run_status( chld_id, tu.p_default_status );
+
+            tu.p_default_status.value = has_enabled_child ? test_suite::RS_ENABLED : test_suite::RS_DISABLED;
+        }
+
+        return tu.p_default_status == test_suite::RS_ENABLED;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Enables the test suites with any enabled test units; returns the number of enabled test cases in the test
+    // tree, which is also kept for the test suites
+    counter_t       finalize_run_status( test_unit_id tu_id )
+    {
+        test_unit& tu = framework::get( tu_id, TUT_ANY );
+
+        if( tu.p_type == TUT_CASE )
+            return tu.is_enabled() ? 1 : 0;
+
+        // go through list of children
+        counter_t enabled_test_cases = 0;
+        BOOST_TEST_FOREACH( test_unit_id, chld_id, static_cast<test_suite const&>(tu).m_children)
+            enabled_test_cases += finalize_run_status( chld_id );
+
+        tu.p_run_status.value = enabled_test_cases != 0 ? test_suite::RS_ENABLED : test_suite::RS_DISABLED;
+        m_enabled_test_cases[tu_id] = enabled_test_cases;
+
+        return enabled_test_cases;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Enables the test units in the list along with all their dependencies; the list is consumed
+    void            enable_test_units( test_unit_id_list& tu_to_enable )
+    {
+        using namespace framework::impl;
+
+        while( !tu_to_enable.empty() ) {
+            test_unit& tu = framework::get( tu_to_enable.back(), TUT_ANY );
+
+            tu_to_enable.pop_back();
+
+            // Ignore test units which already enabled
+            if( tu.is_enabled() )
+                continue;
+
+            // set new status and add all dependencies into tu_to_enable
+            set_run_status setter( test_unit::RS_ENABLED, &tu_to_enable );
+            traverse_test_tree( tu.p_id, setter, true );
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    void            deduce_run_status( test_unit_id master_tu_id )
+    {
+        using namespace framework::impl;
+        test_unit_id_list tu_to_enable;
+        test_unit_id_list tu_to_disable;
+
+        // 10. If there are any filters supplied, figure out lists of test units to enable/disable
+        bool had_selector_filter = !runtime_config::test_to_run().empty() &&
+                                   parse_filters( master_tu_id, tu_to_enable, tu_to_disable );
+
+        // 20. Set the stage: either use default run status or disable all test units
+        set_run_status setter( had_selector_filter ? test_unit::RS_DISABLED : test_unit::RS_INVALID );
+        traverse_test_tree( master_tu_id, setter, true );
+
+        // 30. Apply all selectors and enablers.
+        enable_test_units( tu_to_enable );
+
+        // 40. Apply all disablers
+        while( !tu_to_disable.empty() ) {
+            test_unit const& tu = framework::get( tu_to_disable.back(), TUT_ANY );
+
+            tu_to_disable.pop_back();
+
+            // 35. Ignore test units which already disabled
+            if( !tu.is_enabled() )
+                continue;
+
+            set_run_status setter( test_unit::RS_DISABLED );
+            traverse_test_tree( tu.p_id, setter, true );
+        }
+
+        // 45. Of the selected test cases, leave enabled only the ones failed during the previous run, along
+        // with their dependencies; if none of them failed, the selection is kept as is
+        if( !runtime_config::rerun_failed().empty() &&
+            select_failed_test_cases( master_tu_id, runtime_config::rerun_failed(), tu_to_enable ) ) {
+            set_run_status setter( test_unit::RS_DISABLED );
+            traverse_test_tree( master_tu_id, setter, true );
+
+            enable_test_units( tu_to_enable );
+        }
+
+        // 50. Make sure parents of enabled test units are also enabled
+        finalize_run_status( master_tu_id );
+
+        // 60. Leave enabled only the test cases assigned to the requested shard
+        if( !runtime_config::shard().empty() ) {
+            select_shard( master_tu_id );
+            finalize_run_status( master_tu_id );
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    typedef unit_test_monitor_t::error_level execution_result;
+
+      // Executed the test tree with the root at specified test unit
+    execution_result execute_test_tree( test_unit_id tu_id, unsigned timeout = 0 )
+    {
+        test_unit const& tu = framework::get( tu_id, TUT_ANY );
+
+        execution_result result = unit_test_monitor_t::test_ok;
+
+        if( !tu.is_enabled() )
+            return result;
+
+        {
+            ut_detail::scoped_lock L( ut_detail::framework_mutex() );
+
+            // 10. Check preconditions
+            result = check_preconditions( tu, timeout );
+            if( result != unit_test_monitor_t::test_ok )
+                return result;
+
+            // 20. Notify all observers about the start of the test unit
+            BOOST_TEST_FOREACH( test_observer*, to, m_observers )
+                to->test_unit_start( tu );
+        }
+
+        timeout = deduce_timeout( tu, timeout );
+
+        // workers forked before would not see the effects of the suite fixtures
+        if( tu.p_type == TUT_SUITE && !tu.p_fixtures.get().empty() )
+            shutdown_worker_pool();
+
+        // Resources used by the test unit are sampled around its fixtures; pool threads only account for their own
+        resource_meter tu_meter( ctx().m_monitor != 0 );
+
+        // 30. Execute setup fixtures if any; any failure here leads to test unit abortion
+        BOOST_TEST_FOREACH( test_unit_fixture_ptr, F, tu.p_fixtures.get() ) {
+            result = execute_monitored( boost::bind( &test_unit_fixture::setup, F ), 0 );
+            if( result != unit_test_monitor_t::test_ok )
+                break;
+        }
+
+        // This is the time we are going to spend executing the test unit
+        elapsed_time elapsed;
+
+        if( result == unit_test_monitor_t::test_ok ) {
+            // 40. We are going to time the execution
+            process_timer tu_timer;
+
+            if( tu.p_type == TUT_SUITE ) {
+                test_suite const& ts = static_cast<test_suite const&>( tu );
+
+                // Go through ranges of chldren with the same dependency rank. Children within
+                // the same range do not depend on each other, so they are shuffled independently
+                // (if requested) and may be executed in parallel
+                test_unit_id_list children_with_the_same_rank;
+
+                typedef test_suite::children_per_rank::const_iterator it_type;
+                it_type it = ts.m_ranked_children.begin();
+                while( it != ts.m_ranked_children.end() && !unit_test_monitor.is_critical_error( result ) ) {
+                    children_with_the_same_rank.clear();
+
+                    std::pair<it_type,it_type> range = ts.m_ranked_children.equal_range( it->first );
+                    it = range.first;
+                    while( it != range.second ) {
+                        children_with_the_same_rank.push_back( it->second );
+                        it++;
+                    }
+
+                    if( runtime_config::random_seed() != 0 )
+                        std::random_shuffle( children_with_the_same_rank.begin(), children_with_the_same_rank.end() );
+
+                    result = (std::min)( result, execute_siblings( children_with_the_same_rank, timeout, tu_timer ) );
+                }
+
+                elapsed = tu_timer.elapsed();
+            }
+            else { // TUT_CASE
+                test_case const& tc = static_cast<test_case const&>( tu );
+
+                execution_context& ec = ctx();
+
+                // setup contexts
+                ec.m_context_idx = 0;
+
+                // setup current test case
+                test_unit_id bkup = ec.m_curr_test_case;
+                ec.m_curr_test_case = tc.p_id;
+
+                // assertions of the enclosing test case (if any) are counted apart
+                counter_t passed_bkup   = ec.m_assertions_passed;
+                counter_t failed_bkup   = ec.m_assertions_failed;
+                counter_t warnings_bkup = ec.m_warnings_failed;
+                ec.m_assertions_passed = ec.m_assertions_failed = ec.m_warnings_failed = 0;
+
+                // execute the test case body
+                result = execute_monitored( tc.p_test_func, timeout );
+                elapsed = tu_timer.elapsed();
+
+                // cleanup leftover context
+                ec.m_context.clear();
+
+                // merge assertion results counted by this thread
+                {
+                    ut_detail::scoped_lock L( ut_detail::framework_mutex() );
+
+                    results_collector.add_assertion_results( tc.p_id, ec.m_assertions_passed, ec.m_assertions_failed, ec.m_warnings_failed );
+                }
+
+                // restore state and abort if necessary
+                ec.m_curr_test_case = bkup;
+                ec.m_assertions_passed  = passed_bkup;
+                ec.m_assertions_failed  = failed_bkup;
+                ec.m_warnings_failed    = warnings_bkup;
+            }
+        }
+
+        // and would outlive the teardown ones
+        if( tu.p_type == TUT_SUITE && !tu.p_fixtures.get().empty() )
+            shutdown_worker_pool();
+
+        // if run error is critical skip teardown, who knows what the state of the program at this point
+        if( !unit_test_monitor.is_critical_error( result ) ) {
+            // execute teardown fixtures if any in reverse order
+            BOOST_TEST_REVERSE_FOREACH( test_unit_fixture_ptr, F, tu.p_fixtures.get() ) {
+                result = (std::min)( result, execute_monitored( boost::bind( &test_unit_fixture::teardown, F ), 0 ) );
+
+                if( unit_test_monitor.is_critical_error( result ) )
+                    break;
+            }
+        }
+
+        resource_usage usage = tu_meter.usage();
+
+        ut_detail::scoped_lock L( ut_detail::framework_mutex() );
+
+        // notify all observers about abortion
+        if( unit_test_monitor.is_critical_error( result ) ) {
+            BOOST_TEST_FOREACH( test_observer*, to, m_observers )
+                to->test_aborted();
+        }
+
+        if( tu.p_type == TUT_CASE )
+            check_resource_budget( tu, usage );
+
+        // notify all observers about completion
+        BOOST_TEST_REVERSE_FOREACH( test_observer*, to, m_observers )
+            to->test_unit_finish( tu, elapsed, usage );
+
+        if( tu.p_type == TUT_CASE )
+            m_failed_test_cases += failed_test_cases( tu.p_id );
+
+        return result;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Fails the test case, which used more resources than the budget allows. Has to be called with
+    // the framework mutex locked
+    void    check_resource_budget( test_unit const& tu, resource_usage const& usage )
+    {
+        resource_usage const& budget = runtime_config::resource_budget();
+
+        std::ostringstream exceeded;
+
+        report_exceeded_limit( exceeded, "max_rss", usage.max_rss, budget.max_rss );
+        report_exceeded_limit( exceeded, "minor_faults", usage.minor_faults, budget.minor_faults );
+        report_exceeded_limit( exceeded, "major_faults", usage.major_faults, budget.major_faults );
+        report_exceeded_limit( exceeded, "voluntary_switches", usage.voluntary_switches, budget.voluntary_switches );
+        report_exceeded_limit( exceeded, "involuntary_switches", usage.involuntary_switches, budget.involuntary_switches );
+        report_exceeded_limit( exceeded, "block_inputs", usage.block_inputs, budget.block_inputs );
+        report_exceeded_limit( exceeded, "block_outputs", usage.block_outputs, budget.block_outputs );
+
+        if( exceeded.str().empty() )
+            return;
+
+        // the failure is reported on behalf of the test case
+        test_unit_id bkup = ctx().m_curr_test_case;
+        ctx().m_curr_test_case = tu.p_id;
+
+        unit_test_log << log::begin( tu.p_file_name, tu.p_line_num )
+                      << log_all_errors
+                      << "resource budget is exceeded:" << exceeded.str()
+                      << log::end();
+
+        BOOST_TEST_FOREACH( test_observer*, to, m_observers )
+            to->assertion_result( AR_FAILED );
+
+        ctx().m_curr_test_case = bkup;
+    }
+
+    static void report_exceeded_limit( std::ostream& ostr, char const* name, resource_usage::counter value, resource_usage::counter limit )
+    {
+        if( limit != 0 && value > limit )
+            ostr << ' ' << name << ' ' << value << " > " << limit;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Checks whether the test unit can be executed: there is time left for its execution, failures budget
+    // is not exhausted and all its dependencies were executed successfully. Otherwise notifies observers
+    // about the skipped test unit. Has to be called with the framework mutex locked
+    execution_result check_preconditions( test_unit const& tu, unsigned timeout )
+    {
+        // the main process verified these before passing the test unit to the worker; the results
+        // of the dependencies known to the worker may be stale
+        if( tu.p_id == m_preverified_tu )
+            return unit_test_monitor_t::test_ok;
+
+        if( timeout == TIMEOUT_EXCEEDED ) {
+            // notify all observers about skipped test unit
+            BOOST_TEST_FOREACH( test_observer*, to, m_observers )
+                to->test_unit_skipped( tu, "timeout for the test unit is exceeded" );
+
+            return unit_test_monitor_t::os_timeout;
+        }
+
+        // once the failures budget is exhausted the rest of the test units are not executed
+        if( failures_budget_exhausted() ) {
+            BOOST_TEST_FOREACH( test_observer*, to, m_observers )
+                to->test_unit_skipped( tu, "the maximum number of failed test cases is reached" );
+
+            return unit_test_monitor_t::precondition_failure;
+        }
+
+        test_tools::assertion_result const precondition_res = tu.check_preconditions();
+        if( !precondition_res ) {
+            // notify all observers about skipped test unit
+            BOOST_TEST_FOREACH( test_observer*, to, m_observers )
+                to->test_unit_skipped( tu, precondition_res.message() );
+
+            return unit_test_monitor_t::precondition_failure;
+        }
+
+        return unit_test_monitor_t::test_ok;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    bool        failures_budget_exhausted() const
+    {
+        return m_max_failures != 0 && m_failed_test_cases >= m_max_failures;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Number of failed test cases in the test tree which completed execution
+    counter_t   failed_test_cases( test_unit_id tu_id ) const
+    {
+        test_results const& tr = results_collector.results( tu_id );
+
+        if( ut_detail::test_id_2_unit_type( tu_id ) == TUT_SUITE )
+            return tr.p_test_cases_failed;
+
+        return tr.passed() || tr.p_skipped ? 0 : 1;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Executes the function using the execution monitor of the current thread
+    execution_result execute_monitored( boost::function<void ()> const& func, unsigned timeout )
+    {
+        if( ctx().m_monitor )
+            return unit_test_monitor_t::execute_and_translate( *ctx().m_monitor, func );
+
+        return unit_test_monitor.execute_and_translate_ms( func, timeout );
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Executes the siblings with the same dependency rank either one by one, in worker processes, in isolated
+    // pool workers or, for the consecutive test cases marked as concurrent, in the thread pool
+    execution_result execute_siblings( test_unit_id_list const& siblings, unsigned timeout, process_timer const& tu_timer )
+    {
+#ifdef BOOST_TEST_HAS_WORKER_PROCESSES
+        if( m_isolate )
+            return execute_isolated( siblings, timeout, tu_timer );
+
+        if( m_jobs > 1 ) {
+            unsigned num_enabled = 0;
+            BOOST_TEST_FOREACH( test_unit_id, chld, siblings )
+                num_enabled += framework::get( chld, TUT_ANY ).is_enabled() ? 1 : 0;
+
+            if( num_enabled > 1 )
+                return execute_in_workers( siblings, timeout, tu_timer );
+        }
+#endif
+
+        execution_result result = unit_test_monitor_t::test_ok;
+
+        test_unit_id_list::const_iterator it = siblings.begin();
+        test_unit_id_list batch;
+
+        while( it != siblings.end() && !unit_test_monitor.is_critical_error( result ) ) {
+            batch.clear();
+            test_unit_id_list::const_iterator batch_end = collect_concurrent_batch( it, siblings.end(), timeout, batch );
+
+            if( batch.size() > 1 ) {
+                result = (std::min)( result, execute_concurrently( batch ) );
+                it = batch_end;
+                continue;
+            }
+
+            unsigned chld_timeout = child_timeout( timeout, tu_timer.elapsed() );
+
+            result = (std::min)( result, execute_test_tree( *it++, chld_timeout ) );
+        }
+
+        return result;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Collects enabled test cases from the consecutive siblings which can be executed concurrently.
+    // Returns the end of the range these siblings occupy
+    test_unit_id_list::const_iterator
+    collect_concurrent_batch( test_unit_id_list::const_iterator it, test_unit_id_list::const_iterator end,
+                              unsigned timeout, test_unit_id_list& batch )
+    {
+#ifdef BOOST_TEST_CONCURRENT_EXECUTION
+        // there is no way to enforce time limits or to nest thread pools
+        if( timeout != 0 || ctx().m_monitor )
+            return it;
+
+        for( ; it != end; ++it ) {
+            test_unit const& tu = framework::get( *it, TUT_ANY );
+
+            if( !tu.is_enabled() )
+                continue;
+
+            if( tu.p_type != TUT_CASE || deduce_timeout( tu, 0 ) != 0 || !is_concurrent( tu ) )
+                break;
+
+            batch.push_back( tu.p_id );
+        }
+#else
+        ut_detail::ignore_unused_variable_warning( end );
+        ut_detail::ignore_unused_variable_warning( timeout );
+        ut_detail::ignore_unused_variable_warning( batch );
+#endif
+
+        return it;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Test unit is concurrent if it or any of its parents is marked as such
+    bool        is_concurrent( test_unit const& tu )
+    {
+        if( tu.p_concurrent )
+            return true;
+
+        return tu.p_parent_id != INV_TEST_UNIT_ID && is_concurrent( framework::get( tu.p_parent_id, TUT_SUITE ) );
+    }
+
+#ifdef BOOST_TEST_CONCURRENT_EXECUTION
+    //////////////////////////////////////////////////////////////////
+
+    // Test cases queue of a single pool thread. Owner takes test cases from the front, while
+    // the threads which ran out of work steal them from the back
+    struct task_queue {
+        std::mutex                  m_mutex;
+        std::deque<test_unit_id>    m_tasks;
+    };
+
+    struct thread_pool {
+        explicit thread_pool( std::size_t num_threads )
+        : m_queues( num_threads )
+        , m_results( num_threads, unit_test_monitor_t::test_ok )
+        , m_stop( false )
+        {}
+
+        bool        next_task( std::size_t thread_idx, test_unit_id& tu_id )
+        {
+            for( std::size_t i = 0; i < m_queues.size(); ++i ) {
+                task_queue& q = m_queues[(thread_idx + i) % m_queues.size()];
+
+                std::lock_guard<std::mutex> L( q.m_mutex );
+
+                if( q.m_tasks.empty() )
+                    continue;
+
+                if( i == 0 ) {
+                    tu_id = q.m_tasks.front();
+                    q.m_tasks.pop_front();
+                }
+                else {
+                    tu_id = q.m_tasks.back();
+                    q.m_tasks.pop_back();
+                }
+
+                return true;
+            }
+
+            return false;
+        }
+
+        std::vector<task_queue>         m_queues;
+        std::vector<execution_result>   m_results;
+        std::atomic<bool>               m_stop;
+        std::mutex                      m_exception_mutex;
+        std::exception_ptr              m_exception;
+    };
+
+    //////////////////////////////////////////////////////////////////
+
+    // Executes the test cases using up to one thread per hardware thread, but at least two, so that a test case
+    // waiting for something does not hold the rest of the batch. The calling thread takes part as well
+    execution_result execute_concurrently( test_unit_id_list const& batch )
+    {
+        std::size_t num_threads = (std::min)( batch.size(), static_cast<std::size_t>( (std::max)( std::thread::hardware_concurrency(), 2U ) ) );
+
+        thread_pool pool( num_threads );
+
+        for( std::size_t i = 0; i < batch.size(); ++i )
+            pool.m_queues[i % num_threads].m_tasks.push_back( batch[i] );
+
+        std::vector<std::thread> threads;
+        for( std::size_t i = 1; i < num_threads; ++i )
+            threads.push_back( std::thread( &state::run_pool_thread, this, std::ref( pool ), i ) );
+
+        run_pool_thread( pool, 0 );
+
+        BOOST_TEST_FOREACH( std::thread&, t, threads )
+            t.join();
+
+        if( pool.m_exception )
+            std::rethrow_exception( pool.m_exception );
+
+        execution_result result = unit_test_monitor_t::test_ok;
+        BOOST_TEST_FOREACH( execution_result, res, pool.m_results )
+            result = (std::min)( result, res );
+
+        return result;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    void        run_pool_thread( thread_pool& pool, std::size_t thread_idx )
+    {
+        // signals and alarms are process wide, so they can't be attributed to the test case in this thread
+        execution_monitor em;
+        em.p_catch_system_errors.value = false;
+        em.p_use_alt_stack.value = false;
+        em.share_exception_translators( unit_test_monitor );
+
+        execution_context thread_ctx;
+        thread_ctx.m_monitor = &em;
+
+        execution_context* prev_ctx = s_thread_ctx;
+        s_thread_ctx = &thread_ctx;
+
+        BOOST_TEST_IMPL_TRY {
+            test_unit_id tu_id;
+
+            while( !pool.m_stop && pool.next_task( thread_idx, tu_id ) ) {
+                execution_result res = execute_test_tree( tu_id );
+
+                pool.m_results[thread_idx] = (std::min)( pool.m_results[thread_idx], res );
+
+                if( unit_test_monitor.is_critical_error( res ) )
+                    pool.m_stop = true;
+            }
+        }
+        BOOST_TEST_IMPL_CATCHALL() {
+            std::lock_guard<std::mutex> L( pool.m_exception_mutex );
+
+            if( !pool.m_exception )
+                pool.m_exception = std::current_exception();
+
+            pool.m_stop = true;
+        }
+
+        s_thread_ctx = prev_ctx;
+    }
+#else
+    execution_result execute_concurrently( test_unit_id_list const& ) { return unit_test_monitor_t::test_ok; }
+#endif
+
+#ifdef BOOST_TEST_HAS_WORKER_PROCESSES
+    //////////////////////////////////////////////////////////////////
+
+    struct worker {
+        test_unit_id    tu_id;
+        pid_t           pid;
+        int             fd;
+    };
+
+    // Worker process executing test cases one by one, as they are passed through the task pipe
+    struct pool_worker {
+        pid_t           pid;
+        int             task_fd;
+        int             result_fd;
+        test_unit_id    tu_id;      // test case being executed; INV_TEST_UNIT_ID for an idle worker
+        unsigned        timeout;
+    };
+    typedef std::list<pool_worker> worker_pool;
+
+    // Records the test unit events in a worker process, so that they can be replayed in the main one
+    class worker_event_recorder : public test_observer {
+    public:
+        virtual void    test_unit_start( test_unit const& tu )
+        {
+            m_events << "S " << tu.p_id << '\n';
+        }
+        virtual void    test_unit_finish( test_unit const& tu, elapsed_time const& elapsed, resource_usage const& usage )
+        {
+            m_events << "F " << tu.p_id << ' ' << elapsed.wall << ' ' << elapsed.user << ' ' << elapsed.system
+                     << ' ' << usage.max_rss << ' ' << usage.minor_faults << ' ' << usage.major_faults
+                     << ' ' << usage.voluntary_switches << ' ' << usage.involuntary_switches
+                     << ' ' << usage.block_inputs << ' ' << usage.block_outputs << '\n';
+        }
+        virtual void    test_unit_skipped( test_unit const& tu, const_string reason )
+        {
+            m_events << "K " << tu.p_id << ' ' << reason.size() << ' ' << reason << '\n';
+        }
+        virtual void    test_unit_aborted( test_unit const& tu )
+        {
+            m_events << "A " << tu.p_id << '\n';
+        }
+
+        std::ostringstream  m_events;
+    };
+
+    // Collects the log written in a worker process into a buffer per log format, so that it is merged into
+    // the sink of the same format in the main one
+    class worker_log {
+    public:
+        worker_log()
+        {
+            std::vector<output_format> const& formats = unit_test_log.formats();
+
+            BOOST_TEST_FOREACH( output_format, of, formats ) {
+                m_buffers.push_back( std::make_pair( of, buffer_ptr( new std::ostringstream ) ) );
+                unit_test_log.set_stream( of, *m_buffers.back().second );
+            }
+        }
+
+        void            save( std::ostream& out ) const
+        {
+            // the log still kept in the sinks buffers belongs to the content as well
+            unit_test_log.flush();
+
+            out << m_buffers.size() << '\n';
+
+            for( std::size_t i = 0; i < m_buffers.size(); ++i ) {
+                std::string const& log_content = m_buffers[i].second->str();
+
+                out << static_cast<int>( m_buffers[i].first ) << ' ' << log_content.size() << '\n' << log_content;
+            }
+        }
+
+    private:
+        typedef boost::shared_ptr<std::ostringstream> buffer_ptr;
+
+        // Data members
+        std::vector<std::pair<output_format,buffer_ptr> > m_buffers;
+    };
+
+    // Reports all the enabled test units in a subtree as aborted
+    class worker_failure_reporter : public test_tree_visitor {
+    public:
+        worker_failure_reporter( state& s, const_string reason ) : m_state( s ), m_reason( reason ) {}
+
+    private:
+        // test_tree_visitor interface
+        virtual void    visit( test_case const& tc )
+        {
+            BOOST_TEST_FOREACH( test_observer*, to, m_state.m_observers )
+                to->test_unit_start( tc );
+
+            test_unit_id bkup = m_state.ctx().m_curr_test_case;
+            m_state.ctx().m_curr_test_case = tc.p_id;
+
+            execution_exception ex( execution_exception::system_error, m_reason, execution_exception::location() );
+
+            BOOST_TEST_FOREACH( test_observer*, to, m_state.m_observers )
+                to->exception_caught( ex );
+
+            m_state.ctx().m_curr_test_case = bkup;
+
+            BOOST_TEST_FOREACH( test_observer*, to, m_state.m_observers )
+                to->test_unit_aborted( tc );
+
+            BOOST_TEST_REVERSE_FOREACH( test_observer*, to, m_state.m_observers )
+                to->test_unit_finish( tc, elapsed_time(), resource_usage() );
+        }
+        virtual bool    test_suite_start( test_suite const& ts )
+        {
+            BOOST_TEST_FOREACH( test_observer*, to, m_state.m_observers )
+                to->test_unit_start( ts );
+
+            return true;
+        }
+        virtual void    test_suite_finish( test_suite const& ts )
+        {
+            BOOST_TEST_REVERSE_FOREACH( test_observer*, to, m_state.m_observers )
+                to->test_unit_finish( ts, elapsed_time(), resource_usage() );
+        }
+
+        // Data members
+        state&          m_state;
+        const_string    m_reason;
+    };
+
+    //////////////////////////////////////////////////////////////////
+
+    // Executes enabled siblings in up to m_jobs worker processes at a time. Workers output is
+    // merged in the order the siblings are listed, so the log looks the same as for serial run
+    execution_result execute_in_workers( test_unit_id_list const& siblings, unsigned timeout, process_timer const& tu_timer )
+    {
+        execution_result result = unit_test_monitor_t::test_ok;
+
+        std::deque<worker> running;
+        test_unit_id_list::const_iterator next = siblings.begin();
+
+        while( (next != siblings.end() && !unit_test_monitor.is_critical_error( result )) || !running.empty() ) {
+            if( next != siblings.end() && !unit_test_monitor.is_critical_error( result ) && running.size() < m_jobs ) {
+                test_unit_id chld = *next++;
+
+                if( !framework::get( chld, TUT_ANY ).is_enabled() )
+                    continue;
+
+                // once the failures budget is exhausted the rest of the siblings are skipped by this process
+                worker w = { chld, -1, -1 };
+                if( !failures_budget_exhausted() )
+                    w = start_worker( chld, child_timeout( timeout, tu_timer.elapsed() ) );
+
+                // failed to start the worker; execute in this process instead
+                if( w.pid == -1 ) {
+                    while( !running.empty() ) {
+                        result = (std::min)( result, collect_worker( running.front() ) );
+                        running.pop_front();
+                    }
+
+                    result = (std::min)( result, execute_test_tree( chld, child_timeout( timeout, tu_timer.elapsed() ) ) );
+                }
+                else
+                    running.push_back( w );
+
+                continue;
+            }
+
+            result = (std::min)( result, collect_worker( running.front() ) );
+            running.pop_front();
+        }
+
+        return result;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    worker start_worker( test_unit_id tu_id, unsigned timeout )
+    {
+        worker w = { tu_id, -1, -1 };
+
+        int fds[2];
+        if( ::pipe( fds ) != 0 )
+            return w;
+
+        // make sure buffered output is not duplicated by the worker
+        std::cout.flush();
+        std::cerr.flush();
+        std::clog.flush();
+        unit_test_log.flush();
+        runtime_config::log_sink()->flush();
+
+        w.pid = ::fork();
+
+        if( w.pid == -1 ) {
+            ::close( fds[0] );
+            ::close( fds[1] );
+            return w;
+        }
+
+        if( w.pid == 0 ) {
+            ::close( fds[0] );
+            run_worker( tu_id, timeout, fds[1] );
+        }
+
+        ::close( fds[1] );
+        w.fd = fds[0];
+
+        return w;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Executes the test tree in a worker process and writes the outcome into the pipe. Never returns
+    void        run_worker( test_unit_id tu_id, unsigned timeout, int fd )
+    {
+        worker_event_recorder recorder;
+        std::string         data;
+
+        BOOST_TEST_IMPL_TRY {
+            become_worker( recorder );
+
+            worker_log log_buffer;
+
+            execution_result result = execute_test_tree( tu_id, timeout );
+
+            data = worker_output( tu_id, result, recorder, log_buffer );
+        }
+        BOOST_TEST_IMPL_CATCHALL() {
+            ::_exit( 1 );
+        }
+
+        if( !write_all( fd, data ) )
+            ::_exit( 1 );
+
+        std::cout.flush();
+        std::cerr.flush();
+        std::clog.flush();
+
+        ::_exit( 0 );
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Only results and log are transferred back to the main process; the rest of the observers get recorded events
+    void        become_worker( worker_event_recorder& recorder )
+    {
+        m_jobs = 1;
+        m_isolate = false;
+
+        // m_max_failures and m_failed_test_cases are kept: the worker spends the rest of the failures budget
+
+        // the log is collected in memory and passed to the main process as a whole
+        unit_test_log.set_async( false );
+
+        m_observers.clear();
+        m_observers.insert( &results_collector );
+        m_observers.insert( &unit_test_log );
+        m_observers.insert( &recorder );
+        m_notify_passed_assertions = false;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    std::string worker_output( test_unit_id tu_id, execution_result result, worker_event_recorder const& recorder,
+                               worker_log const& log_buffer )
+    {
+        std::ostringstream out;
+
+        out << static_cast<int>( result ) << '\n' << recorder.m_events.str() << "E\n";
+        results_collector.save_results( tu_id, out );
+
+        log_buffer.save( out );
+
+        return out.str();
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    static bool write_all( int fd, std::string const& data )
+    {
+        std::size_t written = 0;
+        while( written < data.size() ) {
+            ssize_t res = ::write( fd, data.data() + written, data.size() - written );
+
+            if( res < 0 && errno == EINTR )
+                continue;
+            if( res <= 0 )
+                return false;
+
+            written += static_cast<std::size_t>( res );
+        }
+
+        return true;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    execution_result collect_worker( worker const& w )
+    {
+        std::string data;
+        char        buffer[4096];
+
+        while( true ) {
+            ssize_t res = ::read( w.fd, buffer, sizeof(buffer) );
+
+            if( res < 0 && errno == EINTR )
+                continue;
+            if( res <= 0 )
+                break;
+
+            data.append( buffer, static_cast<std::size_t>( res ) );
+        }
+        ::close( w.fd );
+
+        int status = 0;
+        while( ::waitpid( w.pid, &status, 0 ) == -1 && errno == EINTR )
+            ;
+
+        if( WIFEXITED( status ) && WEXITSTATUS( status ) == 0 ) {
+            execution_result result;
+
+            if( merge_worker_output( data, result ) ) {
+                m_failed_test_cases += failed_test_cases( w.tu_id );
+                return result;
+            }
+        }
+
+        // the failure is contained in the worker, so the rest of the test units can proceed
+        worker_failure_reporter wfr( *this, "worker process executing this test unit terminated abnormally" );
+        traverse_test_tree( w.tu_id, wfr );
+
+        m_failed_test_cases += failed_test_cases( w.tu_id );
+
+        return unit_test_monitor_t::os_exception;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    bool        merge_worker_output( std::string const& data, execution_result& result )
+    {
+        std::istringstream in( data );
+
+        int res_code;
+        if( !(in >> res_code) )
+            return false;
+
+        result = static_cast<execution_result>( res_code );
+
+        // 10. Validate and merge the results and the log
+        std::string events;
+        std::string line;
+        std::getline( in, line );
+        while( std::getline( in, line ) && line != "E" )
+            events += line + '\n';
+
+        if( !in || !results_collector.load_results( in ) )
+            return false;
+
+        std::size_t log_count = 0;
+        if( !(in >> log_count) )
+            return false;
+
+        while( log_count-- > 0 ) {
+            int         log_format = 0;
+            std::size_t log_size = 0;
+            if( !(in >> log_format >> log_size) || in.get() != '\n' )
+                return false;
+
+            std::string log_content( log_size, '\0' );
+            if( log_size != 0 && !in.read( &log_content[0], static_cast<std::streamsize>( log_size ) ) )
+                return false;
+
+            unit_test_log.append( static_cast<output_format>( log_format ), log_content );
+        }
+
+        // 20. Replay recorded events for the rest of the observers
+        std::istringstream event_stream( events );
+        char            type;
+        test_unit_id    id;
+
+        while( event_stream >> type >> id ) {
+            elapsed_time    elapsed;
+            resource_usage  usage;
+            std::string     reason;
+
+            if( type == 'F' )
+                event_stream >> elapsed.wall >> elapsed.user >> elapsed.system
+                             >> usage.max_rss >> usage.minor_faults >> usage.major_faults
+                             >> usage.voluntary_switches >> usage.involuntary_switches
+                             >> usage.block_inputs >> usage.block_outputs;
+            else if( type == 'K' ) {
+                std::size_t reason_size = 0;
+                event_stream >> reason_size;
+                event_stream.get();
+                reason.resize( reason_size );
+                if( reason_size != 0 )
+                    event_stream.read( &reason[0], static_cast<std::streamsize>( reason_size ) );
+            }
+
+            // test units created and run by the worker itself are unknown here
+            test_unit* const* tu_ptr = m_test_units.find( id );
+            if( !tu_ptr || !*tu_ptr )
+                continue;
+
+            test_unit const& tu = **tu_ptr;
+
+            BOOST_TEST_FOREACH( test_observer*, to, m_observers ) {
+                if( to == &results_collector || to == &unit_test_log )
+                    continue;
+
+                switch( type ) {
+                case 'S': to->test_unit_start( tu ); break;
+                case 'F': to->test_unit_finish( tu, elapsed, usage ); break;
+                case 'K': to->test_unit_skipped( tu, reason ); break;
+                case 'A': to->test_unit_aborted( tu ); break;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Executes each enabled test case in a worker process from the pool, so that a crash, a hang or a corrupted
+    // state only affect the test case itself. Up to m_jobs test cases are executed at a time. Test suites are
+    // executed by this process, so that their fixtures are set up once and the test cases inside are isolated
+    execution_result execute_isolated( test_unit_id_list const& siblings, unsigned timeout, process_timer const& tu_timer )
+    {
+        execution_result result = unit_test_monitor_t::test_ok;
+
+        std::deque<worker_pool::iterator> running;
+        test_unit_id_list::const_iterator next = siblings.begin();
+
+        while( (next != siblings.end() && !unit_test_monitor.is_critical_error( result )) || !running.empty() ) {
+            if( next != siblings.end() && !unit_test_monitor.is_critical_error( result ) && running.size() < m_jobs ) {
+                test_unit const& tu = framework::get( *next++, TUT_ANY );
+
+                if( !tu.is_enabled() )
+                    continue;
+
+                unsigned chld_timeout = child_timeout( timeout, tu_timer.elapsed() );
+
+                worker_pool::iterator w = m_worker_pool.end();
+
+                if( tu.p_type == TUT_CASE ) {
+                    {
+                        ut_detail::scoped_lock L( ut_detail::framework_mutex() );
+
+                        execution_result res = check_preconditions( tu, chld_timeout );
+                        if( res != unit_test_monitor_t::test_ok ) {
+                            result = (std::min)( result, res );
+                            continue;
+                        }
+                    }
+
+                    chld_timeout = deduce_timeout( tu, chld_timeout );
+
+                    w = dispatch_to_pool( tu.p_id, chld_timeout );
+                }
+
+                // test suites and test cases the pool failed to accept are executed in this process
+                if( w == m_worker_pool.end() ) {
+                    while( !running.empty() ) {
+                        result = (std::min)( result, collect_from_pool( running.front() ) );
+                        running.pop_front();
+                    }
+
+                    result = (std::min)( result, execute_test_tree( tu.p_id, chld_timeout ) );
+                }
+                else
+                    running.push_back( w );
+
+                continue;
+            }
+
+            result = (std::min)( result, collect_from_pool( running.front() ) );
+            running.pop_front();
+        }
+
+        return result;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Passes the test case to an idle pool worker, starting a new one if there is none
+    worker_pool::iterator dispatch_to_pool( test_unit_id tu_id, unsigned timeout )
+    {
+        worker_pool::iterator w = m_worker_pool.begin();
+        while( w != m_worker_pool.end() && w->tu_id != INV_TEST_UNIT_ID )
+            ++w;
+
+        if( w == m_worker_pool.end() )
+            w = start_pool_worker();
 
-        // go through list of children
-        if( tu.p_type == TUT_SUITE ) {
-            bool has_enabled_child = false;
-            BOOST_TEST_FOREACH( test_unit_id, chld_id, static_cast<test_suite const&>(tu).m_children )
-                has_enabled_child |= finalize_default_run_status( chld_id, tu.p_default_status );
+        if( w == m_worker_pool.end() )
+            return w;
 
-            tu.p_default_status.value = has_enabled_child ? test_suite::RS_ENABLED : test_suite::RS_DISABLED;
+        std::ostringstream task;
+        task << tu_id << ' ' << timeout << '\n';
+
+        if( !write_all( w->task_fd, task.str() ) ) {
+            retire_pool_worker( w, true );
+            return m_worker_pool.end();
         }
 
-        return tu.p_default_status == test_suite::RS_ENABLED;
+        w->tu_id    = tu_id;
+        w->timeout  = timeout;
+
+        return w;
     }
 
     //////////////////////////////////////////////////////////////////
 
-    bool            finalize_run_status( test_unit_id tu_id )
+    worker_pool::iterator start_pool_worker()
     {
-        test_unit& tu = framework::get( tu_id, TUT_ANY );
+        int task_fds[2];
+        if( ::pipe( task_fds ) != 0 )
+            return m_worker_pool.end();
+
+        int result_fds[2];
+        if( ::pipe( result_fds ) != 0 ) {
+            ::close( task_fds[0] );
+            ::close( task_fds[1] );
+            return m_worker_pool.end();
+        }
 
-        // go through list of children
-        if( tu.p_type == TUT_SUITE ) {
-            bool has_enabled_child = false;
-            BOOST_TEST_FOREACH( test_unit_id, chld_id, static_cast<test_suite const&>(tu).m_children)
-                has_enabled_child |= finalize_run_status( chld_id );
+        // make sure buffered output is not duplicated by the worker
+        std::cout.flush();
+        std::cerr.flush();
+        std::clog.flush();
+        unit_test_log.flush();
+        runtime_config::log_sink()->flush();
+
+        pid_t pid = ::fork();
+
+        if( pid == -1 ) {
+            ::close( task_fds[0] );
+            ::close( task_fds[1] );
+            ::close( result_fds[0] );
+            ::close( result_fds[1] );
+            return m_worker_pool.end();
+        }
 
-            tu.p_run_status.value = has_enabled_child ? test_suite::RS_ENABLED : test_suite::RS_DISABLED;
+        if( pid == 0 ) {
+            ::close( task_fds[1] );
+            ::close( result_fds[0] );
+            run_pool_worker( task_fds[0], result_fds[1] );
         }
 
-        return tu.is_enabled();
+        ::close( task_fds[0] );
+        ::close( result_fds[1] );
+
+        pool_worker w = { pid, task_fds[1], result_fds[0], INV_TEST_UNIT_ID, 0 };
+
+        return m_worker_pool.insert( m_worker_pool.end(), w );
     }
 
     //////////////////////////////////////////////////////////////////
 
-    void            deduce_run_status( test_unit_id master_tu_id )
+    // Executes the test cases passed by the main process one by one, until the task pipe is closed or the
+    // test case fails in a way which leaves the state of the process untrustworthy. Never returns
+    void        run_pool_worker( int task_fd, int result_fd )
     {
-        using namespace framework::impl;
-        test_unit_id_list tu_to_enable;
-        test_unit_id_list tu_to_disable;
+        // the pipes of the other workers are not ours; holding them would prevent these workers from stopping
+        BOOST_TEST_FOREACH( pool_worker const&, other, m_worker_pool ) {
+            ::close( other.task_fd );
+            ::close( other.result_fd );
+        }
+        m_worker_pool.clear();
 
-        // 10. If there are any filters supplied, figure out lists of test units to enable/disable
-        bool had_selector_filter = !runtime_config::test_to_run().empty() &&
-                                   parse_filters( master_tu_id, tu_to_enable, tu_to_disable );
+        worker_event_recorder recorder;
 
-        // 20. Set the stage: either use default run status or disable all test units
-        set_run_status setter( had_selector_filter ? test_unit::RS_DISABLED : test_unit::RS_INVALID );
-        traverse_test_tree( master_tu_id, setter, true );
+        BOOST_TEST_IMPL_TRY {
+            become_worker( recorder );
 
-        // 30. Apply all selectors and enablers.
-        while( !tu_to_enable.empty() ) {
-            test_unit& tu = framework::get( tu_to_enable.back(), TUT_ANY );
+            std::string task;
+            while( read_line( task_fd, task ) ) {
+                test_unit_id    tu_id;
+                unsigned        timeout;
 
-            tu_to_enable.pop_back();
+                std::istringstream in( task );
+                if( !(in >> tu_id >> timeout) )
+                    ::_exit( 1 );
 
-            // 35. Ignore test units which already enabled
-            if( tu.is_enabled() )
-                continue;
+                worker_log log_buffer;
+                recorder.m_events.str( std::string() );
 
-            // set new status and add all dependencies into tu_to_enable
-            set_run_status setter( test_unit::RS_ENABLED, &tu_to_enable );
-            traverse_test_tree( tu.p_id, setter, true );
-        }
+                m_preverified_tu = tu_id;
+                execution_result result = execute_test_tree( tu_id, timeout );
+                m_preverified_tu = INV_TEST_UNIT_ID;
 
-        // 40. Apply all disablers
-        while( !tu_to_disable.empty() ) {
-            test_unit const& tu = framework::get( tu_to_disable.back(), TUT_ANY );
+                std::string const& data = worker_output( tu_id, result, recorder, log_buffer );
 
-            tu_to_disable.pop_back();
+                std::ostringstream message;
+                message << data.size() << '\n' << data;
 
-            // 35. Ignore test units which already disabled
-            if( !tu.is_enabled() )
-                continue;
+                if( !write_all( result_fd, message.str() ) )
+                    ::_exit( 1 );
 
-            set_run_status setter( test_unit::RS_DISABLED );
-            traverse_test_tree( tu.p_id, setter, true );
+                if( result <= unit_test_monitor_t::os_exception )
+                    break;
+            }
+        }
+        BOOST_TEST_IMPL_CATCHALL() {
+            ::_exit( 1 );
         }
 
-        // 50. Make sure parents of enabled test units are also enabled
-        finalize_run_status( master_tu_id );
+        std::cout.flush();
+        std::cerr.flush();
+        std::clog.flush();
+
+        ::_exit( 0 );
     }
 
     //////////////////////////////////////////////////////////////////
 
-    typedef unit_test_monitor_t::error_level execution_result;
-
-      // Executed the test tree with the root at specified test unit
-    execution_result execute_test_tree( test_unit_id tu_id, unsigned timeout = 0 )
+    // Reads the task one byte at a time, so that nothing beyond the end of the line is consumed
+    static bool read_line( int fd, std::string& line )
     {
-        test_unit const& tu = framework::get( tu_id, TUT_ANY );
+        line.clear();
 
-        execution_result result = unit_test_monitor_t::test_ok;
-
-        if( !tu.is_enabled() )
-            return result;
+        char c;
+        while( true ) {
+            ssize_t res = ::read( fd, &c, 1 );
 
-        // 10. Check preconditions, including zero time left for execution and
-        // successful execution of all dependencies
-        if( timeout == TIMEOUT_EXCEEDED ) {
-            // notify all observers about skipped test unit
-            BOOST_TEST_FOREACH( test_observer*, to, m_observers )
-                to->test_unit_skipped( tu, "timeout for the test unit is exceeded" );
+            if( res < 0 && errno == EINTR )
+                continue;
+            if( res <= 0 )
+                return false;
+            if( c == '\n' )
+                return true;
 
-            return unit_test_monitor_t::os_timeout;
+            line += c;
         }
-        else if( timeout == 0 || timeout > tu.p_timeout ) // deduce timeout for this test unit
-            timeout = tu.p_timeout;
+    }
 
-        test_tools::assertion_result const precondition_res = tu.check_preconditions();
-        if( !precondition_res ) {
-            // notify all observers about skipped test unit
-            BOOST_TEST_FOREACH( test_observer*, to, m_observers )
-                to->test_unit_skipped( tu, precondition_res.message() );
+    //////////////////////////////////////////////////////////////////
 
-            return unit_test_monitor_t::precondition_failure;
-        }
+    execution_result collect_from_pool( worker_pool::iterator w )
+    {
+        test_unit_id tu_id = w->tu_id;
 
-        // 20. Notify all observers about the start of the test unit
-        BOOST_TEST_FOREACH( test_observer*, to, m_observers )
-            to->test_unit_start( tu );
+        std::string data;
+        bool        timed_out = false;
 
-        // 30. Execute setup fixtures if any; any failure here leads to test unit abortion
-        BOOST_TEST_FOREACH( test_unit_fixture_ptr, F, tu.p_fixtures.get() ) {
-            result = unit_test_monitor.execute_and_translate( boost::bind( &test_unit_fixture::setup, F ) );
-            if( result != unit_test_monitor_t::test_ok )
-                break;
-        }
+        if( read_pool_message( *w, data, timed_out ) ) {
+            execution_result result;
 
-        // This is the time we are going to spend executing the test unit
-        unsigned long elapsed = 0;
+            if( merge_worker_output( data, result ) ) {
+                m_failed_test_cases += failed_test_cases( tu_id );
 
-        if( result == unit_test_monitor_t::test_ok ) {
-            // 40. We are going to time the execution
-            boost::timer tu_timer;
+                // the worker stops after such failures, since its state can't be trusted anymore
+                if( result <= unit_test_monitor_t::os_exception )
+                    retire_pool_worker( w, false );
+                else
+                    w->tu_id = INV_TEST_UNIT_ID;
 
-            if( tu.p_type == TUT_SUITE ) {
-                test_suite const& ts = static_cast<test_suite const&>( tu );
+                // the failure is contained in the worker, so the rest of the test units can proceed
+                return (std::max)( result, unit_test_monitor_t::os_exception );
+            }
+        }
 
-                if( runtime_config::random_seed() == 0 ) {
-                    typedef std::pair<counter_t,test_unit_id> value_type;
+        retire_pool_worker( w, true );
 
-                    BOOST_TEST_FOREACH( value_type, chld, ts.m_ranked_children ) {
-                        unsigned chld_timeout = child_timeout( timeout, tu_timer.elapsed() );
+        worker_failure_reporter wfr( *this, timed_out
+            ? "worker process executing this test unit did not respond within the time limit and was terminated"
+            : "worker process executing this test unit terminated abnormally" );
+        traverse_test_tree( tu_id, wfr );
 
-                        result = (std::min)( result, execute_test_tree( chld.second, chld_timeout ) );
+        m_failed_test_cases += failed_test_cases( tu_id );
 
-                        if( unit_test_monitor.is_critical_error( result ) )
-                            break;
-                    }
-                }
-                else {
-                    // Go through ranges of chldren with the same dependency rank and shuffle them
-                    // independently. Execute each subtree in this order
-                    test_unit_id_list children_with_the_same_rank;
-
-                    typedef test_suite::children_per_rank::const_iterator it_type;
-                    it_type it = ts.m_ranked_children.begin();
-                    while( it != ts.m_ranked_children.end() ) {
-                        children_with_the_same_rank.clear();
-
-                        std::pair<it_type,it_type> range = ts.m_ranked_children.equal_range( it->first );
-                        it = range.first;
-                        while( it != range.second ) {
-                            children_with_the_same_rank.push_back( it->second );
-                            it++;
-                        }
+        return unit_test_monitor_t::os_exception;
+    }
 
-                        std::random_shuffle( children_with_the_same_rank.begin(), children_with_the_same_rank.end() );
+    //////////////////////////////////////////////////////////////////
 
-                        BOOST_TEST_FOREACH( test_unit_id, chld, children_with_the_same_rank ) {
-                            unsigned chld_timeout = child_timeout( timeout, tu_timer.elapsed() );
+    // Reads the length prefixed outcome of the test case. A worker is expected to report the timeout itself;
+    // the main process gives up on it only if the outcome does not arrive within a second after the time limit
+    // (in milliseconds, as all the time limits below)
+    bool        read_pool_message( pool_worker const& w, std::string& message, bool& timed_out )
+    {
+        boost::int64_t deadline = w.timeout == 0 ? 0 : current_time_ms() + w.timeout + 1000;
 
-                            result = (std::min)( result, execute_test_tree( chld, chld_timeout ) );
+        std::string data;
+        std::size_t message_size = 0;
+        bool        has_size = false;
 
-                            if( unit_test_monitor.is_critical_error( result ) )
-                                break;
-                        }
-                    }
-                }
+        while( !has_size || data.size() < message_size ) {
+            if( deadline != 0 ) {
+                boost::int64_t time_left = deadline - current_time_ms();
+
+                pollfd pfd = { w.result_fd, POLLIN, 0 };
+                int res = time_left > 0 ? ::poll( &pfd, 1, static_cast<int>( time_left ) ) : 0;
 
-                elapsed = static_cast<unsigned long>( tu_timer.elapsed() * 1e6 );
+                if( res < 0 && errno == EINTR )
+                    continue;
+                if( res <= 0 ) {
+                    timed_out = res == 0;
+                    return false;
+                }
             }
-            else { // TUT_CASE
-                test_case const& tc = static_cast<test_case const&>( tu );
 
-                // setup contexts
-                m_context_idx = 0;
+            char buffer[4096];
+            ssize_t res = ::read( w.result_fd, buffer, sizeof(buffer) );
 
-                // setup current test case
-                test_unit_id bkup = m_curr_test_case;
-                m_curr_test_case = tc.p_id;
+            if( res < 0 && errno == EINTR )
+                continue;
+            if( res <= 0 )
+                return false;
 
-                // execute the test case body
-                result = unit_test_monitor.execute_and_translate( tc.p_test_func, timeout );
-                elapsed = static_cast<unsigned long>( tu_timer.elapsed() * 1e6 );
+            data.append( buffer, static_cast<std::size_t>( res ) );
 
-                // cleanup leftover context
-                m_context.clear();
+            std::string::size_type eol;
+            if( !has_size && (eol = data.find( '\n' )) != std::string::npos ) {
+                std::istringstream in( data.substr( 0, eol ) );
+                if( !(in >> message_size) )
+                    return false;
 
-                // restore state and abort if necessary
-                m_curr_test_case = bkup;
+                data.erase( 0, eol + 1 );
+                has_size = true;
             }
         }
 
-        // if run error is critical skip teardown, who knows what the state of the program at this point
-        if( !unit_test_monitor.is_critical_error( result ) ) {
-            // execute teardown fixtures if any in reverse order
-            BOOST_TEST_REVERSE_FOREACH( test_unit_fixture_ptr, F, tu.p_fixtures.get() ) {
-                result = (std::min)( result, unit_test_monitor.execute_and_translate( boost::bind( &test_unit_fixture::teardown, F ), 0 ) );
+        message.swap( data );
 
-                if( unit_test_monitor.is_critical_error( result ) )
-                    break;
-            }
-        }
+        return true;
+    }
 
-        // notify all observers about abortion
-        if( unit_test_monitor.is_critical_error( result ) ) {
-            BOOST_TEST_FOREACH( test_observer*, to, m_observers )
-                to->test_aborted();
-        }
+    //////////////////////////////////////////////////////////////////
 
-        // notify all observers about completion
-        BOOST_TEST_REVERSE_FOREACH( test_observer*, to, m_observers )
-            to->test_unit_finish( tu, elapsed );
+    static boost::int64_t current_time_ms()
+    {
+        timeval tv;
+        ::gettimeofday( &tv, 0 );
 
-        return result;
+        return static_cast<boost::int64_t>( tv.tv_sec ) * 1000 + tv.tv_usec / 1000;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Closing the task pipe lets an idle worker exit on its own; a busy one has to be terminated
+    void        retire_pool_worker( worker_pool::iterator w, bool terminate )
+    {
+        if( terminate )
+            ::kill( w->pid, SIGKILL );
+
+        ::close( w->task_fd );
+        ::close( w->result_fd );
+
+        int status = 0;
+        while( ::waitpid( w->pid, &status, 0 ) == -1 && errno == EINTR )
+            ;
+
+        m_worker_pool.erase( w );
+    }
+#endif
+
+    //////////////////////////////////////////////////////////////////
+
+    // Workers started earlier do not see the changes made to the state of this process since then
+    void        shutdown_worker_pool()
+    {
+#ifdef BOOST_TEST_HAS_WORKER_PROCESSES
+        while( !m_worker_pool.empty() )
+            retire_pool_worker( m_worker_pool.begin(), false );
+#endif
     }
 
     //////////////////////////////////////////////////////////////////
 
-    unsigned child_timeout( unsigned tu_timeout, double elapsed )
+    // Time left for the children of the test unit in milliseconds
+    unsigned child_timeout( unsigned tu_timeout, elapsed_time const& elapsed )
     {
       if( tu_timeout == 0U )
           return 0U;
 
-      unsigned elpsed_sec = static_cast<unsigned>(elapsed); // rounding to number of whole seconds
+      elapsed_time::nanoseconds elapsed_ms = elapsed.wall / 1000000;
+
+      return tu_timeout > elapsed_ms ? tu_timeout - static_cast<unsigned>( elapsed_ms ) : TIMEOUT_EXCEEDED;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Time limit for the test unit in milliseconds: the least of its own one and the time left for its parent
+    static unsigned deduce_timeout( test_unit const& tu, unsigned parent_timeout )
+    {
+        unsigned tu_timeout = tu.p_timeout_ms != 0 ? tu.p_timeout_ms.get() : boost::detail::timeout_in_ms( tu.p_timeout );
+
+        // the largest value marks the exhausted time of the parent
+        tu_timeout = (std::min)( tu_timeout, TIMEOUT_EXCEEDED - 1 );
 
-      return tu_timeout > elpsed_sec ? tu_timeout - elpsed_sec : TIMEOUT_EXCEEDED;
+        return tu_timeout != 0 && (parent_timeout == 0 || parent_timeout > tu_timeout) ? tu_timeout : parent_timeout;
     }
 
     struct priority_order {
@@ -737,7 +2203,7 @@ public:
     };
 
     // Data members
-    typedef std::map<test_unit_id,test_unit*>       test_unit_store;
+    typedef ut_detail::test_unit_id_table<test_unit*> test_unit_store;
     typedef std::set<test_observer*,priority_order> observer_store;
     struct context_frame {
         context_frame( std::string const& d, int id, bool sticky )
@@ -745,18 +2211,61 @@ public:
         , frame_id( id )
         , is_sticky( sticky )
         {}
+        context_frame( boost::shared_ptr<lazy_ostream const> const& d, int id, bool sticky )
+        : lazy_descr( d )
+        , frame_id( id )
+        , is_sticky( sticky )
+        {}
+
+        // formats the lazy description on first access
+        std::string const& description() const
+        {
+            if( lazy_descr ) {
+                std::ostringstream buffer;
+                (*lazy_descr)( buffer );
+                descr = buffer.str();
+                lazy_descr.reset();
+            }
 
-        std::string descr;
-        int         frame_id;
-        bool        is_sticky;
+            return descr;
+        }
+
+        mutable std::string                             descr;
+        mutable boost::shared_ptr<lazy_ostream const>   lazy_descr;
+        int                                             frame_id;
+        bool                                            is_sticky;
     };
     typedef std::vector<context_frame> context_data;
 
+    // Execution state specific to a thread; test cases executed concurrently get their own
+    struct execution_context {
+        execution_context()
+        : m_curr_test_case( INV_TEST_UNIT_ID )
+        , m_context_idx( 0 )
+        , m_monitor( 0 )
+        , m_assertions_passed( 0 )
+        , m_assertions_failed( 0 )
+        , m_warnings_failed( 0 )
+        {}
+
+        test_unit_id        m_curr_test_case;
+        context_data        m_context;
+        int                 m_context_idx;
+
+        // set for pool threads only; these count all the assertions locally, other threads - passed ones
+        execution_monitor*  m_monitor;
+        counter_t           m_assertions_passed;
+        counter_t           m_assertions_failed;
+        counter_t           m_warnings_failed;
+    };
+
+    execution_context&  ctx() { return s_thread_ctx ? *s_thread_ctx : m_main_ctx; }
+
     master_test_suite_t* m_master_test_suite;
     std::vector<test_suite*> m_auto_test_suites;
 
-    test_unit_id    m_curr_test_case;
     test_unit_store m_test_units;
+    ut_detail::test_unit_id_table<counter_t> m_enabled_test_cases;
 
     test_unit_id    m_next_test_case_id;
     test_unit_id    m_next_test_suite_id;
@@ -764,12 +2273,28 @@ public:
     bool            m_test_in_progress;
 
     observer_store  m_observers;
-    context_data    m_context;
-    int             m_context_idx;
+
+    execution_context                           m_main_ctx;
+    static BOOST_TEST_THREAD_LOCAL execution_context* s_thread_ctx;
+
+    unsigned        m_jobs;
+
+    bool            m_isolate;
+    test_unit_id    m_preverified_tu;
+#ifdef BOOST_TEST_HAS_WORKER_PROCESSES
+    worker_pool     m_worker_pool;
+#endif
+
+    unsigned        m_max_failures;
+    counter_t       m_failed_test_cases;
+
+    bool            m_notify_passed_assertions;
 
     boost::execution_monitor m_aux_em;
 };
 
+BOOST_TEST_THREAD_LOCAL state::execution_context* state::s_thread_ctx = 0;
+
 //____________________________________________________________________________//
 
 namespace impl {
@@ -791,6 +2316,53 @@ setup_for_execution( test_unit const& tu )
  
 //____________________________________________________________________________//
 
+void
+set_current_test_case( test_unit_id tc_id )
+{
+#ifdef BOOST_TEST_CONCURRENT_EXECUTION
+    static BOOST_TEST_THREAD_LOCAL state::execution_context t_ctx;
+
+    // the main thread context belongs to the test cases executed by the main thread
+    state::s_thread_ctx = &t_ctx;
+    t_ctx.m_curr_test_case = tc_id;
+#endif
+}
+
+//____________________________________________________________________________//
+
+test_unit_id
+exchange_current_test_case( test_unit_id tc_id )
+{
+    test_unit_id prev = s_frk_state().ctx().m_curr_test_case;
+
+    s_frk_state().ctx().m_curr_test_case = tc_id;
+
+    return prev;
+}
+
+//____________________________________________________________________________//
+
+test_unit_id
+next_test_unit_id( test_unit_type t )
+{
+    return t == TUT_SUITE ? s_frk_state().m_next_test_suite_id : s_frk_state().m_next_test_case_id;
+}
+
+//____________________________________________________________________________//
+
+counter_t
+enabled_test_cases( test_unit_id tu_id )
+{
+    if( ut_detail::test_id_2_unit_type( tu_id ) == TUT_CASE )
+        return framework::get( tu_id, TUT_CASE ).is_enabled() ? 1 : 0;
+
+    counter_t const* count = s_frk_state().m_enabled_test_cases.find( tu_id );
+
+    return count ? *count : 0;
+}
+
+//____________________________________________________________________________//
+
 } // namespace impl
 
 //____________________________________________________________________________//
@@ -805,9 +2377,20 @@ init( init_unit_test_func init_func, int argc, char* argv[] )
     // 10. Set up runtime parameters
     runtime_config::init( argc, argv );
 
-    // 20. Set the desired log level and format
-    unit_test_log.set_threshold_level( runtime_config::log_level() );
-    unit_test_log.set_format( runtime_config::log_format() );
+    // 20. Set the desired log sinks, each with its own level and format
+    std::list<runtime_config::logger_spec> const& loggers = runtime_config::loggers();
+
+    unit_test_log.set_format( loggers.front().m_format );
+
+    BOOST_TEST_FOREACH( runtime_config::logger_spec const&, ls, loggers ) {
+        unit_test_log.add_format( ls.m_format );
+        unit_test_log.set_stream( ls.m_format, *ls.m_sink );
+        unit_test_log.set_threshold_level( ls.m_format, ls.m_level );
+    }
+
+    unit_test_log.set_async( runtime_config::async_log() );
+    unit_test_log.set_flush_policy( runtime_config::log_flush(), runtime_config::log_flush_bytes() );
+    unit_test_log.set_flight_recorder( runtime_config::flight_recorder() * std::size_t( 1024 ) );
 
     // 30. Set the desired report level and format
     results_reporter::set_level( runtime_config::report_level() );
@@ -820,6 +2403,12 @@ init( init_unit_test_func init_func, int argc, char* argv[] )
     if( runtime_config::show_progress() )
         register_observer( progress_monitor );
 
+    if( !runtime_config::timing_db().empty() ) {
+        // unreadable history is started anew and overwritten at the end of the run
+        timing_db.load( runtime_config::timing_db() );
+        register_observer( timing_db );
+    }
+
     // 50. Set up memory leak detection
     if( runtime_config::detect_memory_leaks() > 0 ) {
         debug::detect_memory_leaks( true, runtime_config::memory_leaks_report_file() );
@@ -926,9 +2515,7 @@ register_test_unit( test_case* tc )
 
     BOOST_TEST_SETUP_ASSERT( new_id != MAX_TEST_CASE_ID, BOOST_TEST_L( "too many test cases" ) );
 
-    typedef state::test_unit_store::value_type map_value_type;
-
-    impl::s_frk_state().m_test_units.insert( map_value_type( new_id, tc ) );
+    impl::s_frk_state().m_test_units[new_id] = tc;
     impl::s_frk_state().m_next_test_case_id++;
 
     impl::s_frk_state().set_tu_id( *tc, new_id );
@@ -949,9 +2536,7 @@ register_test_unit( test_suite* ts )
 
     BOOST_TEST_SETUP_ASSERT( new_id != MAX_TEST_SUITE_ID, BOOST_TEST_L( "too many test suites" ) );
 
-    typedef state::test_unit_store::value_type map_value_type;
-
-    impl::s_frk_state().m_test_units.insert( map_value_type( new_id, ts ) );
+    impl::s_frk_state().m_test_units[new_id] = ts;
     impl::s_frk_state().m_next_test_suite_id++;
 
     impl::s_frk_state().set_tu_id( *ts, new_id );
@@ -966,7 +2551,10 @@ register_test_unit( test_suite* ts )
 void
 deregister_test_unit( test_unit* tu )
 {
-    impl::s_frk_state().m_test_units.erase( tu->p_id );
+    test_unit** tu_ptr = impl::s_frk_state().m_test_units.find( tu->p_id );
+
+    if( tu_ptr )
+        *tu_ptr = 0;
 }
 
 //____________________________________________________________________________//
@@ -991,6 +2579,7 @@ void
 register_observer( test_observer& to )
 {
     impl::s_frk_state().m_observers.insert( &to );
+    impl::s_frk_state().observers_changed();
 }
 
 //____________________________________________________________________________//
@@ -1003,6 +2592,7 @@ void
 deregister_observer( test_observer& to )
 {
     impl::s_frk_state().m_observers.erase( &to );
+    impl::s_frk_state().observers_changed();
 }
 
 //____________________________________________________________________________//
@@ -1016,9 +2606,23 @@ add_context( ::boost::unit_test::lazy_ostream const& context_descr, bool sticky
 {
     std::stringstream buffer;
     context_descr( buffer );
-    int res_idx  = impl::s_frk_state().m_context_idx++;
+    state::execution_context& ec = impl::s_frk_state().ctx();
+    int res_idx  = ec.m_context_idx++;
+
+    ec.m_context.push_back( state::context_frame( buffer.str(), res_idx, sticky ) );
+
+    return res_idx;
+}
+
+//____________________________________________________________________________//
+
+int
+add_context( boost::shared_ptr<lazy_ostream const> const& context_descr, bool sticky )
+{
+    state::execution_context& ec = impl::s_frk_state().ctx();
+    int res_idx  = ec.m_context_idx++;
 
-    impl::s_frk_state().m_context.push_back( state::context_frame( buffer.str(), res_idx, sticky ) );
+    ec.m_context.push_back( state::context_frame( context_descr, res_idx, sticky ) );
 
     return res_idx;
 }
@@ -1044,18 +2648,20 @@ struct frame_with_id {
 void
 clear_context( int frame_id )
 {
+    state::context_data& context = impl::s_frk_state().ctx().m_context;
+
     if( frame_id == -1 ) {   // clear all non sticky frames
-        for( int i=static_cast<int>(impl::s_frk_state().m_context.size())-1; i>=0; i-- )
-            if( !impl::s_frk_state().m_context[i].is_sticky )
-                impl::s_frk_state().m_context.erase( impl::s_frk_state().m_context.begin()+i );
+        for( int i=static_cast<int>(context.size())-1; i>=0; i-- )
+            if( !context[i].is_sticky )
+                context.erase( context.begin()+i );
     }
 
     else { // clear specific frame
         state::context_data::iterator it =
-            std::find_if( impl::s_frk_state().m_context.begin(), impl::s_frk_state().m_context.end(), frame_with_id( frame_id ) );
+            std::find_if( context.begin(), context.end(), frame_with_id( frame_id ) );
 
-        if( it != impl::s_frk_state().m_context.end() ) // really an internal error if this is not true
-            impl::s_frk_state().m_context.erase( it );
+        if( it != context.end() ) // really an internal error if this is not true
+            context.erase( it );
     }
 }
 
@@ -1080,7 +2686,7 @@ get_context()
 bool
 context_generator::is_empty() const
 {
-    return impl::s_frk_state().m_context.empty();
+    return impl::s_frk_state().ctx().m_context.empty();
 }
 
 //____________________________________________________________________________//
@@ -1088,7 +2694,9 @@ context_generator::is_empty() const
 const_string
 context_generator::next() const
 {
-    return m_curr_frame < impl::s_frk_state().m_context.size() ? impl::s_frk_state().m_context[m_curr_frame++].descr : const_string();
+    state::context_data const& context = impl::s_frk_state().ctx().m_context;
+
+    return m_curr_frame < context.size() ? context[m_curr_frame++].description() : const_string();
 }
 
 //____________________________________________________________________________//
@@ -1135,7 +2743,7 @@ current_auto_test_suite( test_suite* ts, bool push_or_pop )
 test_case const&
 current_test_case()
 {
-    return get<test_case>( impl::s_frk_state().m_curr_test_case );
+    return get<test_case>( impl::s_frk_state().ctx().m_curr_test_case );
 }
 
 //____________________________________________________________________________//
@@ -1143,7 +2751,7 @@ current_test_case()
 test_unit_id
 current_test_case_id()
 {
-    return impl::s_frk_state().m_curr_test_case;
+    return impl::s_frk_state().ctx().m_curr_test_case;
 }
 
 //____________________________________________________________________________//
@@ -1155,7 +2763,12 @@ current_test_case_id()
 test_unit&
 get( test_unit_id id, test_unit_type t )
 {
-    test_unit* res = impl::s_frk_state().m_test_units[id];
+    test_unit* const* res_ptr = impl::s_frk_state().m_test_units.find( id );
+
+    if( !res_ptr || !*res_ptr )
+        BOOST_TEST_IMPL_THROW( internal_error( "Invalid test unit id" ) );
+
+    test_unit* res = *res_ptr;
 
     if( (res->p_type & t) == 0 )
         BOOST_TEST_IMPL_THROW( internal_error( "Invalid test unit type" ) );
@@ -1181,14 +2794,23 @@ run( test_unit_id id, bool continue_test )
     test_case_counter tcc;
     traverse_test_tree( id, tcc );
 
-    BOOST_TEST_SETUP_ASSERT( tcc.p_count != 0 , runtime_config::test_to_run().empty()
+    // with more shards than independent test cases some of them are left empty, which is not an error
+    BOOST_TEST_SETUP_ASSERT( tcc.p_count != 0 || !runtime_config::shard().empty(), runtime_config::test_to_run().empty()
         ? BOOST_TEST_L( "test tree is empty" )
         : BOOST_TEST_L( "no test cases matching filter or all test cases were disabled" ) );
 
-    bool    was_in_progress     = framework::test_in_progress();
-    bool    call_start_finish   = !continue_test || !was_in_progress;
+    bool        was_in_progress     = framework::test_in_progress();
+    bool        call_start_finish   = !continue_test || !was_in_progress;
+    unsigned    prev_jobs           = impl::s_frk_state().m_jobs;
+    bool        prev_isolate        = impl::s_frk_state().m_isolate;
+    unsigned    prev_max_failures   = impl::s_frk_state().m_max_failures;
+    counter_t   prev_failed         = impl::s_frk_state().m_failed_test_cases;
 
     impl::s_frk_state().m_test_in_progress = true;
+    impl::s_frk_state().m_jobs = (std::max)( runtime_config::jobs(), 1U );
+    impl::s_frk_state().m_isolate = runtime_config::isolate();
+    impl::s_frk_state().m_max_failures = runtime_config::max_failures();
+    impl::s_frk_state().m_failed_test_cases = 0;
 
     if( call_start_finish ) {
         BOOST_TEST_FOREACH( test_observer*, to, impl::s_frk_state().m_observers ) {
@@ -1215,7 +2837,20 @@ run( test_unit_id id, bool continue_test )
         std::srand( runtime_config::random_seed() );
     }
 
+    // signal handlers are installed once for the whole run rather than for every test unit
+    unit_test_monitor.start_session();
+
     impl::s_frk_state().execute_test_tree( id );
+    impl::s_frk_state().shutdown_worker_pool();
+
+    unit_test_monitor.stop_session();
+
+    // the log of the executed test units is written out even if the run is nested within another one
+    unit_test_log.flush();
+
+    // only the outermost run over the whole test tree knows all the failures; the nested ones would lose them
+    if( !runtime_config::rerun_failed().empty() && call_start_finish && id == master_test_suite().p_id )
+        impl::save_failed_test_cases( id, runtime_config::rerun_failed() );
 
     if( call_start_finish ) {
         BOOST_TEST_REVERSE_FOREACH( test_observer*, to, impl::s_frk_state().m_observers )
@@ -1223,6 +2858,10 @@ run( test_unit_id id, bool continue_test )
     }
 
     impl::s_frk_state().m_test_in_progress = was_in_progress;
+    impl::s_frk_state().m_jobs = prev_jobs;
+    impl::s_frk_state().m_isolate = prev_isolate;
+    impl::s_frk_state().m_max_failures = prev_max_failures;
+    impl::s_frk_state().m_failed_test_cases = prev_failed;
 }
 
 //____________________________________________________________________________//
@@ -1242,8 +2881,29 @@ run( test_unit const* tu, bool continue_test )
 void
 assertion_result( unit_test::assertion_result ar )
 {
-    BOOST_TEST_FOREACH( test_observer*, to, impl::s_frk_state().m_observers )
+    state::execution_context& ec = impl::s_frk_state().ctx();
+
+    // counted assertions are merged once the test case is finished
+    bool counted = ar == AR_PASSED || ec.m_monitor;
+    if( counted ) {
+        switch( ar ) {
+        case AR_PASSED:     ec.m_assertions_passed++; break;
+        case AR_FAILED:     ec.m_assertions_failed++; break;
+        case AR_TRIGGERED:  ec.m_warnings_failed++; break;
+        }
+    }
+
+    if( ar == AR_PASSED && !impl::s_frk_state().m_notify_passed_assertions )
+        return;
+
+    ut_detail::scoped_lock L( ut_detail::framework_mutex() );
+
+    BOOST_TEST_FOREACH( test_observer*, to, impl::s_frk_state().m_observers ) {
+        if( counted && to == &results_collector )
+            continue;
+
         to->assertion_result( ar );
+    }
 }
 
 //____________________________________________________________________________//
@@ -1255,6 +2915,8 @@ assertion_result( unit_test::assertion_result ar )
 void
 exception_caught( execution_exception const& ex )
 {
+    ut_detail::scoped_lock L( ut_detail::framework_mutex() );
+
     BOOST_TEST_FOREACH( test_observer*, to, impl::s_frk_state().m_observers )
         to->exception_caught( ex );
 }
@@ -1268,6 +2930,8 @@ exception_caught( execution_exception const& ex )
 void
 test_unit_aborted( test_unit const& tu )
 {
+    ut_detail::scoped_lock L( ut_detail::framework_mutex() );
+
     BOOST_TEST_FOREACH( test_observer*, to, impl::s_frk_state().m_observers )
         to->test_unit_aborted( tu );
 }
@@ -1275,6 +2939,25 @@ test_unit_aborted( test_unit const& tu )
 //____________________________________________________________________________//
 
 } // namespace framework
+
+// ************************************************************************** //
+// **************               framework_mutex                ************** //
+// ************************************************************************** //
+
+namespace ut_detail {
+
+recursive_mutex&
+framework_mutex()
+{
+    static recursive_mutex the_inst;
+
+    return the_inst;
+}
+
+} // namespace ut_detail
+
+//____________________________________________________________________________//
+
 } // namespace unit_test
 } // namespace boost
 
@@ -0,0 +1,263 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : implements OF_JSON log formatter
+// ***************************************************************************
+
+#ifndef BOOST_TEST_JSON_LOG_FORMATTER_IPP_101615GER
+#define BOOST_TEST_JSON_LOG_FORMATTER_IPP_101615GER
+
+// Boost.Test
+#include <boost/test/output/json_log_formatter.hpp>
+#include <boost/test/execution_monitor.hpp>
+#include <boost/test/framework.hpp>
+#include <boost/test/tree/test_unit.hpp>
+#include <boost/test/utils/json_printer.hpp>
+
+// Boost
+#include <boost/version.hpp>
+
+// STL
+#include <iostream>
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+namespace output {
+
+// ************************************************************************** //
+// **************              json_log_formatter              ************** //
+// ************************************************************************** //
+
+json_log_formatter::json_log_formatter()
+: m_entry_open( false )
+, m_test_case_id( INV_TEST_UNIT_ID )
+{
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::log_start( std::ostream& ostr, counter_t test_cases_amount )
+{
+    ostr << "{\"event\":\"log_start\",\"test_cases\":" << test_cases_amount << "}\n";
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::log_finish( std::ostream& ostr )
+{
+    ostr << "{\"event\":\"log_finish\"}\n";
+    ostr.flush();
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::log_build_info( std::ostream& ostr )
+{
+    ostr << "{\"event\":\"build_info\""
+         << ",\"platform\":"    << json_string() << BOOST_PLATFORM
+         << ",\"compiler\":"    << json_string() << BOOST_COMPILER
+         << ",\"stl\":"         << json_string() << BOOST_STDLIB
+         << ",\"boost\":\""     << BOOST_VERSION/100000     << "."
+                                << BOOST_VERSION/100 % 1000 << "."
+                                << BOOST_VERSION % 100      << "\"}\n";
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::test_unit_start( std::ostream& ostr, test_unit const& tu )
+{
+    print_unit( ostr, "unit_start", tu );
+
+    ostr << ",\"file\":" << json_string() << tu.p_file_name.get()
+         << ",\"line\":" << tu.p_line_num << "}\n";
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::test_unit_finish( std::ostream& ostr, test_unit const& tu, elapsed_time const& elapsed )
+{
+    print_unit( ostr, "unit_finish", tu );
+
+    ostr << ",\"wall_ns\":"     << elapsed.wall
+         << ",\"user_ns\":"     << elapsed.user
+         << ",\"system_ns\":"   << elapsed.system << "}\n";
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::test_unit_finish( std::ostream& ostr, test_unit const& tu, unsigned long elapsed )
+{
+    elapsed_time wall_time;
+    wall_time.wall = static_cast<elapsed_time::nanoseconds>( elapsed ) * 1000;
+
+    test_unit_finish( ostr, tu, wall_time );
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::test_unit_skipped( std::ostream& ostr, test_unit const& tu, const_string reason )
+{
+    print_unit( ostr, "unit_skipped", tu );
+
+    ostr << ",\"reason\":" << json_string() << reason << "}\n";
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::log_exception_start( std::ostream& ostr, log_checkpoint_data const& checkpoint_data, execution_exception const& ex )
+{
+    execution_exception::location const& loc = ex.where();
+
+    ostr << "{\"event\":\"exception\"";
+    print_test_case( ostr );
+    ostr << ",\"file\":"        << json_string() << loc.m_file_name
+         << ",\"line\":"        << loc.m_line_num
+         << ",\"function\":"    << json_string() << loc.m_function
+         << ",\"message\":"     << json_string() << ex.what();
+
+    if( !checkpoint_data.m_file_name.is_empty() ) {
+        ostr << ",\"checkpoint\":{\"file\":"    << json_string() << checkpoint_data.m_file_name
+             << ",\"line\":"                    << checkpoint_data.m_line_num
+             << ",\"message\":"                 << json_string() << checkpoint_data.m_message
+             << "}";
+    }
+
+    ostr << "}\n";
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::log_exception_finish( std::ostream& )
+{
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::log_entry_start( std::ostream& ostr, log_entry_data const& entry_data, log_entry_types let )
+{
+    static char const* entry_types[] = { "info", "message", "warning", "error", "fatal_error" };
+
+    ostr << "{\"event\":\"" << entry_types[let] << '"';
+    print_test_case( ostr );
+    ostr << ",\"file\":"    << json_string() << entry_data.m_file_name
+         << ",\"line\":"    << entry_data.m_line_num
+         << ",\"message\":\"";
+
+    m_entry_open = true;
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::log_entry_value( std::ostream& ostr, const_string value )
+{
+    print_json_escaped( ostr, value );
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::log_entry_finish( std::ostream& ostr )
+{
+    close_entry( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::entry_context_start( std::ostream& ostr, log_level )
+{
+    // the frames follow the entry they belong to
+    close_entry( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::log_entry_context( std::ostream& ostr, const_string context_descr )
+{
+    ostr << "{\"event\":\"context\",\"frame\":" << json_string() << context_descr << "}\n";
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::entry_context_finish( std::ostream& )
+{
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::print_unit( std::ostream& ostr, char const* event, test_unit const& tu )
+{
+    ostr << "{\"event\":\""     << event
+         << "\",\"unit\":\""    << (tu.p_type == TUT_CASE ? "case" : "suite")
+         << "\",\"name\":"      << json_string() << tu.p_name.get()
+         << ",\"full_name\":"   << json_string() << tu.full_name();
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::print_test_case( std::ostream& ostr )
+{
+    ostr << ",\"test_case\":";
+
+    if( !framework::test_in_progress() ) {
+        ostr << "null";
+        return;
+    }
+
+    // the full name is built once per test case rather than for every entry
+    if( m_test_case_id != framework::current_test_case_id() ) {
+        m_test_case_id   = framework::current_test_case_id();
+        m_test_case_name = framework::current_test_case().full_name();
+    }
+
+    ostr << json_string() << m_test_case_name;
+}
+
+//____________________________________________________________________________//
+
+void
+json_log_formatter::close_entry( std::ostream& ostr )
+{
+    if( !m_entry_open )
+        return;
+
+    ostr << "\"}\n";
+    m_entry_open = false;
+}
+
+//____________________________________________________________________________//
+
+} // namespace output
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_JSON_LOG_FORMATTER_IPP_101615GER
@@ -90,9 +90,8 @@ plain_report_formatter::results_report_start( std::ostream& ostr )
 //____________________________________________________________________________//
 
 void
-plain_report_formatter::results_report_finish( std::ostream& ostr )
+plain_report_formatter::results_report_finish( std::ostream& )
 {
-    ostr.flush();
 }
 
 //____________________________________________________________________________//
@@ -141,6 +140,16 @@ plain_report_formatter::test_unit_report_start( test_unit const& tu, std::ostrea
     print_stat_value( ostr, tr.p_warnings_failed   , m_indent, 0               , "warning"  , "failed" );
     print_stat_value( ostr, tr.p_expected_failures , m_indent, 0               , "failure"  , "expected" );
 
+    if( runtime_config::report_resource_usage() ) {
+        resource_usage const& usage = tr.p_resource_usage;
+
+        ostr << std::setw( static_cast<int>(m_indent) ) << ""
+             << "resource usage: " << usage.max_rss << " KB max RSS growth, "
+             << usage.minor_faults << " minor/" << usage.major_faults << " major page faults, "
+             << usage.voluntary_switches << " voluntary/" << usage.involuntary_switches << " involuntary context switches, "
+             << usage.block_inputs << " block inputs, " << usage.block_outputs << " block outputs\n";
+    }
+
     ostr << '\n';
 }
 
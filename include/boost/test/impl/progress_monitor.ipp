@@ -40,17 +40,21 @@ namespace unit_test {
 // ************************************************************************** //
 
 struct progress_display {
-    progress_display( counter_t expected_count, std::ostream& os )
+    progress_display( counter_t expected_count, std::ostream& os, bool flush_tics )
     : m_os(os)
     , m_count( 0 )
     , m_expected_count( expected_count )
     , m_next_tic_count( 0 )
     , m_tic( 0 )
+    , m_flush_tics( flush_tics )
     {
 
         m_os << "\n0%   10   20   30   40   50   60   70   80   90   100%"
              << "\n|----|----|----|----|----|----|----|----|----|----|"
-             << std::endl;
+             << '\n';
+
+        if( m_flush_tics )
+            m_os.flush();
 
         if( !m_expected_count ) 
             m_expected_count = 1;  // prevent divide by zero
@@ -68,16 +72,20 @@ struct progress_display {
             (static_cast<double>(m_count)/m_expected_count)*50.0 );
 
         do {
-            m_os << '*' << std::flush;
+            m_os << '*';
         } while( ++m_tic < tics_needed );
 
+        if( m_flush_tics )
+            m_os.flush();
+
         m_next_tic_count = static_cast<unsigned long>((m_tic/50.0) * m_expected_count);
 
         if( m_count == m_expected_count ) {
             if( m_tic < 51 )
                 m_os << '*';
 
-            m_os << std::endl;
+            m_os << '\n';
+            m_os.flush();
         }
 
         return m_count;
@@ -95,6 +103,7 @@ private:
     unsigned long   m_expected_count;
     unsigned long   m_next_tic_count;
     unsigned int    m_tic;
+    bool            m_flush_tics;   // are the tics flushed as they are displayed?
 };
 
 namespace {
@@ -120,7 +129,11 @@ progress_monitor_t::test_start( counter_t test_cases_amount )
 {
     BOOST_TEST_SCOPE_SETCOLOR( *s_pm_impl().m_stream, term_attr::BRIGHT, term_color::MAGENTA );
 
-    s_pm_impl().m_progress_display.reset( new progress_display( test_cases_amount, *s_pm_impl().m_stream ) );
+    // the tics are displayed at the test units boundaries
+    flush_mode mode = runtime_config::log_flush();
+
+    s_pm_impl().m_progress_display.reset( new progress_display( test_cases_amount, *s_pm_impl().m_stream,
+                                                                mode == FLUSH_LINE || mode == FLUSH_UNIT ) );
 }
 
 //____________________________________________________________________________//
@@ -22,14 +22,18 @@
 
 #include <boost/test/tree/test_unit.hpp>
 #include <boost/test/tree/visitor.hpp>
-#include <boost/test/tree/test_case_counter.hpp>
 #include <boost/test/tree/traverse.hpp>
 
+#include <boost/test/utils/foreach.hpp>
+
+#include <boost/test/detail/test_unit_id_table.hpp>
+
 // Boost
 #include <boost/cstdlib.hpp>
 
 // STL
-#include <map>
+#include <vector>
+#include <iostream>
 
 #include <boost/test/detail/suppress_warnings.hpp>
 
@@ -38,6 +42,30 @@
 namespace boost {
 namespace unit_test {
 
+namespace {
+
+inline void
+add_counter( resource_usage::counter& counter, resource_usage::counter value, bool subtract )
+{
+    counter = subtract ? counter - value : counter + value;
+}
+
+//____________________________________________________________________________//
+
+void
+add_resource_usage( resource_usage& to, resource_usage const& from, bool subtract = false )
+{
+    add_counter( to.max_rss,                from.max_rss,               subtract );
+    add_counter( to.minor_faults,           from.minor_faults,          subtract );
+    add_counter( to.major_faults,           from.major_faults,          subtract );
+    add_counter( to.voluntary_switches,     from.voluntary_switches,    subtract );
+    add_counter( to.involuntary_switches,   from.involuntary_switches,  subtract );
+    add_counter( to.block_inputs,           from.block_inputs,          subtract );
+    add_counter( to.block_outputs,          from.block_outputs,         subtract );
+}
+
+} // local namespace
+
 // ************************************************************************** //
 // **************                 test_results                 ************** //
 // ************************************************************************** //
@@ -83,6 +111,8 @@ test_results::operator+=( test_results const& tr )
     p_test_cases_failed.value   += tr.p_test_cases_failed;
     p_test_cases_skipped.value  += tr.p_test_cases_skipped;
     p_test_cases_aborted.value  += tr.p_test_cases_aborted;
+
+    add_resource_usage( p_resource_usage.value, tr.p_resource_usage );
 }
 
 //____________________________________________________________________________//
@@ -101,6 +131,7 @@ test_results::clear()
     p_test_cases_aborted.value  = 0;
     p_aborted.value             = false;
     p_skipped.value             = false;
+    p_resource_usage.value      = resource_usage();
 }
 
 //____________________________________________________________________________//
@@ -111,88 +142,197 @@ test_results::clear()
 
 namespace {
 
+struct unit_results {
+    unit_results() : m_epoch( 0 ), m_parent_epoch( 0 ) {}
+
+    test_results    m_results;
+    counter_t       m_epoch;        ///< changes every time the results are cleared
+    counter_t       m_parent_epoch; ///< epoch of the parent results these ones are accounted in; 0 if none
+};
+
 struct results_collector_impl {
-    std::map<test_unit_id,test_results> m_results_store;
+    results_collector_impl() : m_last_epoch( 0 ) {}
+
+    // the results of the test units which have not been started are empty
+    ut_detail::test_unit_id_table<unit_results> m_results_store;
+    counter_t                                   m_last_epoch;
 };
 
 results_collector_impl& s_rc_impl() { static results_collector_impl the_inst; return the_inst; }
 
-} // local namespace
-
 //____________________________________________________________________________//
 
-void
-results_collector_t::test_start( counter_t )
+// the results of the assertions made outside of any test case are not kept
+test_results&
+results_slot( test_unit_id id )
 {
-    s_rc_impl().m_results_store.clear();
+    if( id == INV_TEST_UNIT_ID ) {
+        static test_results s_outside_results;
+
+        s_outside_results.clear();
+        return s_outside_results;
+    }
+
+    return s_rc_impl().m_results_store[id].m_results;
 }
 
+} // local namespace
+
 //____________________________________________________________________________//
 
-void
-results_collector_t::test_unit_start( test_unit const& tu )
-{
-    // init test_results entry
-    test_results& tr = s_rc_impl().m_results_store[tu.p_id];
+// ************************************************************************** //
+// **************            results_collect_helper            ************** //
+// ************************************************************************** //
 
-    tr.clear();
+// Keeps the results of the test suites up to date as the test units in them finish, so they are never
+// collected from the test tree. The results of a test unit are added to the ones of its parent once the
+// test unit is finished or skipped; from then on any change is passed further up the parent chain. A test
+// unit executed again is taken out of its parent results first. All the notifications of the results
+// collector are serialized by the framework, including those about the test cases executed concurrently
 
-    tr.p_expected_failures.value = tu.p_expected_failures;
-}
+class results_collect_helper {
+public:
+    static void clear( test_unit_id id )
+    {
+        withdraw( id );
 
-//____________________________________________________________________________//
+        unit_results& ur = s_rc_impl().m_results_store[id];
 
-class results_collect_helper : public test_tree_visitor {
-public:
-    explicit results_collect_helper( test_results& tr, test_unit const& ts ) : m_tr( tr ), m_ts( ts ) {}
+        ur.m_results.clear();
+        ur.m_epoch = ++s_rc_impl().m_last_epoch;
+    }
+
+    // adds the results of the test unit to the ones of its parent
+    static void account( test_unit_id id )
+    {
+        withdraw( id );
+        propagate( id, false );
+    }
+
+    // takes the results of the test unit out of the ones of its parent
+    static void withdraw( test_unit_id id )
+    {
+        if( accounted( id ) )
+            propagate( id, true );
+    }
+
+private:
+    static bool accounted( test_unit_id id )
+    {
+        unit_results const* ur = s_rc_impl().m_results_store.find( id );
+        if( !ur || ur->m_parent_epoch == 0 )
+            return false;
+
+        unit_results const* parent_ur = s_rc_impl().m_results_store.find( framework::get( id, TUT_ANY ).p_parent_id );
+
+        return parent_ur && parent_ur->m_epoch == ur->m_parent_epoch;
+    }
+
+    //____________________________________________________________________________//
 
-    void    visit( test_case const& tc )
+    static void propagate( test_unit_id id, bool subtract )
     {
-        test_results const& tr = results_collector.results( tc.p_id );
-        m_tr += tr;
+        test_unit_id parent_id = framework::get( id, TUT_ANY ).p_parent_id;
+        if( parent_id == INV_TEST_UNIT_ID )
+            return;
+
+        test_results delta;
+        contribution( id, delta );
+
+        s_rc_impl().m_results_store[id].m_parent_epoch = subtract ? 0 : s_rc_impl().m_results_store[parent_id].m_epoch;
+
+        // the parents already accounted in their own parents pass the change further up
+        while( true ) {
+            add( results_slot( parent_id ), delta, subtract );
+
+            if( !accounted( parent_id ) )
+                break;
+
+            parent_id = framework::get( parent_id, TUT_ANY ).p_parent_id;
+        }
+    }
+
+    //____________________________________________________________________________//
+
+    static void contribution( test_unit_id id, test_results& delta )
+    {
+        test_results const& tr = results_slot( id );
+
+        delta += tr;
+
+        if( ut_detail::test_id_2_unit_type( id ) == TUT_SUITE )
+            return;
 
         if( tr.passed() ) {
             if( tr.p_warnings_failed )
-                m_tr.p_test_cases_warned.value++;
+                delta.p_test_cases_warned.value++;
             else
-                m_tr.p_test_cases_passed.value++;
+                delta.p_test_cases_passed.value++;
         }
         else if( tr.p_skipped )
-            m_tr.p_test_cases_skipped.value++;
+            delta.p_test_cases_skipped.value++;
         else {
             if( tr.p_aborted )
-                m_tr.p_test_cases_aborted.value++;
+                delta.p_test_cases_aborted.value++;
 
-            m_tr.p_test_cases_failed.value++;
+            delta.p_test_cases_failed.value++;
         }
     }
-    bool    test_suite_start( test_suite const& ts )
-    {
-        if( m_ts.p_id == ts.p_id )
-            return true;
 
-        m_tr += results_collector.results( ts.p_id );
-        return false;
+    //____________________________________________________________________________//
+
+    static void add( test_results& tr, test_results const& delta, bool subtract )
+    {
+        add( tr.p_assertions_passed.value,  delta.p_assertions_passed,  subtract );
+        add( tr.p_assertions_failed.value,  delta.p_assertions_failed,  subtract );
+        add( tr.p_warnings_failed.value,    delta.p_warnings_failed,    subtract );
+        add( tr.p_test_cases_passed.value,  delta.p_test_cases_passed,  subtract );
+        add( tr.p_test_cases_warned.value,  delta.p_test_cases_warned,  subtract );
+        add( tr.p_test_cases_failed.value,  delta.p_test_cases_failed,  subtract );
+        add( tr.p_test_cases_skipped.value, delta.p_test_cases_skipped, subtract );
+        add( tr.p_test_cases_aborted.value, delta.p_test_cases_aborted, subtract );
+
+        add_resource_usage( tr.p_resource_usage.value, delta.p_resource_usage, subtract );
     }
 
-private:
-    // Data members
-    test_results&       m_tr;
-    test_unit const&    m_ts;
+    static void add( counter_t& counter, counter_t value, bool subtract )
+    {
+        counter = subtract ? counter - value : counter + value;
+    }
 };
 
 //____________________________________________________________________________//
 
 void
-results_collector_t::test_unit_finish( test_unit const& tu, unsigned long )
+results_collector_t::test_start( counter_t )
 {
-    if( tu.p_type == TUT_SUITE ) {
-        results_collect_helper ch( s_rc_impl().m_results_store[tu.p_id], tu );
+    s_rc_impl().m_results_store.reset();
 
-        traverse_test_tree( tu, ch );
-    }
-    else {
-        test_results const& tr = s_rc_impl().m_results_store[tu.p_id];
+    // all the slots are in place before the test cases are executed concurrently
+    s_rc_impl().m_results_store.reserve( framework::impl::next_test_unit_id( TUT_CASE ),
+                                         framework::impl::next_test_unit_id( TUT_SUITE ) );
+}
+
+//____________________________________________________________________________//
+
+void
+results_collector_t::test_unit_start( test_unit const& tu )
+{
+    // init test_results entry
+    results_collect_helper::clear( tu.p_id );
+
+    results_slot( tu.p_id ).p_expected_failures.value = tu.p_expected_failures;
+}
+
+//____________________________________________________________________________//
+
+void
+results_collector_t::test_unit_finish( test_unit const& tu, elapsed_time const&, resource_usage const& usage )
+{
+    if( tu.p_type == TUT_CASE ) {
+        test_results& tr = results_slot( tu.p_id );
+
+        tr.p_resource_usage.value = usage;
 
         bool num_failures_match = tr.p_aborted || tr.p_assertions_failed >= tr.p_expected_failures;
         if( !num_failures_match )
@@ -202,6 +342,16 @@ results_collector_t::test_unit_finish( test_unit const& tu, unsigned long )
         if( !check_any_assertions )
             BOOST_TEST_MESSAGE( "Test case " << tu.full_name() << " did not check any assertions" );
     }
+
+    results_collect_helper::account( tu.p_id );
+}
+
+//____________________________________________________________________________//
+
+void
+results_collector_t::test_unit_finish( test_unit const& tu, unsigned long )
+{
+    test_unit_finish( tu, elapsed_time(), resource_usage() );
 }
 
 //____________________________________________________________________________//
@@ -209,18 +359,16 @@ results_collector_t::test_unit_finish( test_unit const& tu, unsigned long )
 void
 results_collector_t::test_unit_skipped( test_unit const& tu, const_string /*reason*/ )
 {
-    test_results& tr = s_rc_impl().m_results_store[tu.p_id];
+    results_collect_helper::clear( tu.p_id );
 
-    tr.clear();
+    test_results& tr = results_slot( tu.p_id );
 
     tr.p_skipped.value = true;
 
-    if( tu.p_type == TUT_SUITE ) {
-        test_case_counter tcc;
-        traverse_test_tree( tu, tcc );
+    if( tu.p_type == TUT_SUITE )
+        tr.p_test_cases_skipped.value = framework::impl::enabled_test_cases( tu.p_id );
 
-        tr.p_test_cases_skipped.value = tcc.p_count;
-    }
+    results_collect_helper::account( tu.p_id );
 }
 
 //____________________________________________________________________________//
@@ -228,7 +376,7 @@ results_collector_t::test_unit_skipped( test_unit const& tu, const_string /*reas
 void
 results_collector_t::assertion_result( unit_test::assertion_result ar )
 {
-    test_results& tr = s_rc_impl().m_results_store[framework::current_test_case_id()];
+    test_results& tr = results_slot( framework::current_test_case_id() );
 
     switch( ar ) {
     case AR_PASSED: tr.p_assertions_passed.value++; break;
@@ -245,7 +393,7 @@ results_collector_t::assertion_result( unit_test::assertion_result ar )
 void
 results_collector_t::exception_caught( execution_exception const& )
 {
-    test_results& tr = s_rc_impl().m_results_store[framework::current_test_case_id()];
+    test_results& tr = results_slot( framework::current_test_case_id() );
 
     tr.p_assertions_failed.value++;
 }
@@ -255,7 +403,7 @@ results_collector_t::exception_caught( execution_exception const& )
 void
 results_collector_t::test_unit_aborted( test_unit const& tu )
 {
-    s_rc_impl().m_results_store[tu.p_id].p_aborted.value = true;
+    results_slot( tu.p_id ).p_aborted.value = true;
 }
 
 //____________________________________________________________________________//
@@ -263,7 +411,132 @@ results_collector_t::test_unit_aborted( test_unit const& tu )
 test_results const&
 results_collector_t::results( test_unit_id id ) const
 {
-    return s_rc_impl().m_results_store[id];
+    static test_results const s_empty_results;
+
+    unit_results const* ur = s_rc_impl().m_results_store.find( id );
+
+    return ur ? ur->m_results : s_empty_results;
+}
+
+//____________________________________________________________________________//
+
+namespace {
+
+struct results_id_collector : public test_tree_visitor {
+    virtual bool    visit( test_unit const& tu )
+    {
+        m_ids.push_back( tu.p_id );
+        return true;
+    }
+
+    std::vector<test_unit_id> m_ids;
+};
+
+} // local namespace
+
+//____________________________________________________________________________//
+
+void
+results_collector_t::save_results( test_unit_id tu_id, std::ostream& ostr ) const
+{
+    results_id_collector ic;
+    traverse_test_tree( tu_id, ic );
+
+    ostr << ic.m_ids.size() << '\n';
+
+    BOOST_TEST_FOREACH( test_unit_id, id, ic.m_ids ) {
+        test_results const& tr = results( id );
+
+        ostr << id
+             << ' ' << tr.p_assertions_passed
+             << ' ' << tr.p_assertions_failed
+             << ' ' << tr.p_warnings_failed
+             << ' ' << tr.p_expected_failures
+             << ' ' << tr.p_test_cases_passed
+             << ' ' << tr.p_test_cases_warned
+             << ' ' << tr.p_test_cases_failed
+             << ' ' << tr.p_test_cases_skipped
+             << ' ' << tr.p_test_cases_aborted
+             << ' ' << tr.p_aborted
+             << ' ' << tr.p_skipped
+             << ' ' << tr.p_resource_usage.get().max_rss
+             << ' ' << tr.p_resource_usage.get().minor_faults
+             << ' ' << tr.p_resource_usage.get().major_faults
+             << ' ' << tr.p_resource_usage.get().voluntary_switches
+             << ' ' << tr.p_resource_usage.get().involuntary_switches
+             << ' ' << tr.p_resource_usage.get().block_inputs
+             << ' ' << tr.p_resource_usage.get().block_outputs << '\n';
+    }
+}
+
+//____________________________________________________________________________//
+
+bool
+results_collector_t::load_results( std::istream& istr )
+{
+    std::size_t num_units = 0;
+    if( !(istr >> num_units) )
+        return false;
+
+    // the results of the test tree root are the only ones accounted in the results known here
+    test_unit_id root_id = INV_TEST_UNIT_ID;
+
+    while( num_units-- > 0 ) {
+        test_unit_id id;
+        test_results tr;
+
+        istr >> id
+             >> tr.p_assertions_passed.value
+             >> tr.p_assertions_failed.value
+             >> tr.p_warnings_failed.value
+             >> tr.p_expected_failures.value
+             >> tr.p_test_cases_passed.value
+             >> tr.p_test_cases_warned.value
+             >> tr.p_test_cases_failed.value
+             >> tr.p_test_cases_skipped.value
+             >> tr.p_test_cases_aborted.value
+             >> tr.p_aborted.value
+             >> tr.p_skipped.value
+             >> tr.p_resource_usage.value.max_rss
+             >> tr.p_resource_usage.value.minor_faults
+             >> tr.p_resource_usage.value.major_faults
+             >> tr.p_resource_usage.value.voluntary_switches
+             >> tr.p_resource_usage.value.involuntary_switches
+             >> tr.p_resource_usage.value.block_inputs
+             >> tr.p_resource_usage.value.block_outputs;
+
+        if( !istr || id >= framework::impl::next_test_unit_id( ut_detail::test_id_2_unit_type( id ) ) )
+            return false;
+
+        if( root_id == INV_TEST_UNIT_ID ) {
+            root_id = id;
+            results_collect_helper::withdraw( root_id );
+        }
+
+        results_slot( id ) = tr;
+    }
+
+    if( root_id != INV_TEST_UNIT_ID )
+        results_collect_helper::account( root_id );
+
+    return true;
+}
+
+//____________________________________________________________________________//
+
+void
+results_collector_t::add_assertion_results( test_unit_id tu_id, counter_t passed, counter_t failed, counter_t warnings )
+{
+    test_results& tr = results_slot( tu_id );
+
+    bool had_failures = tr.p_assertions_failed != 0;
+
+    tr.p_assertions_passed.value    += passed;
+    tr.p_assertions_failed.value    += failed;
+    tr.p_warnings_failed.value      += warnings;
+
+    if( !had_failures && tr.p_assertions_failed != 0 )
+        first_failed_assertion();
 }
 
 //____________________________________________________________________________//
@@ -185,6 +185,9 @@ make_report( report_level l, test_unit_id id )
 
     s_rr_impl().m_formatter->results_report_finish( *s_rr_impl().m_output );
     s_rr_impl().m_report_level = bkup;
+
+    // the report is written at once, so it is flushed at its end with any flush policy
+    s_rr_impl().m_output->flush();
 }
 
 //____________________________________________________________________________//
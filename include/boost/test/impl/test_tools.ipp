@@ -298,6 +298,14 @@ report_assertion( assertion_result const&   ar,
         BOOST_TEST_IMPL_THROW( 
             std::runtime_error( "can't use testing tools outside of test case implementation" ) );
 
+    // nothing to report about the passed assertion unless successful checks are logged
+    if( !!ar && unit_test_log.threshold_level() > log_successful_tests ) {
+        framework::clear_context();
+        framework::assertion_result( AR_PASSED );
+
+        return true;
+    }
+
     if( !!ar )
         tl = PASS;
 
@@ -23,8 +23,11 @@
 #include <boost/test/tree/visitor.hpp>
 #include <boost/test/tree/traverse.hpp>
 #include <boost/test/tree/auto_registration.hpp>
+#include <boost/test/tree/static_registration.hpp>
 #include <boost/test/tree/global_fixture.hpp>
 
+#include <boost/test/detail/string_pool.hpp>
+
 #include <boost/test/utils/foreach.hpp>
 #include <boost/test/utils/basic_cstring/io.hpp>
 
@@ -36,6 +39,7 @@
 // STL
 #include <algorithm>
 #include <vector>
+#include <map>
 
 #include <boost/test/detail/suppress_warnings.hpp>
 
@@ -48,6 +52,47 @@
 namespace boost {
 namespace unit_test {
 
+// ************************************************************************** //
+// **************                  string_pool                 ************** //
+// ************************************************************************** //
+
+namespace ut_detail {
+
+string_pool&
+string_pool::instance()
+{
+    static string_pool the_inst;
+
+    return the_inst;
+}
+
+//____________________________________________________________________________//
+
+const_string
+string_pool::intern( const_string s )
+{
+    if( s.is_empty() )
+        return const_string();
+
+    if( s == m_last_interned )
+        return m_last_interned;
+
+    std::set<const_string>::const_iterator it = m_strings.find( s );
+
+    if( it == m_strings.end() ) {
+        // the copies never move, so the strings referring to them stay valid
+        m_storage.push_back( std::string( s.begin(), s.size() ) );
+
+        it = m_strings.insert( const_string( m_storage.back() ) ).first;
+    }
+
+    return m_last_interned = *it;
+}
+
+//____________________________________________________________________________//
+
+} // namespace ut_detail
+
 // ************************************************************************** //
 // **************                   test_unit                  ************** //
 // ************************************************************************** //
@@ -55,13 +100,15 @@ namespace unit_test {
 test_unit::test_unit( const_string name, const_string file_name, std::size_t line_num, test_unit_type t )
 : p_type( t )
 , p_type_name( t == TUT_CASE ? "case" : "suite" )
-, p_file_name( file_name )
+, p_file_name( ut_detail::string_pool::instance().intern( file_name ) )
 , p_line_num( line_num )
 , p_id( INV_TEST_UNIT_ID )
 , p_parent_id( INV_TEST_UNIT_ID )
 , p_name( std::string( name.begin(), name.size() ) )
 , p_timeout( 0 )
+, p_timeout_ms( 0 )
 , p_expected_failures( 0 )
+, p_concurrent( false )
 , p_default_status( RS_INHERIT )
 , p_run_status( RS_INVALID )
 , p_sibling_rank(0)
@@ -78,7 +125,9 @@ test_unit::test_unit( const_string module_name )
 , p_parent_id( INV_TEST_UNIT_ID )
 , p_name( std::string( module_name.begin(), module_name.size() ) )
 , p_timeout( 0 )
+, p_timeout_ms( 0 )
 , p_expected_failures( 0 )
+, p_concurrent( false )
 , p_default_status( RS_INHERIT )
 , p_run_status( RS_INVALID )
 , p_sibling_rank(0)
@@ -180,7 +229,7 @@ test_unit::full_name() const
 void
 test_unit::add_label( const_string l )
 {
-    p_labels.value.push_back( std::string() + l );
+    p_labels.value.push_back( std::string( l.begin(), l.size() ) );
 }
 
 //____________________________________________________________________________//
@@ -438,6 +487,108 @@ auto_test_unit_registrar::auto_test_unit_registrar( int )
 
 //____________________________________________________________________________//
 
+// ************************************************************************** //
+// **************          static_test_units_registrar         ************** //
+// ************************************************************************** //
+
+namespace {
+
+typedef std::pair<static_test_unit const*,static_test_unit const*> static_test_units_table;
+
+struct static_test_units_tables {
+    std::vector<static_test_units_table>    m_pending;
+    std::vector<static_test_unit const*>    m_registered;   ///< beginning of the tables already registered
+};
+
+static_test_units_tables&
+s_static_test_units()
+{
+    static static_test_units_tables the_inst;
+
+    return the_inst;
+}
+
+//____________________________________________________________________________//
+
+// orders the descriptors by the translation unit, then by their order within it
+struct ranked_static_test_unit {
+    ranked_static_test_unit( std::size_t tu_rank, static_test_unit const* su ) : m_tu_rank( tu_rank ), m_unit( su ) {}
+
+    bool        operator<( ranked_static_test_unit const& rhs ) const
+    {
+        return m_tu_rank != rhs.m_tu_rank ? m_tu_rank < rhs.m_tu_rank : m_unit->m_order < rhs.m_unit->m_order;
+    }
+
+    std::size_t             m_tu_rank;
+    static_test_unit const* m_unit;
+};
+
+} // local namespace
+
+//____________________________________________________________________________//
+
+static_test_units_registrar::static_test_units_registrar( static_test_unit const* begin, static_test_unit const* end )
+{
+    // all the translation units of a module report the same table
+    static_test_units_tables& tables = s_static_test_units();
+
+    if( begin == end ||
+        std::find( tables.m_registered.begin(), tables.m_registered.end(), begin ) != tables.m_registered.end() ||
+        std::find( tables.m_pending.begin(), tables.m_pending.end(), static_test_units_table( begin, end ) ) != tables.m_pending.end() )
+        return;
+
+    tables.m_pending.push_back( static_test_units_table( begin, end ) );
+}
+
+//____________________________________________________________________________//
+
+void
+static_test_units_registrar::register_test_units()
+{
+    static_test_units_tables& tables = s_static_test_units();
+
+    while( !tables.m_pending.empty() ) {
+        static_test_units_table table = tables.m_pending.front();
+        tables.m_pending.erase( tables.m_pending.begin() );
+        tables.m_registered.push_back( table.first );
+
+        // the linker keeps the translation units in the link order, but not necessarily the descriptors of each one
+        std::vector<ranked_static_test_unit>    units;
+        std::map<void const*,std::size_t>       tu_ranks;
+
+        for( static_test_unit const* su = table.first; su != table.second; ++su ) {
+            if( !su->m_tu )
+                continue;
+
+            std::size_t tu_rank = tu_ranks.insert( std::make_pair( su->m_tu, tu_ranks.size() ) ).first->second;
+            units.push_back( ranked_static_test_unit( tu_rank, su ) );
+        }
+
+        std::stable_sort( units.begin(), units.end() );
+
+        BOOST_TEST_FOREACH( ranked_static_test_unit const&, rsu, units ) {
+            static_test_unit const* su = rsu.m_unit;
+
+            switch( su->m_kind ) {
+            case static_test_unit::TEST_CASE:
+                auto_test_unit_registrar( make_test_case( su->m_func, su->m_name, su->m_file, su->m_line ), su->m_decorators() );
+                break;
+            case static_test_unit::SUITE_BEGIN:
+                auto_test_unit_registrar( su->m_name, su->m_file, su->m_line, su->m_decorators() );
+                break;
+            case static_test_unit::SUITE_END:
+                auto_test_unit_registrar( 1 );
+                break;
+            case static_test_unit::REGISTRATION:
+                su->m_func();
+                break;
+            }
+        }
+    }
+}
+
+//____________________________________________________________________________//
+
 } // namespace ut_detail
 
 // ************************************************************************** //
@@ -0,0 +1,212 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : implements portable wall clock and CPU time measurement
+// ***************************************************************************
+
+#ifndef BOOST_TEST_TIMER_IPP_101915GER
+#define BOOST_TEST_TIMER_IPP_101915GER
+
+// Boost.Test
+#include <boost/test/timer.hpp>
+
+// Implementation on Windows
+#if defined(_WIN32) && !defined(UNDER_CE) && !defined(BOOST_DISABLE_WIN32) // ******* WIN32
+
+#  define BOOST_TEST_WIN32_BASED_TIMER
+
+// SYSTEM API
+#  include <windows.h>
+
+#elif defined(BOOST_HAS_UNISTD_H) // *********************** POSIX
+
+#  define BOOST_TEST_POSIX_BASED_TIMER
+
+// SYSTEM API
+#  include <unistd.h>
+#  include <time.h>
+#  include <sys/time.h>
+#  include <sys/resource.h>
+
+#else // ********************************************************* OTHER
+
+// STL
+#  include <ctime>
+
+#  ifdef BOOST_NO_STDC_NAMESPACE
+namespace std { using ::clock; using ::clock_t; }
+#  endif
+
+#endif
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+
+namespace {
+
+#if defined(BOOST_TEST_WIN32_BASED_TIMER)
+
+// FILETIME is measured in 100ns intervals
+inline elapsed_time::nanoseconds
+filetime_to_ns( FILETIME const& ft )
+{
+    return ((static_cast<elapsed_time::nanoseconds>( ft.dwHighDateTime ) << 32) | ft.dwLowDateTime) * 100;
+}
+
+#elif defined(BOOST_TEST_POSIX_BASED_TIMER)
+
+inline elapsed_time::nanoseconds
+timeval_to_ns( timeval const& tv )
+{
+    return static_cast<elapsed_time::nanoseconds>( tv.tv_sec ) * 1000000000 + static_cast<elapsed_time::nanoseconds>( tv.tv_usec ) * 1000;
+}
+
+#endif
+
+} // local namespace
+
+//____________________________________________________________________________//
+
+elapsed_time
+current_time()
+{
+    elapsed_time res;
+
+#if defined(BOOST_TEST_WIN32_BASED_TIMER)
+    static LARGE_INTEGER s_frequency = {};
+    if( s_frequency.QuadPart == 0 )
+        ::QueryPerformanceFrequency( &s_frequency );
+
+    LARGE_INTEGER counter;
+    if( s_frequency.QuadPart != 0 && ::QueryPerformanceCounter( &counter ) ) {
+        // split the conversion to avoid the overflow for large counter values
+        elapsed_time::nanoseconds ticks = static_cast<elapsed_time::nanoseconds>( counter.QuadPart );
+        elapsed_time::nanoseconds freq  = static_cast<elapsed_time::nanoseconds>( s_frequency.QuadPart );
+
+        res.wall = ticks / freq * 1000000000 + ticks % freq * 1000000000 / freq;
+    }
+
+    FILETIME creation, exit, kernel, user;
+    if( ::GetProcessTimes( ::GetCurrentProcess(), &creation, &exit, &kernel, &user ) ) {
+        res.user    = filetime_to_ns( user );
+        res.system  = filetime_to_ns( kernel );
+    }
+#elif defined(BOOST_TEST_POSIX_BASED_TIMER)
+#  if defined(CLOCK_MONOTONIC)
+    timespec ts;
+    if( ::clock_gettime( CLOCK_MONOTONIC, &ts ) == 0 )
+        res.wall = static_cast<elapsed_time::nanoseconds>( ts.tv_sec ) * 1000000000 + static_cast<elapsed_time::nanoseconds>( ts.tv_nsec );
+#  else
+    // no monotonic clock available; system time adjustments affect the measurement
+    timeval tv;
+    if( ::gettimeofday( &tv, 0 ) == 0 )
+        res.wall = timeval_to_ns( tv );
+#  endif
+
+    rusage usage;
+    if( ::getrusage( RUSAGE_SELF, &usage ) == 0 ) {
+        res.user    = timeval_to_ns( usage.ru_utime );
+        res.system  = timeval_to_ns( usage.ru_stime );
+    }
+#else
+    // the best we can do portably: CPU time only, which is reported as both wall clock and user time
+    res.wall = res.user = static_cast<elapsed_time::nanoseconds>( std::clock() ) * 1000000000 / CLOCKS_PER_SEC;
+#endif
+
+    return res;
+}
+
+//____________________________________________________________________________//
+
+elapsed_time
+process_timer::elapsed() const
+{
+    elapsed_time now = current_time();
+    elapsed_time res;
+
+    // guard against the clocks which are not monotonic after all
+    res.wall    = now.wall   > m_start.wall   ? now.wall   - m_start.wall   : 0;
+    res.user    = now.user   > m_start.user   ? now.user   - m_start.user   : 0;
+    res.system  = now.system > m_start.system ? now.system - m_start.system : 0;
+
+    return res;
+}
+
+//____________________________________________________________________________//
+
+resource_usage
+current_resource_usage( bool calling_thread )
+{
+    resource_usage res;
+
+#if defined(BOOST_TEST_POSIX_BASED_TIMER)
+    rusage usage;
+    if( ::getrusage( RUSAGE_SELF, &usage ) != 0 )
+        return res;
+
+#  if defined(__APPLE__)
+    res.max_rss = static_cast<resource_usage::counter>( usage.ru_maxrss ) / 1024; // reported in bytes
+#  else
+    res.max_rss = static_cast<resource_usage::counter>( usage.ru_maxrss );
+#  endif
+
+    // the peak resident set size is not tracked per thread
+#  if defined(RUSAGE_THREAD)
+    if( calling_thread && ::getrusage( RUSAGE_THREAD, &usage ) != 0 )
+        return res;
+#  else
+    (void)calling_thread;
+#  endif
+
+    res.minor_faults            = static_cast<resource_usage::counter>( usage.ru_minflt );
+    res.major_faults            = static_cast<resource_usage::counter>( usage.ru_majflt );
+    res.voluntary_switches      = static_cast<resource_usage::counter>( usage.ru_nvcsw );
+    res.involuntary_switches    = static_cast<resource_usage::counter>( usage.ru_nivcsw );
+    res.block_inputs            = static_cast<resource_usage::counter>( usage.ru_inblock );
+    res.block_outputs           = static_cast<resource_usage::counter>( usage.ru_oublock );
+#else
+    (void)calling_thread;
+#endif
+
+    return res;
+}
+
+//____________________________________________________________________________//
+
+resource_usage
+resource_meter::usage() const
+{
+    resource_usage now = current_resource_usage( m_calling_thread );
+    resource_usage res;
+
+    res.max_rss                 = now.max_rss              > m_start.max_rss              ? now.max_rss              - m_start.max_rss              : 0;
+    res.minor_faults            = now.minor_faults         > m_start.minor_faults         ? now.minor_faults         - m_start.minor_faults         : 0;
+    res.major_faults            = now.major_faults         > m_start.major_faults         ? now.major_faults         - m_start.major_faults         : 0;
+    res.voluntary_switches      = now.voluntary_switches   > m_start.voluntary_switches   ? now.voluntary_switches   - m_start.voluntary_switches   : 0;
+    res.involuntary_switches    = now.involuntary_switches > m_start.involuntary_switches ? now.involuntary_switches - m_start.involuntary_switches : 0;
+    res.block_inputs            = now.block_inputs         > m_start.block_inputs         ? now.block_inputs         - m_start.block_inputs         : 0;
+    res.block_outputs           = now.block_outputs        > m_start.block_outputs        ? now.block_outputs        - m_start.block_outputs        : 0;
+
+    return res;
+}
+
+//____________________________________________________________________________//
+
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_TIMER_IPP_101915GER
@@ -0,0 +1,312 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : implements persistent storage for the history of test units durations
+// ***************************************************************************
+
+#ifndef BOOST_TEST_TIMING_DB_IPP_101615GER
+#define BOOST_TEST_TIMING_DB_IPP_101615GER
+
+// Boost.Test
+#include <boost/test/timing_db.hpp>
+#include <boost/test/unit_test_log.hpp>
+
+#include <boost/test/tree/test_unit.hpp>
+
+#include <boost/test/utils/foreach.hpp>
+
+// Boost
+#include <boost/cstdint.hpp>
+
+// STL
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+
+// ************************************************************************** //
+// **************                 timing_record                ************** //
+// ************************************************************************** //
+
+const std::size_t timing_record::history_size;
+
+//____________________________________________________________________________//
+
+void
+timing_record::add( unsigned long elapsed )
+{
+    m_durations.push_back( elapsed );
+
+    if( m_durations.size() > history_size )
+        m_durations.erase( m_durations.begin(), m_durations.end() - history_size );
+
+    double sum = 0;
+    BOOST_TEST_FOREACH( unsigned long, d, m_durations )
+        sum += static_cast<double>( d );
+
+    m_mean = sum / m_durations.size();
+
+    double sq_sum = 0;
+    BOOST_TEST_FOREACH( unsigned long, d, m_durations )
+        sq_sum += (static_cast<double>( d ) - m_mean) * (static_cast<double>( d ) - m_mean);
+
+    m_variance = m_durations.size() > 1 ? sq_sum / (m_durations.size() - 1) : 0;
+}
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************                   timing_db                  ************** //
+// ************************************************************************** //
+
+namespace {
+
+char const          TIMING_DB_MAGIC[4]  = { 'B', 'T', 'T', 'D' };
+boost::uint32_t     TIMING_DB_VERSION   = 1;
+
+struct timing_db_impl {
+    std::string             m_file_name;
+    timing_db_t::records_t  m_records;
+};
+
+timing_db_impl& s_tdb_impl() { static timing_db_impl the_inst; return the_inst; }
+
+//____________________________________________________________________________//
+
+void
+write_uint( std::string& buffer, boost::uint64_t value, std::size_t num_bytes )
+{
+    for( std::size_t i = 0; i < num_bytes; ++i )
+        buffer += static_cast<char>( (value >> (8*i)) & 0xFF );
+}
+
+//____________________________________________________________________________//
+
+void
+write_double( std::string& buffer, double value )
+{
+    boost::uint64_t bits;
+    std::memcpy( &bits, &value, sizeof(bits) );
+
+    write_uint( buffer, bits, 8 );
+}
+
+//____________________________________________________________________________//
+
+// reads the content of the file sequentially; any read past the end of it puts the reader into a failed state
+struct db_reader {
+    explicit db_reader( std::string const& data ) : m_data( data ), m_pos( 0 ), m_failed( false ) {}
+
+    boost::uint64_t read_uint( std::size_t num_bytes )
+    {
+        if( !check_available( num_bytes ) )
+            return 0;
+
+        boost::uint64_t value = 0;
+        for( std::size_t i = 0; i < num_bytes; ++i )
+            value |= static_cast<boost::uint64_t>( static_cast<unsigned char>( m_data[m_pos++] ) ) << (8*i);
+
+        return value;
+    }
+
+    double          read_double()
+    {
+        boost::uint64_t bits = read_uint( 8 );
+
+        double value;
+        std::memcpy( &value, &bits, sizeof(value) );
+
+        return value;
+    }
+
+    std::string     read_string( std::size_t size )
+    {
+        if( !check_available( size ) )
+            return std::string();
+
+        m_pos += size;
+
+        return m_data.substr( m_pos - size, size );
+    }
+
+    bool            check_available( std::size_t num_bytes )
+    {
+        m_failed = m_failed || m_data.size() - m_pos < num_bytes;
+
+        return !m_failed;
+    }
+
+    // Data members
+    std::string const&  m_data;
+    std::size_t         m_pos;
+    bool                m_failed;
+};
+
+} // local namespace
+
+//____________________________________________________________________________//
+
+void
+timing_db_t::test_finish()
+{
+    if( s_tdb_impl().m_file_name.empty() )
+        return;
+
+    if( !save( s_tdb_impl().m_file_name ) )
+        BOOST_TEST_LOG_ENTRY( log_warnings ) << "Failed to update test timing database " << s_tdb_impl().m_file_name;
+}
+
+//____________________________________________________________________________//
+
+void
+timing_db_t::test_unit_finish( test_unit const& tu, unsigned long elapsed )
+{
+    s_tdb_impl().m_records[tu.full_name()].add( elapsed );
+}
+
+//____________________________________________________________________________//
+
+bool
+timing_db_t::load( std::string const& file_name )
+{
+    s_tdb_impl().m_file_name = file_name;
+    s_tdb_impl().m_records.clear();
+
+    std::ifstream file( file_name.c_str(), std::ios::in | std::ios::binary );
+
+    // no history yet
+    if( !file )
+        return true;
+
+    file.close();
+
+    return read( file_name, s_tdb_impl().m_records );
+}
+
+//____________________________________________________________________________//
+
+bool
+timing_db_t::read( std::string const& file_name, records_t& records )
+{
+    std::ifstream file( file_name.c_str(), std::ios::in | std::ios::binary );
+
+    if( !file )
+        return false;
+
+    std::ostringstream content;
+    content << file.rdbuf();
+
+    std::string const& data = content.str();
+    db_reader reader( data );
+
+    if( reader.read_string( sizeof(TIMING_DB_MAGIC) ) != std::string( TIMING_DB_MAGIC, sizeof(TIMING_DB_MAGIC) ) ||
+        reader.read_uint( 4 ) != TIMING_DB_VERSION )
+        return false;
+
+    reader.read_uint( 4 ); // history size this file was written with
+
+    boost::uint64_t num_records = reader.read_uint( 4 );
+
+    records_t read_records;
+
+    while( !reader.m_failed && num_records-- > 0 ) {
+        std::string name = reader.read_string( static_cast<std::size_t>( reader.read_uint( 4 ) ) );
+
+        timing_record tr;
+
+        boost::uint64_t num_durations = reader.read_uint( 4 );
+        if( !reader.check_available( static_cast<std::size_t>( num_durations * 8 ) ) )
+            break;
+
+        while( num_durations-- > 0 )
+            tr.m_durations.push_back( static_cast<unsigned long>( reader.read_uint( 8 ) ) );
+
+        // the history might have been recorded with a different size
+        if( tr.m_durations.size() > timing_record::history_size )
+            tr.m_durations.erase( tr.m_durations.begin(), tr.m_durations.end() - timing_record::history_size );
+
+        tr.m_mean       = reader.read_double();
+        tr.m_variance   = reader.read_double();
+
+        read_records[name] = tr;
+    }
+
+    if( reader.m_failed )
+        return false;
+
+    records.swap( read_records );
+
+    return true;
+}
+
+//____________________________________________________________________________//
+
+bool
+timing_db_t::save( std::string const& file_name ) const
+{
+    std::string buffer( TIMING_DB_MAGIC, sizeof(TIMING_DB_MAGIC) );
+
+    write_uint( buffer, TIMING_DB_VERSION, 4 );
+    write_uint( buffer, timing_record::history_size, 4 );
+    write_uint( buffer, s_tdb_impl().m_records.size(), 4 );
+
+    BOOST_TEST_FOREACH( records_t::value_type const&, r, s_tdb_impl().m_records ) {
+        write_uint( buffer, r.first.size(), 4 );
+        buffer += r.first;
+
+        write_uint( buffer, r.second.m_durations.size(), 4 );
+        BOOST_TEST_FOREACH( unsigned long, d, r.second.m_durations )
+            write_uint( buffer, d, 8 );
+
+        write_double( buffer, r.second.m_mean );
+        write_double( buffer, r.second.m_variance );
+    }
+
+    std::ofstream file( file_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+
+    file.write( buffer.data(), static_cast<std::streamsize>( buffer.size() ) );
+    file.close();
+
+    return !file.fail();
+}
+
+//____________________________________________________________________________//
+
+timing_record const*
+timing_db_t::record( std::string const& full_name ) const
+{
+    records_t::const_iterator it = s_tdb_impl().m_records.find( full_name );
+
+    return it == s_tdb_impl().m_records.end() ? 0 : &it->second;
+}
+
+//____________________________________________________________________________//
+
+timing_db_t::records_t const&
+timing_db_t::records() const
+{
+    return s_tdb_impl().m_records;
+}
+
+//____________________________________________________________________________//
+
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_TIMING_DB_IPP_101615GER
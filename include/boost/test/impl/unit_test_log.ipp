@@ -20,19 +20,49 @@
 #include <boost/test/unit_test_log_formatter.hpp>
 #include <boost/test/execution_monitor.hpp>
 #include <boost/test/framework.hpp>
+#include <boost/test/results_collector.hpp>
+#include <boost/test/tree/test_unit.hpp>
 
 #include <boost/test/unit_test_parameters.hpp>
 
 #include <boost/test/utils/basic_cstring/compare.hpp>
 
+#include <boost/test/detail/concurrency.hpp>
+#include <boost/test/utils/foreach.hpp>
+
 #include <boost/test/output/compiler_log_formatter.hpp>
 #include <boost/test/output/xml_log_formatter.hpp>
+#include <boost/test/output/binary_log_formatter.hpp>
+#include <boost/test/output/json_log_formatter.hpp>
 
 // Boost
 #include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/io/ios_state.hpp>
 typedef ::boost::io::ios_base_all_saver io_saver_type;
 
+// STL
+#include <vector>
+#include <streambuf>
+#include <ostream>
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+#ifdef BOOST_TEST_CONCURRENT_EXECUTION
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+#if defined(BOOST_HAS_UNISTD_H)
+// SYSTEM API
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#endif
+
 #include <boost/test/detail/suppress_warnings.hpp>
 
 //____________________________________________________________________________//
@@ -56,71 +86,1130 @@ entry_value_collector::operator<<( lazy_ostream const& v ) const
 
 //____________________________________________________________________________//
 
-entry_value_collector const&
-entry_value_collector::operator<<( const_string v ) const
-{
-    unit_test_log << v;
+entry_value_collector const&
+entry_value_collector::operator<<( const_string v ) const
+{
+    unit_test_log << v;
+
+    return *this;
+}
+
+//____________________________________________________________________________//
+
+entry_value_collector::~entry_value_collector()
+{
+    if( m_last )
+        unit_test_log << log::end();
+}
+
+//____________________________________________________________________________//
+
+} // namespace ut_detail
+
+// ************************************************************************** //
+// **************                 unit_test_log                ************** //
+// ************************************************************************** //
+
+namespace {
+
+typedef scoped_ptr<unit_test_log_formatter> formatter_ptr;
+typedef scoped_ptr<io_saver_type>           saver_ptr;
+
+// ************************************************************************** //
+// **************                  log events                  ************** //
+// ************************************************************************** //
+
+// Call to the log formatter recorded to be replayed later. The events are reused, so their strings keep the capacity
+struct log_event {
+    enum event_type { LOG_START, BUILD_INFO, LOG_FINISH, UNIT_START, UNIT_FINISH, UNIT_SKIPPED,
+                      EXCEPTION_START, EXCEPTION_FINISH, ENTRY_START, ENTRY_VALUE, ENTRY_FINISH,
+                      CONTEXT_START, CONTEXT_VALUE, CONTEXT_FINISH, APPEND, FLUSH };
+
+    event_type                                  m_type;
+    std::ostream*                               m_stream;
+    test_unit_id                                m_curr_test_case;
+    test_unit const*                            m_tu;
+    counter_t                                   m_test_cases_amount;
+    elapsed_time                                m_elapsed;
+    log_entry_data                              m_entry;
+    unit_test_log_formatter::log_entry_types    m_entry_type;
+    log_level                                   m_level;
+    log_checkpoint_data                         m_checkpoint;
+    execution_exception::error_code             m_error_code;
+    std::string                                 m_value;    // entry value, context frame, skip reason, error message or log content
+    std::string                                 m_file_name;
+    std::size_t                                 m_line_num;
+    std::string                                 m_function;
+};
+
+//____________________________________________________________________________//
+
+// calls the formatter the way the event was recorded; the stream state is restored before each entry
+void
+replay_log_event( log_event const& e, unit_test_log_formatter& f, std::ostream& os, io_saver_type* stream_state_saver )
+{
+    switch( e.m_type ) {
+    case log_event::LOG_START:          f.log_start( os, e.m_test_cases_amount ); break;
+    case log_event::BUILD_INFO:         f.log_build_info( os ); break;
+    case log_event::LOG_FINISH:         f.log_finish( os ); break;
+    case log_event::UNIT_START:         f.test_unit_start( os, *e.m_tu ); break;
+    case log_event::UNIT_FINISH:        f.test_unit_finish( os, *e.m_tu, e.m_elapsed ); break;
+    case log_event::UNIT_SKIPPED:       f.test_unit_skipped( os, *e.m_tu, e.m_value ); break;
+    case log_event::EXCEPTION_START: {
+        execution_exception ex( e.m_error_code, e.m_value,
+                                execution_exception::location( e.m_file_name.c_str(), e.m_line_num, e.m_function.c_str() ) );
+
+        f.log_exception_start( os, e.m_checkpoint, ex );
+        break;
+    }
+    case log_event::EXCEPTION_FINISH:   f.log_exception_finish( os ); break;
+    case log_event::ENTRY_START:
+        if( stream_state_saver )
+            stream_state_saver->restore();
+
+        f.log_entry_start( os, e.m_entry, e.m_entry_type );
+        break;
+    case log_event::ENTRY_VALUE:        f.log_entry_value( os, e.m_value ); break;
+    case log_event::ENTRY_FINISH:       f.log_entry_finish( os ); break;
+    case log_event::CONTEXT_START:      f.entry_context_start( os, e.m_level ); break;
+    case log_event::CONTEXT_VALUE:      f.log_entry_context( os, e.m_value ); break;
+    case log_event::CONTEXT_FINISH:     f.entry_context_finish( os ); break;
+    case log_event::APPEND:             f.log_content( os, e.m_value ); break;
+    case log_event::FLUSH:              os.flush(); break;
+    }
+}
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************               fatal log writer               ************** //
+// ************************************************************************** //
+
+// Writes the log kept in memory into the file descriptor of the sink before the process is terminated by a signal.
+// It is used from the signal handler, so only async-signal-safe functions are called: there are no locks, no memory
+// allocations and no streams. The recorded events are written as plain text, since the formatters can not be used
+class fatal_log_writer {
+public:
+    explicit            fatal_log_writer( int fd ) : m_fd( fd ) {}
+
+    void                write( char const* s, std::size_t n )
+    {
+#if defined(BOOST_HAS_UNISTD_H)
+        while( n > 0 ) {
+            ssize_t written = ::write( m_fd, s, n );
+            if( written < 0 && errno == EINTR )
+                continue;
+            if( written <= 0 )
+                return;
+
+            s += written;
+            n -= static_cast<std::size_t>( written );
+        }
+#else
+        (void)s; (void)n;
+#endif
+    }
+    void                write( char const* s )          { write( s, std::char_traits<char>::length( s ) ); }
+    void                write( std::string const& s )   { write( s.data(), s.size() ); }
+    void                write( std::size_t n )
+    {
+        char buffer[24];
+        char* p = buffer + sizeof(buffer);
+
+        do {
+            *--p = static_cast<char>( '0' + n % 10 );
+            n /= 10;
+        } while( n != 0 );
+
+        write( p, static_cast<std::size_t>( buffer + sizeof(buffer) - p ) );
+    }
+
+    // writes the content of the stream buffer, which is not yet passed on
+    void                write_pending( std::streambuf* sb )
+    {
+        if( !sb )
+            return;
+
+        char const* begin = put_area::begin( *sb );
+        char const* end   = put_area::end( *sb );
+
+        if( begin && end > begin )
+            write( begin, static_cast<std::size_t>( end - begin ) );
+    }
+
+    void                write_event( log_event const& e )
+    {
+        switch( e.m_type ) {
+        case log_event::UNIT_START:
+            write( "Entering test " ); write( e.m_tu->p_type_name.get().begin(), e.m_tu->p_type_name.get().size() );
+            write( " \"" ); write( e.m_tu->p_name.get() ); write( "\"\n" );
+            break;
+        case log_event::UNIT_FINISH:
+            write( "Leaving test " ); write( e.m_tu->p_type_name.get().begin(), e.m_tu->p_type_name.get().size() );
+            write( " \"" ); write( e.m_tu->p_name.get() ); write( "\"\n" );
+            break;
+        case log_event::UNIT_SKIPPED:
+            write( "Test " ); write( e.m_tu->p_type_name.get().begin(), e.m_tu->p_type_name.get().size() );
+            write( " \"" ); write( e.m_tu->p_name.get() ); write( "\" is skipped because " ); write( e.m_value ); write( "\n" );
+            break;
+        case log_event::EXCEPTION_START:
+            write( e.m_file_name ); write( "(" ); write( e.m_line_num ); write( "): fatal error: " ); write( e.m_value );
+            write( "\n" );
+            break;
+        case log_event::ENTRY_START:
+            write( e.m_entry.m_file_name ); write( "(" ); write( e.m_entry.m_line_num ); write( "): " );
+            switch( e.m_entry_type ) {
+            case unit_test_log_formatter::BOOST_UTL_ET_INFO:        write( "info: " ); break;
+            case unit_test_log_formatter::BOOST_UTL_ET_MESSAGE:     break;
+            case unit_test_log_formatter::BOOST_UTL_ET_WARNING:     write( "warning: " ); break;
+            case unit_test_log_formatter::BOOST_UTL_ET_ERROR:       write( "error: " ); break;
+            case unit_test_log_formatter::BOOST_UTL_ET_FATAL_ERROR: write( "fatal error: " ); break;
+            }
+            break;
+        case log_event::ENTRY_VALUE:
+        case log_event::APPEND:
+            write( e.m_value );
+            break;
+        case log_event::ENTRY_FINISH:
+            write( "\n" );
+            break;
+        case log_event::CONTEXT_START:
+            write( "\nFailure occurred in a following context:" );
+            break;
+        case log_event::CONTEXT_VALUE:
+            write( "\n    " ); write( e.m_value );
+            break;
+        default:
+            break;
+        }
+    }
+
+private:
+    // gives access to the put area of any stream buffer
+    struct put_area : std::streambuf {
+        static char*    begin( std::streambuf& sb ) { return (sb.*&put_area::pbase)(); }
+        static char*    end( std::streambuf& sb )   { return (sb.*&put_area::pptr)(); }
+    };
+
+    // Data members
+    int                 m_fd;
+};
+
+//____________________________________________________________________________//
+
+// Formatter recording the calls as log events instead of writing the log. The derived class provides the event to fill
+// in and is notified once it is complete
+class log_event_recorder : public unit_test_log_formatter {
+public:
+    // unit_test_log_formatter interface
+    virtual void        log_start( std::ostream& os, counter_t test_cases_amount )
+    {
+        start_event( log_event::LOG_START, os ).m_test_cases_amount = test_cases_amount;
+        publish();
+    }
+    virtual void        log_finish( std::ostream& os )
+    {
+        start_event( log_event::LOG_FINISH, os );
+        publish();
+    }
+    virtual void        log_build_info( std::ostream& os )
+    {
+        start_event( log_event::BUILD_INFO, os );
+        publish();
+    }
+
+    virtual void        test_unit_start( std::ostream& os, test_unit const& tu )
+    {
+        start_event( log_event::UNIT_START, os ).m_tu = &tu;
+        publish();
+    }
+    virtual void        test_unit_finish( std::ostream& os, test_unit const& tu, elapsed_time const& elapsed )
+    {
+        log_event& e = start_event( log_event::UNIT_FINISH, os );
+        e.m_tu      = &tu;
+        e.m_elapsed = elapsed;
+        publish();
+    }
+    virtual void        test_unit_finish( std::ostream& os, test_unit const& tu, unsigned long elapsed )
+    {
+        elapsed_time et;
+        et.wall = static_cast<elapsed_time::nanoseconds>( elapsed ) * 1000;
+
+        test_unit_finish( os, tu, et );
+    }
+    virtual void        test_unit_skipped( std::ostream& os, test_unit const& tu, const_string reason )
+    {
+        log_event& e = start_event( log_event::UNIT_SKIPPED, os );
+        e.m_tu = &tu;
+        e.m_value.assign( reason.begin(), reason.end() );
+        publish();
+    }
+
+    virtual void        log_exception_start( std::ostream& os, log_checkpoint_data const& lcd, execution_exception const& ex )
+    {
+        // the exception refers to the buffers which are going to be reused, so everything is copied
+        log_event& e = start_event( log_event::EXCEPTION_START, os );
+        e.m_curr_test_case  = framework::current_test_case_id();
+        e.m_checkpoint      = lcd;
+        e.m_error_code      = ex.code();
+        e.m_value.assign( ex.what().begin(), ex.what().end() );
+        e.m_file_name.assign( ex.where().m_file_name.begin(), ex.where().m_file_name.end() );
+        e.m_line_num        = ex.where().m_line_num;
+        e.m_function.assign( ex.where().m_function.begin(), ex.where().m_function.end() );
+        publish();
+    }
+    virtual void        log_exception_finish( std::ostream& os )
+    {
+        start_event( log_event::EXCEPTION_FINISH, os );
+        publish();
+    }
+
+    virtual void        log_entry_start( std::ostream& os, log_entry_data const& led, log_entry_types let )
+    {
+        log_event& e = start_event( log_event::ENTRY_START, os );
+        e.m_curr_test_case  = framework::current_test_case_id();
+        e.m_entry           = led;
+        e.m_entry_type      = let;
+        publish();
+    }
+    virtual void        log_entry_value( std::ostream& os, const_string value )
+    {
+        start_event( log_event::ENTRY_VALUE, os ).m_value.assign( value.begin(), value.end() );
+        publish();
+    }
+    virtual void        log_entry_value( std::ostream& os, lazy_ostream const& value )
+    {
+        unit_test_log_formatter::log_entry_value( os, value );
+    }
+    virtual void        log_entry_finish( std::ostream& os )
+    {
+        start_event( log_event::ENTRY_FINISH, os );
+        publish();
+    }
+
+    virtual void        entry_context_start( std::ostream& os, log_level l )
+    {
+        start_event( log_event::CONTEXT_START, os ).m_level = l;
+        publish();
+    }
+    virtual void        log_entry_context( std::ostream& os, const_string value )
+    {
+        start_event( log_event::CONTEXT_VALUE, os ).m_value.assign( value.begin(), value.end() );
+        publish();
+    }
+    virtual void        entry_context_finish( std::ostream& os )
+    {
+        start_event( log_event::CONTEXT_FINISH, os );
+        publish();
+    }
+
+    virtual void        log_content( std::ostream& os, const_string content )
+    {
+        start_event( log_event::APPEND, os ).m_value.assign( content.begin(), content.end() );
+        publish();
+    }
+
+protected:
+    // returns the event to record the call into
+    virtual log_event&  start_event( log_event::event_type type, std::ostream& os ) = 0;
+    // the event returned by start_event is complete
+    virtual void        publish() = 0;
+};
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************                async log sink                ************** //
+// ************************************************************************** //
+
+#ifdef BOOST_TEST_CONCURRENT_EXECUTION
+
+// is this thread the background one of an async log sink?
+BOOST_TEST_THREAD_LOCAL bool s_log_writer_thread = false;
+
+// Records the calls to the log formatter in a bounded lock-free ring buffer, which is drained by a background thread
+// replaying these calls on the actual formatter. The calls are serialized by the framework mutex, so there is a single
+// producer at a time. The background thread is started by the first event and stopped by drain()
+class async_log_sink : public log_event_recorder {
+public:
+    // Constructor
+    async_log_sink( formatter_ptr const& formatter, saver_ptr const& stream_state_saver )
+    : m_formatter( formatter )
+    , m_stream_state_saver( stream_state_saver )
+    , m_enabled( false )
+    , m_events( capacity )
+    , m_head( 0 )
+    , m_tail( 0 )
+    , m_stop( false )
+    , m_idle( false )
+    , m_abandoned( false )
+    , m_replaying( false )
+    {
+    }
+    ~async_log_sink() { drain(); }
+
+    bool                enabled() const                 { return m_enabled; }
+    void                enable( bool on )               { drain(); m_enabled = on; }
+    unit_test_log_formatter* recorder()                 { return this; }
+
+    // waits until all the recorded events are replayed
+    void                drain()
+    {
+        if( !m_thread.joinable() )
+            return;
+
+        m_stop = true;
+        wake_up();
+        m_thread.join();
+        m_stop = false;
+    }
+
+    // the stream is flushed by the background thread once the preceding events are written
+    void                flush_stream( std::ostream& os )
+    {
+        start_event( log_event::FLUSH, os );
+        publish();
+    }
+
+    // Called from the signal handler: stops the background thread once it is done with the event it replays, so
+    // that the signal handler can take over. The thread is given a second at most, unless it is the crashed one
+    void                stop_on_fatal_signal()
+    {
+        if( !m_thread.joinable() )
+            return;
+
+        m_abandoned = true;
+
+        for( int i = 0; i < 100 && m_replaying && !s_log_writer_thread; ++i ) {
+#if defined(BOOST_HAS_UNISTD_H)
+            timespec pause = { 0, 10000000 };
+            ::nanosleep( &pause, 0 );
+#else
+            std::this_thread::yield();
+#endif
+        }
+    }
+
+    // Called from the signal handler once the background thread is stopped: writes the events it did not replay,
+    // except for the one the crashed thread may be recording
+    void                write_on_fatal_signal( fatal_log_writer& w )
+    {
+        std::size_t head = m_head.load();
+
+        for( std::size_t tail = m_tail.load(); tail != head; ++tail )
+            w.write_event( m_events[tail & (capacity - 1)] );
+    }
+
+private:
+    // has to be a power of 2
+    enum { capacity = 4096 };
+
+    virtual log_event&  start_event( log_event::event_type type, std::ostream& os )
+    {
+        if( !m_thread.joinable() )
+            m_thread = std::thread( &async_log_sink::replay_events, this );
+
+        std::size_t head = m_head.load( std::memory_order_relaxed );
+
+        // the buffer is full: rather than losing the entries, wait for the background thread to catch up
+        while( head - m_tail.load( std::memory_order_acquire ) == capacity ) {
+            wake_up();
+            std::this_thread::yield();
+        }
+
+        log_event& e = m_events[head & (capacity - 1)];
+
+        e.m_type    = type;
+        e.m_stream  = &os;
+
+        return e;
+    }
+
+    virtual void        publish()
+    {
+        m_head.store( m_head.load( std::memory_order_relaxed ) + 1 );
+
+        // only the idle background thread needs to be woken up
+        if( m_idle )
+            wake_up();
+    }
+
+    void                wake_up()
+    {
+        std::lock_guard<std::mutex> L( m_mutex );
+
+        m_wakeup.notify_one();
+    }
+
+    void                replay_events()
+    {
+        s_log_writer_thread = true;
+
+        std::size_t tail = m_tail.load( std::memory_order_relaxed );
+
+        while( true ) {
+            bool stop = m_stop;
+
+            if( tail != m_head.load() ) {
+                // either the signal handler sees the event is being replayed or this thread sees it took over
+                m_replaying = true;
+                if( m_abandoned ) {
+                    m_replaying = false;
+                    return;
+                }
+
+                replay( m_events[tail & (capacity - 1)] );
+                m_tail.store( ++tail, std::memory_order_release );
+
+                m_replaying = false;
+                continue;
+            }
+
+            if( stop )
+                break;
+
+            std::unique_lock<std::mutex> L( m_mutex );
+
+            m_idle = true;
+            if( tail == m_head.load() && !m_stop )
+                m_wakeup.wait( L );
+            m_idle = false;
+        }
+    }
+
+    void                replay( log_event const& e )
+    {
+        // formatters may report the test case the entry belongs to
+        if( e.m_type == log_event::ENTRY_START || e.m_type == log_event::EXCEPTION_START )
+            framework::impl::set_current_test_case( e.m_curr_test_case );
+
+        replay_log_event( e, *m_formatter, *e.m_stream, m_stream_state_saver.get() );
+    }
+
+    // Data members
+    formatter_ptr const&        m_formatter;
+    saver_ptr const&            m_stream_state_saver;
+    bool                        m_enabled;
+    std::vector<log_event>      m_events;
+    std::atomic<std::size_t>    m_head; // next event to record
+    std::atomic<std::size_t>    m_tail; // next event to replay
+    std::atomic<bool>           m_stop;
+    std::atomic<bool>           m_idle;
+    std::atomic<bool>           m_abandoned;    // the signal handler took over
+    std::atomic<bool>           m_replaying;    // the background thread is replaying an event
+    std::mutex                  m_mutex;
+    std::condition_variable     m_wakeup;
+    std::thread                 m_thread;
+};
+
+#else
+
+// without threads the log is always written synchronously
+class async_log_sink {
+public:
+    async_log_sink( formatter_ptr const&, saver_ptr const& ) {}
+
+    bool                enabled() const                 { return false; }
+    void                enable( bool )                  {}
+    unit_test_log_formatter* recorder()                 { return 0; }
+    void                drain()                         {}
+    void                flush_stream( std::ostream& )   {}
+    void                stop_on_fatal_signal()          {}
+    void                write_on_fatal_signal( fatal_log_writer& ) {}
+};
+
+#endif
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************                flight recorder               ************** //
+// ************************************************************************** //
+
+// test case the log of which is recorded by the flight recorders in this thread, if any
+BOOST_TEST_THREAD_LOCAL test_unit_id s_recorded_test_case = INV_TEST_UNIT_ID;
+
+// Keeps the log of the test cases in progress in memory as log events instead of formatting it. Once the test case is
+// finished, its events are either replayed on the actual formatter or discarded. Only the test case start and the last
+// complete log records fitting into the size limit are kept. The events are reused by the following test cases
+class flight_recorder : public log_event_recorder {
+public:
+    // Constructor
+    flight_recorder() : m_limit( 0 ), m_current( 0 ), m_recording( false ) {}
+
+    void                set_limit( std::size_t limit )  { m_limit = limit; }
+
+    // replays the events recorded for the test case on the formatter and forgets them
+    void                replay( test_unit const& tu, unit_test_log_formatter& f, std::ostream& os,
+                                io_saver_type* stream_state_saver, bool report_dropped )
+    {
+        record* r = find_record( tu.p_id );
+        if( !r )
+            return;
+
+        // formatters may report the test case the entries belong to
+        test_unit_id bkup = framework::impl::exchange_current_test_case( tu.p_id );
+
+        if( r->m_started )
+            replay_log_event( r->m_unit_start, f, os, stream_state_saver );
+
+        if( r->m_dropped != 0 && report_dropped ) {
+            log_entry_data led;
+            led.m_file_name.assign( tu.p_file_name.get().begin(), tu.p_file_name.get().end() );
+            led.m_line_num  = tu.p_line_num;
+            led.m_level     = log_messages;
+
+            if( stream_state_saver )
+                stream_state_saver->restore();
+
+            f.log_entry_start( os, led, BOOST_UTL_ET_MESSAGE );
+            f.log_entry_value( os, (wrap_stringstream().ref() << r->m_dropped
+                                    << " earlier log records of the test case are dropped by the flight recorder").str() );
+            f.log_entry_finish( os );
+        }
+
+        for( std::size_t i = r->m_first; i != r->m_end; ++i )
+            replay_log_event( r->m_events[i], f, os, stream_state_saver );
+
+        framework::impl::exchange_current_test_case( bkup );
+
+        r->reset();
+    }
+
+    // forgets the events recorded for the test case
+    void                discard( test_unit_id tc_id )
+    {
+        if( record* r = find_record( tc_id ) )
+            r->reset();
+    }
+
+    // writes the events recorded for the test case from the signal handler; the event being recorded by the crashed
+    // thread is incomplete, and so is the log record it belongs to
+    void                write_on_fatal_signal( test_unit_id tc_id, fatal_log_writer& w )
+    {
+        record* r = find_record( tc_id );
+        if( !r )
+            return;
+
+        if( r->m_started )
+            w.write_event( r->m_unit_start );
+
+        std::size_t end = r->m_end;
+        if( m_recording ) {
+            while( end != r->m_first && !starts_record( r->m_events[end - 1].m_type ) )
+                --end;
+            if( end != r->m_first )
+                --end;
+        }
+
+        for( std::size_t i = r->m_first; i != end; ++i )
+            w.write_event( r->m_events[i] );
+    }
+
+private:
+    // events recorded for a single test case
+    struct record {
+        record() : m_test_case( INV_TEST_UNIT_ID ) { reset(); }
+
+        void            reset()
+        {
+            m_test_case = INV_TEST_UNIT_ID;
+            m_started   = false;
+            m_first     = m_end = 0;
+            m_size      = 0;
+            m_dropped   = 0;
+        }
+
+        test_unit_id            m_test_case;
+        bool                    m_started;      // the test case start is recorded into m_unit_start
+        log_event               m_unit_start;
+        std::vector<log_event>  m_events;       // [m_first,m_end) are recorded, the rest are kept for reuse
+        std::size_t             m_first;
+        std::size_t             m_end;
+        std::size_t             m_size;         // approximate memory taken by the recorded events
+        counter_t               m_dropped;      // number of log records dropped to fit into the limit
+    };
+
+    virtual log_event&  start_event( log_event::event_type type, std::ostream& os )
+    {
+        record& r = current_record();
+
+        log_event* e = &r.m_unit_start;
+
+        if( type != log_event::UNIT_START || r.m_started || r.m_first != r.m_end ) {
+            if( starts_record( type ) )
+                drop_records( r );
+
+            e = &next_event( r );
+        }
+        else
+            r.m_started = true;
+
+        e->m_type   = type;
+        e->m_stream = &os;
+
+        m_current = e;
+        m_recording = true;
+
+        return *e;
+    }
+
+    virtual void        publish()
+    {
+        current_record().m_size += event_size( *m_current );
+
+        m_recording = false;
+    }
+
+    // the record of the test case being recorded by this thread; the records are shared by the concurrently executed
+    // test cases, but the calls are serialized by the framework mutex
+    record&             current_record()
+    {
+        if( record* r = find_record( s_recorded_test_case ) )
+            return *r;
+
+        record* r = find_record( INV_TEST_UNIT_ID );
+        if( !r ) {
+            m_records.push_back( record() );
+            r = &m_records.back();
+        }
+
+        r->m_test_case = s_recorded_test_case;
+
+        return *r;
+    }
+    record*             find_record( test_unit_id tc_id )
+    {
+        BOOST_TEST_FOREACH( record&, r, m_records ) {
+            if( r.m_test_case == tc_id )
+                return &r;
+        }
+
+        return 0;
+    }
+
+    // drops the oldest complete log records until the recorded events fit into the limit
+    void                drop_records( record& r )
+    {
+        while( r.m_size > m_limit && r.m_first != r.m_end ) {
+            do {
+                r.m_size -= event_size( r.m_events[r.m_first] );
+                ++r.m_first;
+            } while( r.m_first != r.m_end && !starts_record( r.m_events[r.m_first].m_type ) );
+
+            ++r.m_dropped;
+        }
+    }
+    log_event&          next_event( record& r )
+    {
+        // the dropped events are reclaimed once they are the majority
+        if( r.m_end == r.m_events.size() && r.m_first >= r.m_end - r.m_first ) {
+            for( std::size_t i = r.m_first; i != r.m_end; ++i )
+                std::swap( r.m_events[i - r.m_first], r.m_events[i] );
+
+            r.m_end  -= r.m_first;
+            r.m_first = 0;
+        }
+
+        if( r.m_end == r.m_events.size() )
+            r.m_events.push_back( log_event() );
+
+        return r.m_events[r.m_end++];
+    }
+
+    static bool         starts_record( log_event::event_type type )
+    {
+        return type != log_event::EXCEPTION_FINISH && type != log_event::ENTRY_VALUE && type != log_event::ENTRY_FINISH &&
+               type != log_event::CONTEXT_START && type != log_event::CONTEXT_VALUE && type != log_event::CONTEXT_FINISH;
+    }
+    static std::size_t  event_size( log_event const& e )
+    {
+        return sizeof(log_event) + e.m_value.size() + e.m_entry.m_file_name.size() + e.m_checkpoint.m_message.size() +
+               e.m_file_name.size() + e.m_function.size();
+    }
+
+    // Data members
+    std::size_t         m_limit;
+    std::vector<record> m_records;
+    log_event*          m_current;
+    volatile bool       m_recording;    // an event is being recorded
+};
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************                  log buffer                  ************** //
+// ************************************************************************** //
+
+// size of the buffer unless it is specified by the flush policy
+const std::size_t default_log_buffer_size = 0x10000;
+
+// Collects the formatted log in a user-space buffer, which is written into the target stream when the stream is
+// flushed or when the buffer fills up. With FLUSH_BYTES policy the target stream is flushed along with it
+class log_buffer : public std::streambuf {
+public:
+    // Constructor
+    log_buffer( std::ostream& target, std::size_t size, bool flush_when_full )
+    : m_target( target )
+    , m_buffer( (std::max)( size, std::size_t( 1 ) ) )
+    , m_flush_when_full( flush_when_full )
+    {
+        setp( &m_buffer[0], &m_buffer[0] + m_buffer.size() );
+    }
+    ~log_buffer() { write_out(); }
+
+    // writes the buffered content into the target stream without flushing it
+    void                write_out()
+    {
+        if( pptr() == pbase() )
+            return;
+
+        m_target.write( pbase(), pptr() - pbase() );
+        setp( pbase(), epptr() );
+    }
+
+protected:
+    virtual int_type    overflow( int_type c )
+    {
+        spill();
+
+        if( !traits_type::eq_int_type( c, traits_type::eof() ) ) {
+            *pptr() = traits_type::to_char_type( c );
+            pbump( 1 );
+        }
+
+        return traits_type::not_eof( c );
+    }
+    virtual std::streamsize xsputn( char const* s, std::streamsize n )
+    {
+        if( n > epptr() - pptr() ) {
+            spill();
+
+            // does not fit into the buffer anyway
+            if( n >= epptr() - pbase() ) {
+                m_target.write( s, n );
+                return n;
+            }
+        }
+
+        std::memcpy( pptr(), s, static_cast<std::size_t>( n ) );
+        pbump( static_cast<int>( n ) );
+
+        return n;
+    }
+    virtual int         sync()
+    {
+        write_out();
+        m_target.flush();
+
+        return 0;
+    }
+
+private:
+    void                spill()
+    {
+        write_out();
+
+        if( m_flush_when_full )
+            m_target.flush();
+    }
+
+    // Data members
+    std::ostream&       m_target;
+    std::vector<char>   m_buffer;
+    bool                m_flush_when_full;
+};
+
+//____________________________________________________________________________//
+
+// Stream formatters write into: the log buffer over the sink stream
+struct buffered_stream {
+    buffered_stream( std::ostream& target, flush_mode mode, std::size_t buffer_size )
+    : m_buffer( target, mode == FLUSH_BYTES ? buffer_size : default_log_buffer_size, mode == FLUSH_BYTES )
+    , m_stream( &m_buffer )
+    {
+        m_stream.copyfmt( target );
+    }
+
+    log_buffer          m_buffer;
+    std::ostream        m_stream;
+};
+
+//____________________________________________________________________________//
+
+// Stream the log entries of a single format are written into, along with the threshold level of these entries
+struct log_sink {
+    // Constructor
+    log_sink( output_format format, std::ostream& stream, log_level threshold_level, flush_mode mode, std::size_t buffer_size )
+    : m_format( format )
+    , m_stream( &stream )
+    , m_flush_mode( mode )
+    , m_buffer_size( buffer_size )
+    , m_buffered( new buffered_stream( stream, mode, buffer_size ) )
+    , m_stream_state_saver( new io_saver_type( m_buffered->m_stream ) )
+    , m_threshold_level( threshold_level )
+    , m_log_formatter( make_formatter( format ) )
+    , m_async_sink( m_log_formatter, m_stream_state_saver )
+    , m_entry_in_progress( false )
+    , m_fd( stream_descriptor( stream ) )
+    {
+    }
+
+    // file descriptor the stream is written into, if known
+    static int          stream_descriptor( std::ostream& str )
+    {
+        if( &str == &std::cout )
+            return 1;
+
+        if( &str == &std::cerr || &str == &std::clog )
+            return 2;
+
+        return runtime_config::log_file_descriptor( &str );
+    }
+
+    static unit_test_log_formatter* make_formatter( output_format format )
+    {
+        switch( format ) {
+        default:
+        case OF_CLF:
+            return new output::compiler_log_formatter;
+        case OF_XML:
+            return new output::xml_log_formatter;
+        case OF_BIN:
+            return new output::binary_log_formatter;
+        case OF_JSON:
+            return new output::json_log_formatter;
+        }
+    }
+
+    // points in the log the stream may be flushed at
+    enum flush_point { RECORD_END, UNIT_END };
+
+    // sink data
+    output_format       m_format;
+    std::ostream*       m_stream;
+    flush_mode          m_flush_mode;
+    std::size_t         m_buffer_size;
+    scoped_ptr<buffered_stream> m_buffered;
+    saver_ptr           m_stream_state_saver;
+    log_level           m_threshold_level;
+    formatter_ptr       m_log_formatter;
+    async_log_sink      m_async_sink;
+    flight_recorder     m_flight_recorder;
+
+    // is the current entry written into this sink?
+    bool                m_entry_in_progress;
+
+    // file descriptor of the stream, -1 if unknown
+    int                 m_fd;
+
+    // helper functions
+    std::ostream&       stream()            { return m_buffered->m_stream; }
+    unit_test_log_formatter* formatter()    { return s_recorded_test_case != INV_TEST_UNIT_ID ? &m_flight_recorder : writer(); }
+    unit_test_log_formatter* writer()       { return m_async_sink.enabled() ? m_async_sink.recorder() : m_log_formatter.get(); }
+    void                flush()
+    {
+        m_async_sink.drain();
+
+        stream().flush();
+    }
+    // flushes the stream if the flush policy asks for it at this point
+    void                flush_at( flush_point fp )
+    {
+        // nothing is written while the log is recorded
+        if( s_recorded_test_case != INV_TEST_UNIT_ID )
+            return;
+
+        if( m_flush_mode != FLUSH_LINE && (m_flush_mode != FLUSH_UNIT || fp != UNIT_END) )
+            return;
+
+        if( m_async_sink.enabled() )
+            m_async_sink.flush_stream( stream() );
+        else
+            stream().flush();
+    }
+    void                set_stream( std::ostream& str )
+    {
+        // the entries queued so far belong to the previous stream
+        flush();
+
+        m_stream = &str;
+        m_fd     = stream_descriptor( str );
+        reset_buffer();
+    }
+    void                set_flush_policy( flush_mode mode, std::size_t buffer_size )
+    {
+        flush();
+
+        m_flush_mode    = mode;
+        m_buffer_size   = buffer_size;
+        reset_buffer();
+    }
+    // writes out the log recorded for the finished test case, or drops it
+    void                finish_recording( test_unit const& tu, bool write_out )
+    {
+        if( !write_out ) {
+            m_flight_recorder.discard( tu.p_id );
+            return;
+        }
+
+        // with the asynchronous sink the stream is restored by the background thread
+        m_flight_recorder.replay( tu, *writer(), stream(), m_async_sink.enabled() ? 0 : m_stream_state_saver.get(),
+                                  m_threshold_level <= log_messages );
+    }
+    // writes the log kept in memory from the signal handler: the content buffered by the stream, the one of the log
+    // buffer, the events queued for the background thread and the log recorded for the crashed test case, in this order
+    void                write_on_fatal_signal( test_unit_id recorded_test_case )
+    {
+        // the binary log can not be written as plain text
+        if( m_fd < 0 || m_format == OF_BIN )
+            return;
 
-    return *this;
-}
+        fatal_log_writer w( m_fd );
 
-//____________________________________________________________________________//
+        m_async_sink.stop_on_fatal_signal();
 
-entry_value_collector::~entry_value_collector()
-{
-    if( m_last )
-        unit_test_log << log::end();
-}
+        w.write_pending( m_stream->rdbuf() );
+        w.write_pending( &m_buffered->m_buffer );
+        m_async_sink.write_on_fatal_signal( w );
 
-//____________________________________________________________________________//
+        if( recorded_test_case != INV_TEST_UNIT_ID )
+            m_flight_recorder.write_on_fatal_signal( recorded_test_case, w );
+    }
+    void                reset_buffer()
+    {
+        // the new stream is created before the old one is released, so that formatters can tell them apart
+        scoped_ptr<buffered_stream> fresh( new buffered_stream( *m_stream, m_flush_mode, m_buffer_size ) );
 
-} // namespace ut_detail
+        m_buffered.swap( fresh );
+        m_stream_state_saver.reset( new io_saver_type( stream() ) );
+    }
+};
 
-// ************************************************************************** //
-// **************                 unit_test_log                ************** //
-// ************************************************************************** //
+typedef shared_ptr<log_sink> log_sink_ptr;
 
-namespace {
+//____________________________________________________________________________//
 
 struct unit_test_log_impl {
     // Constructor
     unit_test_log_impl()
-    : m_stream( runtime_config::log_sink() )
-    , m_stream_state_saver( new io_saver_type( *m_stream ) )
-    , m_threshold_level( log_all_errors )
-    , m_log_formatter( new output::compiler_log_formatter )
+    : m_lowest_level( log_all_errors )
+    , m_async( false )
+    , m_flush_mode( FLUSH_LINE )
+    , m_buffer_size( 0 )
+    , m_recorder_limit( 0 )
+    , m_entry_in_progress( false )
+    , m_entry_sinks( 0 )
     {
+        m_sinks.push_back( log_sink_ptr( new log_sink( OF_CLF, *runtime_config::log_sink(), log_all_errors, m_flush_mode, m_buffer_size ) ) );
     }
 
     // log data
-    typedef scoped_ptr<unit_test_log_formatter> formatter_ptr;
-    typedef scoped_ptr<io_saver_type>           saver_ptr;
-
-    std::ostream*       m_stream;
-    saver_ptr           m_stream_state_saver;
-    log_level           m_threshold_level;
-    formatter_ptr       m_log_formatter;
+    std::vector<log_sink_ptr> m_sinks;
+    log_level           m_lowest_level;
+    bool                m_async;
+    flush_mode          m_flush_mode;
+    std::size_t         m_buffer_size;
+    std::size_t         m_recorder_limit;
 
     // entry data
     bool                m_entry_in_progress;
     bool                m_entry_started;
+    std::size_t         m_entry_sinks;
     log_entry_data      m_entry_data;
 
-    // check point data
-    log_checkpoint_data m_checkpoint_data;
-
     // helper functions
-    std::ostream&       stream()            { return *m_stream; }
-    void                set_checkpoint( const_string file, std::size_t line_num, const_string msg )
+    log_sink*           find_sink( output_format format )
+    {
+        BOOST_TEST_FOREACH( log_sink_ptr const&, sink, m_sinks ) {
+            if( sink->m_format == format )
+                return sink.get();
+        }
+
+        return 0;
+    }
+    // the entries below the lowest threshold are dropped without looking at the sinks
+    void                update_lowest_level()
     {
-        assign_op( m_checkpoint_data.m_message, msg, 0 );
-        m_checkpoint_data.m_file_name    = file;
-        m_checkpoint_data.m_line_num    = line_num;
+        m_lowest_level = log_nothing;
+
+        BOOST_TEST_FOREACH( log_sink_ptr const&, sink, m_sinks )
+            m_lowest_level = (std::min)( m_lowest_level, sink->m_threshold_level );
     }
 };
 
 unit_test_log_impl& s_log_impl() { static unit_test_log_impl the_inst; return the_inst; }
 
+//____________________________________________________________________________//
+
+// the log kept in memory, including the one recorded for the crashed test case, is written out before the process is
+// terminated by a signal. This is called from the signal handler, possibly interrupting the logger itself, so the sinks
+// write it with async-signal-safe functions only; the sinks with unknown file descriptors are left alone
+void
+flush_on_fatal_signal()
+{
+    std::vector<log_sink_ptr> const& sinks = s_log_impl().m_sinks;
+
+    for( std::size_t i = 0; i != sinks.size(); ++i )
+        sinks[i]->write_on_fatal_signal( s_recorded_test_case );
+}
+
+//____________________________________________________________________________//
+
+// check point of the test case executed by this thread; the passpoint set by every assertion only records
+// the location, the message of the previous checkpoint is dropped once the check point is reported
+BOOST_TEST_THREAD_LOCAL log_checkpoint_data s_checkpoint_data;
+BOOST_TEST_THREAD_LOCAL bool                s_checkpoint_has_message = false;
+
+// the entry is only started once a value passes the threshold level; until then
+// nothing but its location and level is recorded
+BOOST_TEST_THREAD_LOCAL char const* s_pending_file_name = 0;
+BOOST_TEST_THREAD_LOCAL std::size_t s_pending_file_name_len = 0;
+BOOST_TEST_THREAD_LOCAL std::size_t s_pending_line_num = 0;
+BOOST_TEST_THREAD_LOCAL log_level   s_pending_level = invalid_log_level;
+
+// log entries of the test cases executed concurrently are written one at a time
+BOOST_TEST_THREAD_LOCAL bool s_entry_locked = false;
+
+void
+lock_entry()
+{
+    if( !s_entry_locked ) {
+        ut_detail::framework_mutex().lock();
+        s_entry_locked = true;
+    }
+}
+
+//____________________________________________________________________________//
+
+void
+unlock_entry()
+{
+    if( s_entry_locked ) {
+        s_entry_locked = false;
+        ut_detail::framework_mutex().unlock();
+    }
+}
+
+//____________________________________________________________________________//
+
+void
+log_entry_context( log_sink& sink, log_level l )
+{
+    framework::context_generator const& context = framework::get_context();
+    if( context.is_empty() )
+        return;
+
+    const_string frame;
+
+    sink.formatter()->entry_context_start( sink.stream(), l );
+
+    while( !(frame=context.next()).is_empty() )
+        sink.formatter()->log_entry_context( sink.stream(), frame );
+
+    sink.formatter()->entry_context_finish( sink.stream() );
+}
+
 } // local namespace
 
 //____________________________________________________________________________//
@@ -128,15 +1217,23 @@ unit_test_log_impl& s_log_impl() { static unit_test_log_impl the_inst; return th
 void
 unit_test_log_t::test_start( counter_t test_cases_amount )
 {
-    if( s_log_impl().m_threshold_level == log_nothing )
-        return;
+    BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks ) {
+        if( sink->m_threshold_level == log_nothing )
+            continue;
+
+        sink->formatter()->log_start( sink->stream(), test_cases_amount );
 
-    s_log_impl().m_log_formatter->log_start( s_log_impl().stream(), test_cases_amount );
+        if( runtime_config::show_build_info() )
+            sink->formatter()->log_build_info( sink->stream() );
 
-    if( runtime_config::show_build_info() )
-        s_log_impl().m_log_formatter->log_build_info( s_log_impl().stream() );
+        sink->flush_at( log_sink::RECORD_END );
+
+        sink->m_entry_in_progress = false;
+    }
 
     s_log_impl().m_entry_in_progress = false;
+
+    execution_monitor::set_fatal_signal_hook( &flush_on_fatal_signal );
 }
 
 //____________________________________________________________________________//
@@ -144,12 +1241,14 @@ unit_test_log_t::test_start( counter_t test_cases_amount )
 void
 unit_test_log_t::test_finish()
 {
-    if( s_log_impl().m_threshold_level == log_nothing )
-        return;
+    BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks ) {
+        if( sink->m_threshold_level == log_nothing )
+            continue;
 
-    s_log_impl().m_log_formatter->log_finish( s_log_impl().stream() );
+        sink->formatter()->log_finish( sink->stream() );
+    }
 
-    s_log_impl().stream().flush();
+    flush();
 }
 
 //____________________________________________________________________________//
@@ -158,6 +1257,8 @@ void
 unit_test_log_t::test_aborted()
 {
     BOOST_TEST_LOG_ENTRY( log_messages ) << "Test is aborted";
+
+    flush();
 }
 
 //____________________________________________________________________________//
@@ -165,13 +1266,23 @@ unit_test_log_t::test_aborted()
 void
 unit_test_log_t::test_unit_start( test_unit const& tu )
 {
-    if( s_log_impl().m_threshold_level > log_test_units )
-        return;
-
-    if( s_log_impl().m_entry_in_progress )
+    if( s_log_impl().m_entry_in_progress && s_log_impl().m_lowest_level <= log_test_units )
         *this << log::end();
 
-    s_log_impl().m_log_formatter->test_unit_start( s_log_impl().stream(), tu );
+    // the log of the test case is kept aside until it is known whether the test case passed; the log of the test
+    // cases run from within the test case belongs to it
+    if( tu.p_type == TUT_CASE && s_log_impl().m_recorder_limit != 0 && s_recorded_test_case == INV_TEST_UNIT_ID )
+        s_recorded_test_case = tu.p_id;
+
+    if( s_log_impl().m_lowest_level > log_test_units )
+        return;
+
+    BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks ) {
+        if( sink->m_threshold_level <= log_test_units ) {
+            sink->formatter()->test_unit_start( sink->stream(), tu );
+            sink->flush_at( log_sink::UNIT_END );
+        }
+    }
 }
 
 //____________________________________________________________________________//
@@ -179,15 +1290,47 @@ unit_test_log_t::test_unit_start( test_unit const& tu )
 void
 unit_test_log_t::test_unit_finish( test_unit const& tu, unsigned long elapsed )
 {
-    if( s_log_impl().m_threshold_level > log_test_units )
-        return;
+    elapsed_time et;
+    et.wall = static_cast<elapsed_time::nanoseconds>( elapsed ) * 1000;
 
-    s_log_impl().m_checkpoint_data.clear();
+    test_unit_finish( tu, et );
+}
 
-    if( s_log_impl().m_entry_in_progress )
+//____________________________________________________________________________//
+
+void
+unit_test_log_t::test_unit_finish( test_unit const& tu, elapsed_time const& elapsed )
+{
+    // finish the entry interrupted by an exception
+    if( s_entry_locked )
         *this << log::end();
 
-    s_log_impl().m_log_formatter->test_unit_finish( s_log_impl().stream(), tu, elapsed );
+    // the recorded log of the failed test case is written out, while the log of the passed one is dropped along
+    // with its finish
+    if( tu.p_id == s_recorded_test_case ) {
+        s_recorded_test_case = INV_TEST_UNIT_ID;
+
+        bool failed = !results_collector.results( tu.p_id ).passed();
+
+        BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks )
+            sink->finish_recording( tu, failed );
+
+        if( !failed )
+            return;
+    }
+
+    if( s_log_impl().m_lowest_level > log_test_units )
+        return;
+
+    s_checkpoint_data.clear();
+    s_checkpoint_has_message = false;
+
+    BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks ) {
+        if( sink->m_threshold_level <= log_test_units ) {
+            sink->formatter()->test_unit_finish( sink->stream(), tu, elapsed );
+            sink->flush_at( log_sink::UNIT_END );
+        }
+    }
 }
 
 //____________________________________________________________________________//
@@ -195,13 +1338,18 @@ unit_test_log_t::test_unit_finish( test_unit const& tu, unsigned long elapsed )
 void
 unit_test_log_t::test_unit_skipped( test_unit const& tu, const_string reason )
 {
-    if( s_log_impl().m_threshold_level > log_test_units )
+    if( s_log_impl().m_lowest_level > log_test_units )
         return;
 
     if( s_log_impl().m_entry_in_progress )
         *this << log::end();
 
-    s_log_impl().m_log_formatter->test_unit_skipped( s_log_impl().stream(), tu, reason );
+    BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks ) {
+        if( sink->m_threshold_level <= log_test_units ) {
+            sink->formatter()->test_unit_skipped( sink->stream(), tu, reason );
+            sink->flush_at( log_sink::UNIT_END );
+        }
+    }
 }
 
 //____________________________________________________________________________//
@@ -214,18 +1362,31 @@ unit_test_log_t::exception_caught( execution_exception const& ex )
         (ex.code() <= execution_exception::timeout_error        ? log_system_errors
                                                                 : log_fatal_errors );
 
-    if( l >= s_log_impl().m_threshold_level ) {
+    if( l >= s_log_impl().m_lowest_level ) {
         if( s_log_impl().m_entry_in_progress )
             *this << log::end();
 
-        s_log_impl().m_log_formatter->log_exception_start( s_log_impl().stream(), s_log_impl().m_checkpoint_data, ex );
+        BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks ) {
+            if( l < sink->m_threshold_level )
+                continue;
+
+            if( !s_checkpoint_has_message )
+                s_checkpoint_data.m_message.clear();
+
+            sink->formatter()->log_exception_start( sink->stream(), s_checkpoint_data, ex );
 
-        log_entry_context( l );
+            log_entry_context( *sink, l );
 
-        s_log_impl().m_log_formatter->log_exception_finish( s_log_impl().stream() );
+            sink->formatter()->log_exception_finish( sink->stream() );
+            sink->flush_at( log_sink::RECORD_END );
+        }
     }
 
     clear_entry_context();
+
+    // the process may not survive the fatal error, so the queued and buffered entries are written out right away
+    if( l == log_fatal_errors )
+        flush();
 }
 
 //____________________________________________________________________________//
@@ -233,7 +1394,12 @@ unit_test_log_t::exception_caught( execution_exception const& ex )
 void
 unit_test_log_t::set_checkpoint( const_string file, std::size_t line_num, const_string msg )
 {
-    s_log_impl().set_checkpoint( file, line_num, msg );
+    s_checkpoint_data.m_file_name   = file;
+    s_checkpoint_data.m_line_num    = line_num;
+
+    s_checkpoint_has_message = !msg.empty();
+    if( s_checkpoint_has_message )
+        assign_op( s_checkpoint_data.m_message, msg, 0 );
 }
 
 //____________________________________________________________________________//
@@ -247,21 +1413,14 @@ set_unix_slash( char in )
 unit_test_log_t&
 unit_test_log_t::operator<<( log::begin const& b )
 {
-    if( s_log_impl().m_entry_in_progress )
+    if( s_entry_locked )
         *this << log::end();
 
-    s_log_impl().m_stream_state_saver->restore();
-
-    s_log_impl().m_entry_data.clear();
-
-    assign_op( s_log_impl().m_entry_data.m_file_name, b.m_file_name, 0 );
-
-    // normalize file name
-    std::transform( s_log_impl().m_entry_data.m_file_name.begin(), s_log_impl().m_entry_data.m_file_name.end(),
-                    s_log_impl().m_entry_data.m_file_name.begin(),
-                    &set_unix_slash );
-
-    s_log_impl().m_entry_data.m_line_num = b.m_line_num;
+    s_pending_file_name     = b.m_file_name.begin();
+    s_pending_file_name_len = b.m_file_name.size();
+    s_pending_line_num      = b.m_line_num;
+    // an entry without the level is not written
+    s_pending_level         = invalid_log_level;
 
     return *this;
 }
@@ -271,16 +1430,26 @@ unit_test_log_t::operator<<( log::begin const& b )
 unit_test_log_t&
 unit_test_log_t::operator<<( log::end const& )
 {
-    if( s_log_impl().m_entry_in_progress ) {
-        log_entry_context( s_log_impl().m_entry_data.m_level );
+    if( s_entry_locked && s_log_impl().m_entry_in_progress ) {
+        BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks ) {
+            if( !sink->m_entry_in_progress )
+                continue;
 
-        s_log_impl().m_log_formatter->log_entry_finish( s_log_impl().stream() );
+            log_entry_context( *sink, s_log_impl().m_entry_data.m_level );
+
+            sink->formatter()->log_entry_finish( sink->stream() );
+            sink->flush_at( log_sink::RECORD_END );
+
+            sink->m_entry_in_progress = false;
+        }
 
         s_log_impl().m_entry_in_progress = false;
     }
 
     clear_entry_context();
 
+    unlock_entry();
+
     return *this;
 }
 
@@ -289,7 +1458,7 @@ unit_test_log_t::operator<<( log::end const& )
 unit_test_log_t&
 unit_test_log_t::operator<<( log_level l )
 {
-    s_log_impl().m_entry_data.m_level = l;
+    s_pending_level = l;
 
     return *this;
 }
@@ -309,38 +1478,54 @@ unit_test_log_t::operator()( log_level l )
 bool
 unit_test_log_t::log_entry_start()
 {
-    if( s_log_impl().m_entry_in_progress )
+    if( s_entry_locked && s_log_impl().m_entry_in_progress )
         return true;
 
-    switch( s_log_impl().m_entry_data.m_level ) {
-    case log_successful_tests:
-        s_log_impl().m_log_formatter->log_entry_start( s_log_impl().stream(), s_log_impl().m_entry_data,
-                                                       unit_test_log_formatter::BOOST_UTL_ET_INFO );
-        break;
-    case log_messages:
-        s_log_impl().m_log_formatter->log_entry_start( s_log_impl().stream(), s_log_impl().m_entry_data,
-                                                       unit_test_log_formatter::BOOST_UTL_ET_MESSAGE );
-        break;
-    case log_warnings:
-        s_log_impl().m_log_formatter->log_entry_start( s_log_impl().stream(), s_log_impl().m_entry_data,
-                                                       unit_test_log_formatter::BOOST_UTL_ET_WARNING );
-        break;
+    unit_test_log_formatter::log_entry_types let;
+
+    switch( s_pending_level ) {
+    case log_successful_tests:      let = unit_test_log_formatter::BOOST_UTL_ET_INFO; break;
+    case log_messages:              let = unit_test_log_formatter::BOOST_UTL_ET_MESSAGE; break;
+    case log_warnings:              let = unit_test_log_formatter::BOOST_UTL_ET_WARNING; break;
     case log_all_errors:
     case log_cpp_exception_errors:
-    case log_system_errors:
-        s_log_impl().m_log_formatter->log_entry_start( s_log_impl().stream(), s_log_impl().m_entry_data,
-                                                       unit_test_log_formatter::BOOST_UTL_ET_ERROR );
-        break;
-    case log_fatal_errors:
-        s_log_impl().m_log_formatter->log_entry_start( s_log_impl().stream(), s_log_impl().m_entry_data,
-                                                       unit_test_log_formatter::BOOST_UTL_ET_FATAL_ERROR );
-        break;
-    case log_nothing:
-    case log_test_units:
-    case invalid_log_level:
+    case log_system_errors:         let = unit_test_log_formatter::BOOST_UTL_ET_ERROR; break;
+    case log_fatal_errors:          let = unit_test_log_formatter::BOOST_UTL_ET_FATAL_ERROR; break;
+    default:
         return false;
     }
 
+    lock_entry();
+
+    s_log_impl().m_entry_data.clear();
+
+    s_log_impl().m_entry_data.m_file_name.assign( s_pending_file_name, s_pending_file_name_len );
+
+    // normalize file name
+    std::transform( s_log_impl().m_entry_data.m_file_name.begin(), s_log_impl().m_entry_data.m_file_name.end(),
+                    s_log_impl().m_entry_data.m_file_name.begin(),
+                    &set_unix_slash );
+
+    s_log_impl().m_entry_data.m_line_num    = s_pending_line_num;
+    s_log_impl().m_entry_data.m_level       = s_pending_level;
+
+    // the entry is written only into the sinks with the threshold level at or below the entry level
+    s_log_impl().m_entry_sinks = 0;
+
+    BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks ) {
+        if( s_pending_level < sink->m_threshold_level )
+            continue;
+
+        // with the asynchronous sink the stream is restored by the background thread
+        if( !sink->m_async_sink.enabled() )
+            sink->m_stream_state_saver->restore();
+
+        sink->formatter()->log_entry_start( sink->stream(), s_log_impl().m_entry_data, let );
+
+        sink->m_entry_in_progress = true;
+        ++s_log_impl().m_entry_sinks;
+    }
+
     s_log_impl().m_entry_in_progress = true;
 
     return true;
@@ -351,8 +1536,12 @@ unit_test_log_t::log_entry_start()
 unit_test_log_t&
 unit_test_log_t::operator<<( const_string value )
 {
-    if( s_log_impl().m_entry_data.m_level >= s_log_impl().m_threshold_level && !value.empty() && log_entry_start() )
-        s_log_impl().m_log_formatter->log_entry_value( s_log_impl().stream(), value );
+    if( s_pending_level >= s_log_impl().m_lowest_level && !value.empty() && log_entry_start() ) {
+        BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks ) {
+            if( sink->m_entry_in_progress )
+                sink->formatter()->log_entry_value( sink->stream(), value );
+        }
+    }
 
     return *this;
 }
@@ -362,8 +1551,16 @@ unit_test_log_t::operator<<( const_string value )
 unit_test_log_t&
 unit_test_log_t::operator<<( lazy_ostream const& value )
 {
-    if( s_log_impl().m_entry_data.m_level >= s_log_impl().m_threshold_level && !value.empty() && log_entry_start() )
-        s_log_impl().m_log_formatter->log_entry_value( s_log_impl().stream(), value );
+    if( s_pending_level >= s_log_impl().m_lowest_level && !value.empty() && log_entry_start() ) {
+        // the value is evaluated once, whatever the number of sinks
+        if( s_log_impl().m_entry_sinks > 1 )
+            return *this << const_string( (wrap_stringstream().ref() << value).str() );
+
+        BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks ) {
+            if( sink->m_entry_in_progress )
+                sink->formatter()->log_entry_value( sink->stream(), value );
+        }
+    }
 
     return *this;
 }
@@ -371,28 +1568,48 @@ unit_test_log_t::operator<<( lazy_ostream const& value )
 //____________________________________________________________________________//
 
 void
-unit_test_log_t::log_entry_context( log_level l )
+unit_test_log_t::clear_entry_context()
 {
-    framework::context_generator const& context = framework::get_context();
-    if( context.is_empty() )
-        return;
+    framework::clear_context();
+}
 
-    const_string frame;
+//____________________________________________________________________________//
 
-    s_log_impl().m_log_formatter->entry_context_start( s_log_impl().stream(), l );
+std::vector<output_format>
+unit_test_log_t::formats() const
+{
+    std::vector<output_format> res;
 
-    while( !(frame=context.next()).is_empty() )
-        s_log_impl().m_log_formatter->log_entry_context( s_log_impl().stream(), frame );
+    BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks )
+        res.push_back( sink->m_format );
 
-    s_log_impl().m_log_formatter->entry_context_finish( s_log_impl().stream() );
+    return res;
 }
 
 //____________________________________________________________________________//
 
 void
-unit_test_log_t::clear_entry_context()
+unit_test_log_t::append( output_format format, const_string content )
 {
-    framework::clear_context();
+    if( s_log_impl().m_entry_in_progress )
+        *this << log::end();
+
+    log_sink* sink = s_log_impl().find_sink( format );
+    if( !sink )
+        return;
+
+    // the content is the log of whole test units
+    sink->formatter()->log_content( sink->stream(), content );
+    sink->flush_at( log_sink::UNIT_END );
+}
+
+//____________________________________________________________________________//
+
+void
+unit_test_log_t::flush()
+{
+    BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks )
+        sink->flush();
 }
 
 //____________________________________________________________________________//
@@ -403,8 +1620,21 @@ unit_test_log_t::set_stream( std::ostream& str )
     if( s_log_impl().m_entry_in_progress )
         return;
 
-    s_log_impl().m_stream = &str;
-    s_log_impl().m_stream_state_saver.reset( new io_saver_type( str ) );
+    BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks )
+        sink->set_stream( str );
+}
+
+//____________________________________________________________________________//
+
+void
+unit_test_log_t::set_stream( output_format format, std::ostream& str )
+{
+    if( s_log_impl().m_entry_in_progress )
+        return;
+
+    log_sink* sink = s_log_impl().find_sink( format );
+    if( sink )
+        sink->set_stream( str );
 }
 
 //____________________________________________________________________________//
@@ -415,7 +1645,35 @@ unit_test_log_t::set_threshold_level( log_level lev )
     if( s_log_impl().m_entry_in_progress || lev == invalid_log_level )
         return;
 
-    s_log_impl().m_threshold_level = lev;
+    BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks )
+        sink->m_threshold_level = lev;
+
+    s_log_impl().update_lowest_level();
+}
+
+//____________________________________________________________________________//
+
+void
+unit_test_log_t::set_threshold_level( output_format format, log_level lev )
+{
+    if( s_log_impl().m_entry_in_progress || lev == invalid_log_level )
+        return;
+
+    log_sink* sink = s_log_impl().find_sink( format );
+    if( !sink )
+        return;
+
+    sink->m_threshold_level = lev;
+
+    s_log_impl().update_lowest_level();
+}
+
+//____________________________________________________________________________//
+
+log_level
+unit_test_log_t::threshold_level() const
+{
+    return s_log_impl().m_lowest_level;
 }
 
 //____________________________________________________________________________//
@@ -426,15 +1684,10 @@ unit_test_log_t::set_format( output_format log_format )
     if( s_log_impl().m_entry_in_progress )
         return;
 
-    switch( log_format ) {
-    default:
-    case OF_CLF:
-        set_formatter( new output::compiler_log_formatter );
-        break;
-    case OF_XML:
-        set_formatter( new output::xml_log_formatter );
-        break;
-    }
+    log_sink& first = *s_log_impl().m_sinks.front();
+
+    first.m_format = log_format;
+    set_formatter( log_sink::make_formatter( log_format ) );
 }
 
 //____________________________________________________________________________//
@@ -442,7 +1695,76 @@ unit_test_log_t::set_format( output_format log_format )
 void
 unit_test_log_t::set_formatter( unit_test_log_formatter* the_formatter )
 {
-    s_log_impl().m_log_formatter.reset( the_formatter );
+    std::vector<log_sink_ptr>& sinks = s_log_impl().m_sinks;
+
+    BOOST_TEST_FOREACH( log_sink_ptr const&, sink, sinks )
+        sink->m_async_sink.drain();
+
+    sinks.erase( sinks.begin() + 1, sinks.end() );
+    sinks.front()->m_log_formatter.reset( the_formatter );
+
+    s_log_impl().update_lowest_level();
+}
+
+//____________________________________________________________________________//
+
+void
+unit_test_log_t::add_format( output_format log_format )
+{
+    if( s_log_impl().m_entry_in_progress || s_log_impl().find_sink( log_format ) )
+        return;
+
+    log_sink_ptr sink( new log_sink( log_format, *runtime_config::log_sink(), log_all_errors,
+                                     s_log_impl().m_flush_mode, s_log_impl().m_buffer_size ) );
+    sink->m_async_sink.enable( s_log_impl().m_async );
+    sink->m_flight_recorder.set_limit( s_log_impl().m_recorder_limit );
+
+    s_log_impl().m_sinks.push_back( sink );
+
+    s_log_impl().update_lowest_level();
+}
+
+//____________________________________________________________________________//
+
+void
+unit_test_log_t::set_async( bool async )
+{
+    if( s_log_impl().m_entry_in_progress )
+        return;
+
+    s_log_impl().m_async = async;
+
+    BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks )
+        sink->m_async_sink.enable( async );
+}
+
+//____________________________________________________________________________//
+
+void
+unit_test_log_t::set_flush_policy( flush_mode mode, std::size_t buffer_size )
+{
+    if( s_log_impl().m_entry_in_progress )
+        return;
+
+    s_log_impl().m_flush_mode   = mode;
+    s_log_impl().m_buffer_size  = buffer_size;
+
+    BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks )
+        sink->set_flush_policy( mode, buffer_size );
+}
+
+//____________________________________________________________________________//
+
+void
+unit_test_log_t::set_flight_recorder( std::size_t limit )
+{
+    if( s_log_impl().m_entry_in_progress || s_recorded_test_case != INV_TEST_UNIT_ID )
+        return;
+
+    s_log_impl().m_recorder_limit = limit;
+
+    BOOST_TEST_FOREACH( log_sink_ptr const&, sink, s_log_impl().m_sinks )
+        sink->m_flight_recorder.set_limit( limit );
 }
 
 //____________________________________________________________________________//
@@ -459,6 +1781,14 @@ unit_test_log_formatter::log_entry_value( std::ostream& ostr, lazy_ostream const
 
 //____________________________________________________________________________//
 
+void
+unit_test_log_formatter::log_content( std::ostream& ostr, const_string content )
+{
+    ostr.write( content.begin(), static_cast<std::streamsize>( content.size() ) );
+}
+
+//____________________________________________________________________________//
+
 } // namespace unit_test
 } // namespace boost
 
@@ -36,14 +36,51 @@ namespace unit_test {
 unit_test_monitor_t::error_level
 unit_test_monitor_t::execute_and_translate( boost::function<void ()> const& func, unsigned timeout )
 {
-    BOOST_TEST_IMPL_TRY {
-        p_catch_system_errors.value     = runtime_config::catch_sys_errors();
-        p_timeout.value                 = timeout;
-        p_auto_start_dbg.value          = runtime_config::auto_start_dbg();
-        p_use_alt_stack.value           = runtime_config::use_alt_stack();
-        p_detect_fp_exceptions.value    = runtime_config::detect_fp_exceptions();
+    return execute_and_translate_ms( func, boost::detail::timeout_in_ms( timeout ) );
+}
+
+//____________________________________________________________________________//
+
+unit_test_monitor_t::error_level
+unit_test_monitor_t::execute_and_translate_ms( boost::function<void ()> const& func, unsigned timeout_ms )
+{
+    if( !in_session() )
+        configure();
+
+    p_timeout.value                 = 0;
+    p_timeout_ms.value              = timeout_ms;
+
+    return execute_and_translate( *this, func );
+}
+
+//____________________________________________________________________________//
+
+void
+unit_test_monitor_t::start_session()
+{
+    configure();
+
+    execution_monitor::start_session();
+}
 
-        vexecute( func );
+//____________________________________________________________________________//
+
+void
+unit_test_monitor_t::configure()
+{
+    p_catch_system_errors.value     = runtime_config::catch_sys_errors();
+    p_auto_start_dbg.value          = runtime_config::auto_start_dbg();
+    p_use_alt_stack.value           = runtime_config::use_alt_stack();
+    p_detect_fp_exceptions.value    = runtime_config::detect_fp_exceptions();
+}
+
+//____________________________________________________________________________//
+
+unit_test_monitor_t::error_level
+unit_test_monitor_t::execute_and_translate( execution_monitor& em, boost::function<void ()> const& func )
+{
+    BOOST_TEST_IMPL_TRY {
+        em.vexecute( func );
     }
     BOOST_TEST_IMPL_CATCH( execution_exception, ex ) {
         framework::exception_caught( ex );
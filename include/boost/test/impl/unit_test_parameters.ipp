@@ -24,6 +24,7 @@
 #include <boost/test/utils/basic_cstring/compare.hpp>
 #include <boost/test/utils/basic_cstring/io.hpp>
 #include <boost/test/utils/fixed_mapping.hpp>
+#include <boost/test/utils/foreach.hpp>
 #include <boost/test/debug.hpp>
 #include <boost/test/framework.hpp>
 
@@ -46,6 +47,7 @@ namespace env = rt::env;
 #include <boost/config.hpp>
 #include <boost/test/detail/suppress_warnings.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/test/detail/enable_warnings.hpp>
 
 // STL
@@ -54,6 +56,12 @@ namespace env = rt::env;
 #include <iostream>
 #include <fstream>
 
+#if defined(BOOST_HAS_UNISTD_H)
+// SYSTEM API
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
 #include <boost/test/detail/suppress_warnings.hpp>
 
 //____________________________________________________________________________//
@@ -130,6 +138,8 @@ operator>>( std::istream& in, unit_test::output_format& of )
         "CLF", unit_test::OF_CLF,
         "XML", unit_test::OF_XML,
         "DOT", unit_test::OF_DOT,
+        "BIN", unit_test::OF_BIN,
+        "JSON", unit_test::OF_JSON,
 
         unit_test::OF_INVALID
         );
@@ -154,27 +164,42 @@ namespace runtime_config {
 namespace {
 
 // framework parameters and corresponding command-line arguments
+std::string ASYNC_LOG         = "async_log";
 std::string AUTO_START_DBG    = "auto_start_dbg";
 std::string BREAK_EXEC_PATH   = "break_exec_path";
 std::string BUILD_INFO        = "build_info";
 std::string CATCH_SYS_ERRORS  = "catch_system_errors";
 std::string COLOR_OUTPUT      = "color_output";
+std::string CONFIG_FILE       = "config_file";
 std::string DETECT_FP_EXCEPT  = "detect_fp_exceptions";
 std::string DETECT_MEM_LEAKS  = "detect_memory_leaks";
+std::string FAIL_FAST         = "fail_fast";
+std::string FLIGHT_RECORDER   = "flight_recorder";
+std::string ISOLATE           = "isolate";
+std::string JOBS              = "jobs";
 std::string LIST_CONTENT      = "list_content";
 std::string LIST_LABELS       = "list_labels";
+std::string LOG_FLUSH         = "log_flush";
 std::string LOG_FORMAT        = "log_format";
 std::string LOG_LEVEL         = "log_level";
 std::string LOG_SINK          = "log_sink";
+std::string LOGGER            = "logger";
+std::string MAX_FAILURES      = "max_failures";
 std::string OUTPUT_FORMAT     = "output_format";
 std::string RANDOM_SEED       = "random";
 std::string REPORT_FORMAT     = "report_format";
 std::string REPORT_LEVEL      = "report_level";
+std::string REPORT_RES_USAGE  = "report_resource_usage";
 std::string REPORT_SINK       = "report_sink";
+std::string RERUN_FAILED      = "rerun_failed";
+std::string RESOURCE_BUDGET   = "resource_budget";
 std::string RESULT_CODE       = "result_code";
 std::string TESTS_TO_RUN      = "run_test";
 std::string SAVE_TEST_PATTERN = "save_pattern";
+std::string SHARD             = "shard";
+std::string BALANCE_SHARDS    = "balance_shards";
 std::string SHOW_PROGRESS     = "show_progress";
+std::string TIMING_DB         = "timing_db";
 std::string USE_ALT_STACK     = "use_alt_stack";
 std::string WAIT_FOR_DEBUGGER = "wait_for_debugger";
 
@@ -185,27 +210,42 @@ parameter_2_env_var( const_string param_name )
     static mtype s_mapping;
 
     if( s_mapping.empty() ) {
+        s_mapping[ASYNC_LOG]            = "BOOST_TEST_ASYNC_LOG";
         s_mapping[AUTO_START_DBG]       = "BOOST_TEST_AUTO_START_DBG";
         s_mapping[BREAK_EXEC_PATH]      = "BOOST_TEST_BREAK_EXEC_PATH";
         s_mapping[BUILD_INFO]           = "BOOST_TEST_BUILD_INFO";
         s_mapping[CATCH_SYS_ERRORS]     = "BOOST_TEST_CATCH_SYSTEM_ERRORS";
         s_mapping[COLOR_OUTPUT]         = "BOOST_TEST_COLOR_OUTPUT";
+        s_mapping[CONFIG_FILE]          = "BOOST_TEST_CONFIG_FILE";
         s_mapping[DETECT_FP_EXCEPT]     = "BOOST_TEST_DETECT_FP_EXCEPTIONS";
         s_mapping[DETECT_MEM_LEAKS]     = "BOOST_TEST_DETECT_MEMORY_LEAK";
+        s_mapping[FAIL_FAST]            = "BOOST_TEST_FAIL_FAST";
+        s_mapping[FLIGHT_RECORDER]      = "BOOST_TEST_FLIGHT_RECORDER";
+        s_mapping[ISOLATE]              = "BOOST_TEST_ISOLATE";
+        s_mapping[JOBS]                 = "BOOST_TEST_JOBS";
         s_mapping[LIST_CONTENT]         = "BOOST_TEST_LIST_CONTENT";
-        s_mapping[LIST_CONTENT]         = "BOOST_TEST_LIST_LABELS";
+        s_mapping[LIST_LABELS]          = "BOOST_TEST_LIST_LABELS";
+        s_mapping[LOG_FLUSH]            = "BOOST_TEST_LOG_FLUSH";
         s_mapping[LOG_FORMAT]           = "BOOST_TEST_LOG_FORMAT";
         s_mapping[LOG_LEVEL]            = "BOOST_TEST_LOG_LEVEL";
         s_mapping[LOG_SINK]             = "BOOST_TEST_LOG_SINK";
+        s_mapping[LOGGER]               = "BOOST_TEST_LOGGER";
+        s_mapping[MAX_FAILURES]         = "BOOST_TEST_MAX_FAILURES";
         s_mapping[OUTPUT_FORMAT]        = "BOOST_TEST_OUTPUT_FORMAT";
         s_mapping[RANDOM_SEED]          = "BOOST_TEST_RANDOM";
         s_mapping[REPORT_FORMAT]        = "BOOST_TEST_REPORT_FORMAT";
         s_mapping[REPORT_LEVEL]         = "BOOST_TEST_REPORT_LEVEL";
+        s_mapping[REPORT_RES_USAGE]     = "BOOST_TEST_REPORT_RESOURCE_USAGE";
         s_mapping[REPORT_SINK]          = "BOOST_TEST_REPORT_SINK";
+        s_mapping[RERUN_FAILED]         = "BOOST_TEST_RERUN_FAILED";
+        s_mapping[RESOURCE_BUDGET]      = "BOOST_TEST_RESOURCE_BUDGET";
         s_mapping[RESULT_CODE]          = "BOOST_TEST_RESULT_CODE";
         s_mapping[TESTS_TO_RUN]         = "BOOST_TESTS_TO_RUN";
         s_mapping[SAVE_TEST_PATTERN]    = "BOOST_TEST_SAVE_PATTERN";
+        s_mapping[SHARD]                = "BOOST_TEST_SHARD";
+        s_mapping[BALANCE_SHARDS]       = "BOOST_TEST_BALANCE_SHARDS";
         s_mapping[SHOW_PROGRESS]        = "BOOST_TEST_SHOW_PROGRESS";
+        s_mapping[TIMING_DB]            = "BOOST_TEST_TIMING_DB";
         s_mapping[USE_ALT_STACK]        = "BOOST_TEST_USE_ALT_STACK";
         s_mapping[WAIT_FOR_DEBUGGER]    = "BOOST_TEST_WAIT_FOR_DEBUGGER";
     }
@@ -217,14 +257,100 @@ parameter_2_env_var( const_string param_name )
 
 //____________________________________________________________________________//
 
+// log sink specified with the logger parameter; the stream is opened on request
+struct logger_param {
+    output_format           m_format;
+    unit_test::log_level    m_level;
+    std::string             m_sink;
+};
+
+//____________________________________________________________________________//
+
+// all the runtime parameters, resolved once by init
+struct parameters {
+    parameters()
+    : m_async_log( false )
+    , m_auto_start_dbg( false )
+#ifdef BOOST_TEST_DEFAULTS_TO_CORE_DUMP
+    , m_catch_sys_errors( false )
+#else
+    , m_catch_sys_errors( true )
+#endif
+    , m_color_output( false )
+    , m_detect_fp_exceptions( false )
+    , m_detect_memory_leaks( 0 )
+    , m_flight_recorder( 0 )
+    , m_isolate( false )
+    , m_jobs( 1 )
+    , m_list_content( OF_INVALID )
+    , m_list_labels( false )
+    , m_log_flush( FLUSH_LINE )
+    , m_log_flush_bytes( 0 )
+    , m_log_format( OF_CLF )
+    , m_log_level( log_all_errors )
+    , m_max_failures( 0 )
+    , m_no_result_code( false )
+    , m_random_seed( 0 )
+    , m_report_format( OF_CLF )
+    , m_report_level( CONFIRMATION_REPORT )
+    , m_report_resource_usage( false )
+    , m_save_pattern( false )
+    , m_show_build_info( false )
+    , m_show_progress( false )
+    , m_use_alt_stack( true )
+    , m_wait_for_debugger( false )
+    {}
+
+    bool                    m_async_log;
+    bool                    m_auto_start_dbg;
+    std::string             m_break_exec_path;
+    bool                    m_catch_sys_errors;
+    bool                    m_color_output;
+    bool                    m_detect_fp_exceptions;
+    long                    m_detect_memory_leaks;
+    unsigned                m_flight_recorder;
+    bool                    m_isolate;
+    unsigned                m_jobs;
+    output_format           m_list_content;
+    bool                    m_list_labels;
+    flush_mode              m_log_flush;
+    std::size_t             m_log_flush_bytes;
+    output_format           m_log_format;
+    unit_test::log_level    m_log_level;
+    std::string             m_log_sink;
+    std::list<logger_param> m_loggers;
+    unsigned                m_max_failures;
+    std::string             m_memory_leaks_report_file;
+    bool                    m_no_result_code;
+    unsigned                m_random_seed;
+    output_format           m_report_format;
+    unit_test::report_level m_report_level;
+    bool                    m_report_resource_usage;
+    std::string             m_report_sink;
+    std::string             m_rerun_failed;
+    resource_usage          m_resource_budget;
+    bool                    m_save_pattern;
+    std::string             m_shard;
+    std::string             m_balance_shards;
+    bool                    m_show_build_info;
+    bool                    m_show_progress;
+    std::list<std::string>  m_test_to_run;
+    std::string             m_timing_db;
+    bool                    m_use_alt_stack;
+    bool                    m_wait_for_debugger;
+};
+
+//____________________________________________________________________________//
+
 // storage for the CLAs
 cla::parser             s_cla_parser;
 std::string             s_empty;
 
-output_format           s_report_format;
-output_format           s_log_format;
+// parameters read from the configuration file
+typedef std::map<std::string,std::string> config_file_values;
+config_file_values      s_config_file;
 
-std::list<std::string>  s_test_to_run;
+parameters              s_params;
 
 //____________________________________________________________________________//
 
@@ -253,8 +379,267 @@ retrieve_parameter( const_string parameter_name, cla::parser const& s_cla_parser
 
     if( v )
         return *v;
-    else
+
+    config_file_values::const_iterator it = s_config_file.find( std::string( parameter_name.begin(), parameter_name.size() ) );
+    if( it == s_config_file.end() )
         return default_value;
+
+    if( it->second.empty() && rtti::type_id<T>() != rtti::type_id<bool>() )
+        return optional_value;
+
+    BOOST_TEST_IMPL_TRY {
+        rt::interpret_argument_value( it->second, v, 0 );
+    }
+    BOOST_TEST_IMPL_CATCH0( boost::bad_lexical_cast ) {
+        BOOST_TEST_SETUP_ASSERT( false, "invalid value " + it->second + " of parameter " + it->first + " in configuration file" );
+    }
+
+    return *v;
+}
+
+//____________________________________________________________________________//
+
+// Reads "name = value" lines of the configuration file; empty lines and the ones starting with # are ignored.
+// Values of the parameters which can be specified several times (run_test) are collected as a comma separated
+// list, the same way they are specified in the environment variable; otherwise the last value is used
+void
+load_config_file( std::string const& file_name )
+{
+    std::ifstream input( file_name.c_str() );
+    BOOST_TEST_SETUP_ASSERT( input, "can't open configuration file " + file_name );
+
+    std::string line;
+    while( std::getline( input, line ) ) {
+        const_string record( line );
+        record.trim();
+
+        if( record.is_empty() || record[0] == '#' )
+            continue;
+
+        const_string::size_type eq_pos = record.find( "=" );
+
+        const_string name  = eq_pos == const_string::npos ? record : record.substr( 0, eq_pos );
+        const_string value = eq_pos == const_string::npos ? const_string() : record.substr( eq_pos + 1 );
+
+        name.trim();
+        value.trim();
+
+        if( value.size() >= 2 && value[0] == '"' && value[value.size()-1] == '"' )
+            value = value.substr( 1, value.size() - 1 );
+
+        std::string param_name( name.begin(), name.size() );
+
+        BOOST_TEST_SETUP_ASSERT( !parameter_2_env_var( param_name ).is_empty() && param_name != CONFIG_FILE,
+                                 "unknown parameter " + param_name + " in configuration file " + file_name );
+
+        std::string& slot = s_config_file[param_name];
+
+        if( param_name == TESTS_TO_RUN && !slot.empty() )
+            slot.append( "," );
+        else
+            slot.clear();
+
+        slot.append( value.begin(), value.size() );
+    }
+}
+
+//____________________________________________________________________________//
+
+long
+interpret_memory_leaks_value( std::string const& value, std::string& report_file )
+{
+    optional<bool> bool_val;
+    if( runtime::interpret_argument_value_impl<bool>::_( value, bool_val ) )
+        return *bool_val ? 1L : 0L;
+
+    BOOST_TEST_IMPL_TRY {
+        // if representable as long - this is leak number
+        return boost::lexical_cast<long>( value );
+    }
+    BOOST_TEST_IMPL_CATCH0( boost::bad_lexical_cast ) {
+        // value is leak report file and detection is enabled
+        report_file = value;
+    }
+
+    return 1L;
+}
+
+//____________________________________________________________________________//
+
+// Interprets the list of the log sinks specified as format[,level[,sink]] separated by colons, for example
+// HRF,warning,stdout:XML,all,out.xml. The level and sink omitted are the ones of log_level and log_sink
+std::list<logger_param>
+interpret_logger_value( std::string const& value, parameters const& p )
+{
+    std::list<logger_param> res;
+
+    if( value.empty() ) {
+        logger_param lp = { p.m_log_format, p.m_log_level, p.m_log_sink };
+        res.push_back( lp );
+
+        return res;
+    }
+
+    const_string spec_list( value );
+
+    while( !spec_list.is_empty() ) {
+        const_string::size_type pos = spec_list.find( ":" );
+
+        const_string spec = pos == const_string::npos ? spec_list : spec_list.substr( 0, pos );
+        spec_list = pos == const_string::npos ? const_string() : spec_list.substr( pos + 1 );
+
+        logger_param lp = { OF_INVALID, p.m_log_level, p.m_log_sink };
+
+        for( int field = 0; !spec.is_empty() || field == 0; ++field ) {
+            pos = spec.find( "," );
+
+            const_string field_value = pos == const_string::npos ? spec : spec.substr( 0, pos );
+            spec = pos == const_string::npos ? const_string() : spec.substr( pos + 1 );
+
+            field_value.trim();
+            std::string field_str( field_value.begin(), field_value.size() );
+
+            switch( field ) {
+            case 0:     lp.m_format = boost::lexical_cast<output_format>( field_str ); break;
+            case 1:     lp.m_level = boost::lexical_cast<unit_test::log_level>( field_str ); break;
+            case 2:     lp.m_sink = field_str; break;
+            default:    BOOST_TEST_SETUP_ASSERT( false, "invalid logger specification " + value );
+            }
+        }
+
+        BOOST_TEST_SETUP_ASSERT( lp.m_format != OF_DOT, "DOT format is not supported by the log" );
+
+        BOOST_TEST_FOREACH( logger_param const&, other, res )
+            BOOST_TEST_SETUP_ASSERT( other.m_format != lp.m_format, "log format is specified more than once in " + value );
+
+        res.push_back( lp );
+    }
+
+    return res;
+}
+
+//____________________________________________________________________________//
+
+// Interprets the flush policy specified as line, unit, bytes:N or end
+void
+interpret_log_flush_value( std::string const& value, parameters& p )
+{
+    const_string policy( value );
+    policy.trim();
+
+    if( policy.is_empty() || case_ins_eq( policy, const_string( "line" ) ) )
+        p.m_log_flush = FLUSH_LINE;
+    else if( case_ins_eq( policy, const_string( "unit" ) ) )
+        p.m_log_flush = FLUSH_UNIT;
+    else if( case_ins_eq( policy, const_string( "end" ) ) )
+        p.m_log_flush = FLUSH_END;
+    else {
+        const_string::size_type pos = policy.find( ":" );
+
+        BOOST_TEST_SETUP_ASSERT( pos != const_string::npos && case_ins_eq( policy.substr( 0, pos ), const_string( "bytes" ) ),
+                                 "invalid log flush policy " + value );
+
+        const_string size = policy.substr( pos + 1 );
+        size.trim();
+
+        BOOST_TEST_IMPL_TRY {
+            p.m_log_flush_bytes = boost::lexical_cast<std::size_t>( size );
+        }
+        BOOST_TEST_IMPL_CATCH0( boost::bad_lexical_cast ) {
+            p.m_log_flush_bytes = 0;
+        }
+
+        BOOST_TEST_SETUP_ASSERT( p.m_log_flush_bytes > 0, "invalid log flush policy " + value );
+
+        p.m_log_flush = FLUSH_BYTES;
+    }
+}
+
+//____________________________________________________________________________//
+
+// Interprets the resource budget specified as comma separated name:limit pairs
+resource_usage
+interpret_resource_budget_value( std::string const& value )
+{
+    resource_usage res;
+
+    const_string spec( value );
+
+    while( !spec.trim().is_empty() ) {
+        const_string::size_type pos = spec.find( "," );
+
+        const_string limit_spec = pos == const_string::npos ? spec : spec.substr( 0, pos );
+        spec = pos == const_string::npos ? const_string() : spec.substr( pos + 1 );
+
+        const_string::size_type colon = limit_spec.find( ":" );
+        BOOST_TEST_SETUP_ASSERT( colon != const_string::npos, "invalid resource budget " + value );
+
+        const_string name = limit_spec.substr( 0, colon );
+        const_string limit = limit_spec.substr( colon + 1 );
+        name.trim();
+        limit.trim();
+
+        resource_usage::counter limit_value = 0;
+        BOOST_TEST_IMPL_TRY {
+            limit_value = boost::lexical_cast<resource_usage::counter>( limit );
+        }
+        BOOST_TEST_IMPL_CATCH0( boost::bad_lexical_cast ) {
+            BOOST_TEST_SETUP_ASSERT( false, "invalid resource budget " + value );
+        }
+
+        if( name == "max_rss" )
+            res.max_rss = limit_value;
+        else if( name == "minor_faults" )
+            res.minor_faults = limit_value;
+        else if( name == "major_faults" )
+            res.major_faults = limit_value;
+        else if( name == "voluntary_switches" )
+            res.voluntary_switches = limit_value;
+        else if( name == "involuntary_switches" )
+            res.involuntary_switches = limit_value;
+        else if( name == "block_inputs" )
+            res.block_inputs = limit_value;
+        else if( name == "block_outputs" )
+            res.block_outputs = limit_value;
+        else
+            BOOST_TEST_SETUP_ASSERT( false, "invalid resource budget " + value );
+    }
+
+    return res;
+}
+
+//____________________________________________________________________________//
+
+// file descriptors appending to the log files, for the output written from a signal handler
+typedef std::map<std::ostream const*,int> log_file_descriptors;
+
+log_file_descriptors& s_log_file_descriptors() { static log_file_descriptors the_inst; return the_inst; }
+
+//____________________________________________________________________________//
+
+// Log files are opened once and shared by all the sinks with the same name
+std::ostream*
+open_log_sink( std::string const& sink_name, output_format format )
+{
+    if( sink_name.empty() || sink_name == "stdout" )
+        return &std::cout;
+
+    if( sink_name == "stderr" )
+        return &std::cerr;
+
+    typedef std::map<std::string,boost::shared_ptr<std::ofstream> > log_files;
+    static log_files s_log_files;
+
+    boost::shared_ptr<std::ofstream>& log_file = s_log_files[sink_name];
+    if( !log_file ) {
+        log_file.reset( new std::ofstream( sink_name.c_str(), format == OF_BIN ? std::ios::out | std::ios::binary : std::ios::out ) );
+
+#if defined(BOOST_HAS_UNISTD_H)
+        s_log_file_descriptors()[log_file.get()] = ::open( sink_name.c_str(), O_WRONLY | O_APPEND );
+#endif
+    }
+
+    return log_file.get();
 }
 
 //____________________________________________________________________________//
@@ -279,6 +664,9 @@ init( int& argc, char** argv )
             s_cla_parser.reset();
         else
             s_cla_parser - cla::ignore_mismatch
+              << cla::named_parameter<bool>( ASYNC_LOG )
+                - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,
+                   cla::description = "Formats and writes the log in a background thread")
               << cla::dual_name_parameter<bool>( AUTO_START_DBG + "|d" )
                 - (cla::prefix = "--|-",cla::separator = "=| ",cla::guess_name,cla::optional,
                    cla::description = "Automatically starts debugger if system level error (signal) occurs")
@@ -295,12 +683,33 @@ init( int& argc, char** argv )
               << cla::dual_name_parameter<bool>( COLOR_OUTPUT + "|x" )
                 - (cla::prefix = "--|-",cla::separator = "=| ",cla::guess_name,cla::optional,
                    cla::description = "Allows to switch between catching and ignoring system errors (signals)")
+              << cla::named_parameter<std::string>( CONFIG_FILE )
+                - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,
+                   cla::description = "Specifies file to read the runtime parameters not specified otherwise from")
               << cla::named_parameter<bool>( DETECT_FP_EXCEPT )
                 - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,
                    cla::description = "Allows to switch between catching and ignoring floating point exceptions")
               << cla::named_parameter<std::string>( DETECT_MEM_LEAKS )
                 - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,cla::optional_value,
                    cla::description = "Allows to switch between catching and ignoring memory leaks")
+              << cla::named_parameter<bool>( FAIL_FAST )
+                - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,
+                   cla::description = "Stops the test execution after the first failed test case")
+              << cla::named_parameter<unsigned>( FLIGHT_RECORDER )
+                - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,
+                   cla::description = "Keeps up to N KB of the log of each test case in memory and writes it only if the test case fails")
+              << cla::named_parameter<bool>( ISOLATE )
+                - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,
+                   cla::description = "Executes each test case in a separate worker process, so that its crash does not affect the rest")
+              << cla::named_parameter<unsigned>( JOBS )
+                - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,
+                   cla::description = "Specifies number of worker processes used to execute independent test units in parallel")
+              << cla::named_parameter<unsigned>( MAX_FAILURES )
+                - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,
+                   cla::description = "Specifies number of failed test cases after which the test execution stops")
+              << cla::named_parameter<std::string>( LOG_FLUSH )
+                - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,
+                   cla::description = "Specifies when the buffered output is flushed: line(default), unit, bytes:N or end")
               << cla::dual_name_parameter<unit_test::output_format>( LOG_FORMAT + "|f" )
                 - (cla::prefix = "--|-",cla::separator = "=| ",cla::guess_name,cla::optional,
                    cla::description = "Specifies log format")
@@ -310,6 +719,9 @@ init( int& argc, char** argv )
               << cla::dual_name_parameter<std::string>( LOG_SINK + "|k" )
                 - (cla::prefix = "--|-",cla::separator = "=| ",cla::guess_name,cla::optional,
                    cla::description = "Specifies log sink:stdout(default),stderr or file name")
+              << cla::named_parameter<std::string>( LOGGER )
+                - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,
+                   cla::description = "Specifies several log sinks as format,level,sink separated by colons")
               << cla::dual_name_parameter<unit_test::output_format>( OUTPUT_FORMAT + "|o" )
                 - (cla::prefix = "--|-",cla::separator = "=| ",cla::guess_name,cla::optional,
                    cla::description = "Specifies output format (both log and report)")
@@ -323,9 +735,18 @@ init( int& argc, char** argv )
               << cla::dual_name_parameter<unit_test::report_level>(REPORT_LEVEL + "|r")
                 - (cla::prefix = "--|-",cla::separator = "=| ",cla::guess_name,cla::optional,
                    cla::description = "Specifies report level")
+              << cla::named_parameter<bool>( REPORT_RES_USAGE )
+                - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,
+                   cla::description = "Includes the resource usage of the test units into the detailed report")
               << cla::dual_name_parameter<std::string>( REPORT_SINK + "|e" )
                 - (cla::prefix = "--|-",cla::separator = "=| ",cla::guess_name,cla::optional,
                    cla::description = "Specifies report sink:stderr(default),stdout or file name")
+              << cla::named_parameter<std::string>( RERUN_FAILED )
+                - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,
+                   cla::description = "Specifies file to keep the list of failed test cases in and runs only these test cases if any")
+              << cla::named_parameter<std::string>( RESOURCE_BUDGET )
+                - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,
+                   cla::description = "Fails the test cases using more resources than specified as name:limit pairs separated by commas")
               << cla::dual_name_parameter<bool>( RESULT_CODE + "|c" )
                 - (cla::prefix = "--|-",cla::separator = "=| ",cla::guess_name,cla::optional,
                    cla::description = "Allows to disable test modules's result code generation")
@@ -335,9 +756,18 @@ init( int& argc, char** argv )
               << cla::named_parameter<bool>( SAVE_TEST_PATTERN )
                 - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,
                    cla::description = "Allows to switch between saving and matching against test pattern file")
+              << cla::named_parameter<std::string>( SHARD )
+                - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,
+                   cla::description = "Runs only the i-th of n disjoint parts of the test cases, specified as i/n")
+              << cla::named_parameter<std::string>( BALANCE_SHARDS )
+                - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,
+                   cla::description = "Specifies timing history file to balance the shards by the test cases durations")
               << cla::dual_name_parameter<bool>( SHOW_PROGRESS + "|p" )
                 - (cla::prefix = "--|-",cla::separator = "=| ",cla::guess_name,cla::optional,
                    cla::description = "Turns on progress display")
+              << cla::named_parameter<std::string>( TIMING_DB )
+                - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional,
+                   cla::description = "Specifies file to keep the history of test units durations in")
               << cla::dual_name_parameter<unit_test::output_format>( LIST_CONTENT + "|j" )
                 - (cla::prefix = "--|-",cla::separator = "=| ",cla::guess_name,cla::optional,cla::optional_value,
                    cla::description = "Lists the content of test tree - names of all test suites and test cases")
@@ -363,15 +793,62 @@ init( int& argc, char** argv )
             BOOST_TEST_IMPL_THROW( framework::nothing_to_test() );
         }
 
-        s_report_format     = retrieve_parameter( REPORT_FORMAT, s_cla_parser, unit_test::OF_CLF );
-        s_log_format        = retrieve_parameter( LOG_FORMAT, s_cla_parser, unit_test::OF_CLF );
+        // the configuration file has the lowest priority: command line arguments, then environment variables
+        s_config_file.clear();
+
+        std::string config_file = retrieve_parameter( CONFIG_FILE, s_cla_parser, s_empty );
+        if( !config_file.empty() )
+            load_config_file( config_file );
+
+        // resolve all the parameters once; the accessors below only read the snapshot
+        parameters p;
+
+        p.m_async_log               = retrieve_parameter( ASYNC_LOG, s_cla_parser, p.m_async_log );
+        p.m_auto_start_dbg          = retrieve_parameter( AUTO_START_DBG, s_cla_parser, p.m_auto_start_dbg );
+        p.m_break_exec_path         = retrieve_parameter( BREAK_EXEC_PATH, s_cla_parser, s_empty );
+        p.m_catch_sys_errors        = retrieve_parameter( CATCH_SYS_ERRORS, s_cla_parser, p.m_catch_sys_errors );
+        p.m_color_output            = retrieve_parameter( COLOR_OUTPUT, s_cla_parser, p.m_color_output );
+        p.m_detect_fp_exceptions    = retrieve_parameter( DETECT_FP_EXCEPT, s_cla_parser, p.m_detect_fp_exceptions );
+        p.m_detect_memory_leaks     = interpret_memory_leaks_value( retrieve_parameter( DETECT_MEM_LEAKS, s_cla_parser, s_empty ),
+                                                                    p.m_memory_leaks_report_file );
+        p.m_flight_recorder         = retrieve_parameter( FLIGHT_RECORDER, s_cla_parser, p.m_flight_recorder );
+        p.m_isolate                 = retrieve_parameter( ISOLATE, s_cla_parser, p.m_isolate );
+        p.m_jobs                    = retrieve_parameter( JOBS, s_cla_parser, p.m_jobs );
+        p.m_list_content            = retrieve_parameter( LIST_CONTENT, s_cla_parser, p.m_list_content, unit_test::OF_CLF );
+        p.m_list_labels             = retrieve_parameter( LIST_LABELS, s_cla_parser, p.m_list_labels );
+        interpret_log_flush_value( retrieve_parameter( LOG_FLUSH, s_cla_parser, s_empty ), p );
+        p.m_log_format              = retrieve_parameter( LOG_FORMAT, s_cla_parser, p.m_log_format );
+        p.m_log_level               = retrieve_parameter( LOG_LEVEL, s_cla_parser, p.m_log_level );
+        p.m_log_sink                = retrieve_parameter( LOG_SINK, s_cla_parser, s_empty );
+        p.m_max_failures            = retrieve_parameter( FAIL_FAST, s_cla_parser, false )
+                                        ? 1U
+                                        : retrieve_parameter( MAX_FAILURES, s_cla_parser, p.m_max_failures );
+        p.m_no_result_code          = !retrieve_parameter( RESULT_CODE, s_cla_parser, true );
+        p.m_random_seed             = retrieve_parameter( RANDOM_SEED, s_cla_parser, p.m_random_seed, 1U );
+        p.m_report_format           = retrieve_parameter( REPORT_FORMAT, s_cla_parser, p.m_report_format );
+        p.m_report_level            = retrieve_parameter( REPORT_LEVEL, s_cla_parser, p.m_report_level );
+        p.m_report_resource_usage   = retrieve_parameter( REPORT_RES_USAGE, s_cla_parser, p.m_report_resource_usage );
+        p.m_report_sink             = retrieve_parameter( REPORT_SINK, s_cla_parser, s_empty );
+        p.m_rerun_failed            = retrieve_parameter( RERUN_FAILED, s_cla_parser, s_empty );
+        p.m_resource_budget         = interpret_resource_budget_value( retrieve_parameter( RESOURCE_BUDGET, s_cla_parser, s_empty ) );
+        p.m_save_pattern            = retrieve_parameter( SAVE_TEST_PATTERN, s_cla_parser, p.m_save_pattern );
+        p.m_shard                   = retrieve_parameter( SHARD, s_cla_parser, s_empty );
+        p.m_balance_shards          = retrieve_parameter( BALANCE_SHARDS, s_cla_parser, s_empty );
+        p.m_show_build_info         = retrieve_parameter( BUILD_INFO, s_cla_parser, p.m_show_build_info );
+        p.m_show_progress           = retrieve_parameter( SHOW_PROGRESS, s_cla_parser, p.m_show_progress );
+        p.m_test_to_run             = retrieve_parameter<std::list<std::string> >( TESTS_TO_RUN, s_cla_parser );
+        p.m_timing_db               = retrieve_parameter( TIMING_DB, s_cla_parser, s_empty );
+        p.m_use_alt_stack           = retrieve_parameter( USE_ALT_STACK, s_cla_parser, p.m_use_alt_stack );
+        p.m_wait_for_debugger       = retrieve_parameter( WAIT_FOR_DEBUGGER, s_cla_parser, p.m_wait_for_debugger );
 
         unit_test::output_format of = retrieve_parameter( OUTPUT_FORMAT, s_cla_parser, unit_test::OF_INVALID );
 
         if( of != unit_test::OF_INVALID )
-            s_report_format = s_log_format = of;
+            p.m_report_format = p.m_log_format = of;
 
-        s_test_to_run = retrieve_parameter<std::list<std::string> >( TESTS_TO_RUN, s_cla_parser );
+        p.m_loggers                 = interpret_logger_value( retrieve_parameter( LOGGER, s_cla_parser, s_empty ), p );
+
+        s_params = p;
     }
     BOOST_TEST_IMPL_CATCH( rt::logic_error, ex ) {
         std::ostringstream err;
@@ -388,7 +865,7 @@ init( int& argc, char** argv )
 unit_test::log_level
 log_level()
 {
-    return retrieve_parameter( LOG_LEVEL, s_cla_parser, unit_test::log_all_errors );
+    return s_params.m_log_level;
 }
 
 //____________________________________________________________________________//
@@ -396,7 +873,7 @@ log_level()
 bool
 no_result_code()
 {
-    return !retrieve_parameter( RESULT_CODE, s_cla_parser, true );
+    return s_params.m_no_result_code;
 }
 
 //____________________________________________________________________________//
@@ -404,7 +881,23 @@ no_result_code()
 unit_test::report_level
 report_level()
 {
-    return retrieve_parameter( REPORT_LEVEL, s_cla_parser, unit_test::CONFIRMATION_REPORT );
+    return s_params.m_report_level;
+}
+
+//____________________________________________________________________________//
+
+bool
+report_resource_usage()
+{
+    return s_params.m_report_resource_usage;
+}
+
+//____________________________________________________________________________//
+
+resource_usage const&
+resource_budget()
+{
+    return s_params.m_resource_budget;
 }
 
 //____________________________________________________________________________//
@@ -412,7 +905,7 @@ report_level()
 std::list<std::string> const&
 test_to_run()
 {
-    return s_test_to_run;
+    return s_params.m_test_to_run;
 }
 
 //____________________________________________________________________________//
@@ -420,9 +913,7 @@ test_to_run()
 const_string
 break_exec_path()
 {
-    static std::string s_break_exec_path = retrieve_parameter( BREAK_EXEC_PATH, s_cla_parser, s_empty );
-
-    return s_break_exec_path;
+    return s_params.m_break_exec_path;
 }
 
 //____________________________________________________________________________//
@@ -430,7 +921,31 @@ break_exec_path()
 bool
 save_pattern()
 {
-    return retrieve_parameter( SAVE_TEST_PATTERN, s_cla_parser, false );
+    return s_params.m_save_pattern;
+}
+
+//____________________________________________________________________________//
+
+std::string
+rerun_failed()
+{
+    return s_params.m_rerun_failed;
+}
+
+//____________________________________________________________________________//
+
+std::string
+shard()
+{
+    return s_params.m_shard;
+}
+
+//____________________________________________________________________________//
+
+std::string
+balance_shards()
+{
+    return s_params.m_balance_shards;
 }
 
 //____________________________________________________________________________//
@@ -438,7 +953,7 @@ save_pattern()
 bool
 show_progress()
 {
-    return retrieve_parameter( SHOW_PROGRESS, s_cla_parser, false );
+    return s_params.m_show_progress;
 }
 
 //____________________________________________________________________________//
@@ -446,7 +961,15 @@ show_progress()
 bool
 show_build_info()
 {
-    return retrieve_parameter( BUILD_INFO, s_cla_parser, false );
+    return s_params.m_show_build_info;
+}
+
+//____________________________________________________________________________//
+
+std::string
+timing_db()
+{
+    return s_params.m_timing_db;
 }
 
 //____________________________________________________________________________//
@@ -454,7 +977,7 @@ show_build_info()
 output_format
 list_content()
 {
-    return retrieve_parameter( LIST_CONTENT, s_cla_parser, unit_test::OF_INVALID, unit_test::OF_CLF );
+    return s_params.m_list_content;
 }
 
 //____________________________________________________________________________//
@@ -462,7 +985,7 @@ list_content()
 bool
 list_labels()
 {
-    return retrieve_parameter( LIST_LABELS, s_cla_parser, false );
+    return s_params.m_list_labels;
 }
 
 //____________________________________________________________________________//
@@ -470,13 +993,7 @@ list_labels()
 bool
 catch_sys_errors()
 {
-    return retrieve_parameter( CATCH_SYS_ERRORS, s_cla_parser,
-#ifdef BOOST_TEST_DEFAULTS_TO_CORE_DUMP
-        false
-#else
-        true
-#endif
-        );
+    return s_params.m_catch_sys_errors;
 }
 
 //____________________________________________________________________________//
@@ -484,7 +1001,15 @@ catch_sys_errors()
 bool
 color_output()
 {
-    return retrieve_parameter( COLOR_OUTPUT, s_cla_parser, false );
+    return s_params.m_color_output;
+}
+
+//____________________________________________________________________________//
+
+bool
+async_log()
+{
+    return s_params.m_async_log;
 }
 
 //____________________________________________________________________________//
@@ -493,8 +1018,7 @@ bool
 auto_start_dbg()
 {
     // !! ?? set debugger as an option
-    return retrieve_parameter( AUTO_START_DBG, s_cla_parser, false );
-;
+    return s_params.m_auto_start_dbg;
 }
 
 //____________________________________________________________________________//
@@ -502,7 +1026,7 @@ auto_start_dbg()
 bool
 wait_for_debugger()
 {
-    return retrieve_parameter( WAIT_FOR_DEBUGGER, s_cla_parser, false );
+    return s_params.m_wait_for_debugger;
 }
 
 //____________________________________________________________________________//
@@ -510,7 +1034,7 @@ wait_for_debugger()
 bool
 use_alt_stack()
 {
-    return retrieve_parameter( USE_ALT_STACK, s_cla_parser, true );
+    return s_params.m_use_alt_stack;
 }
 
 //____________________________________________________________________________//
@@ -518,7 +1042,7 @@ use_alt_stack()
 bool
 detect_fp_exceptions()
 {
-    return retrieve_parameter( DETECT_FP_EXCEPT, s_cla_parser, false );
+    return s_params.m_detect_fp_exceptions;
 }
 
 //____________________________________________________________________________//
@@ -526,7 +1050,23 @@ detect_fp_exceptions()
 output_format
 report_format()
 {
-    return s_report_format;
+    return s_params.m_report_format;
+}
+
+//____________________________________________________________________________//
+
+flush_mode
+log_flush()
+{
+    return s_params.m_log_flush;
+}
+
+//____________________________________________________________________________//
+
+std::size_t
+log_flush_bytes()
+{
+    return s_params.m_log_flush_bytes;
 }
 
 //____________________________________________________________________________//
@@ -534,7 +1074,7 @@ report_format()
 output_format
 log_format()
 {
-    return s_log_format;
+    return s_params.m_log_format;
 }
 
 //____________________________________________________________________________//
@@ -542,7 +1082,7 @@ log_format()
 std::ostream*
 report_sink()
 {
-    std::string sink_name = retrieve_parameter( REPORT_SINK, s_cla_parser, s_empty );
+    std::string const& sink_name = s_params.m_report_sink;
 
     if( sink_name.empty() || sink_name == "stderr" )
         return &std::cerr;
@@ -559,45 +1099,48 @@ report_sink()
 std::ostream*
 log_sink()
 {
-    std::string sink_name = retrieve_parameter( LOG_SINK, s_cla_parser, s_empty );
+    return open_log_sink( s_params.m_log_sink, s_params.m_log_format );
+}
 
-    if( sink_name.empty() || sink_name == "stdout" )
-        return &std::cout;
+//____________________________________________________________________________//
 
-    if( sink_name == "stderr" )
-        return &std::cerr;
+int
+log_file_descriptor( std::ostream const* log_stream )
+{
+    log_file_descriptors::const_iterator it = s_log_file_descriptors().find( log_stream );
 
-    static std::ofstream log_file( sink_name.c_str() );
-    return &log_file;
+    return it != s_log_file_descriptors().end() ? it->second : -1;
 }
 
 //____________________________________________________________________________//
 
-long
-detect_memory_leaks()
+std::list<logger_spec>
+loggers()
 {
-    static long s_value = -1;
+    std::list<logger_spec> res;
 
-    if( s_value >= 0 )
-        return s_value;
+    BOOST_TEST_FOREACH( logger_param const&, lp, s_params.m_loggers ) {
+        logger_spec ls = { lp.m_format, lp.m_level, open_log_sink( lp.m_sink, lp.m_format ) };
+        res.push_back( ls );
+    }
 
-    std::string value = retrieve_parameter( DETECT_MEM_LEAKS, s_cla_parser, s_empty );
+    return res;
+}
 
-    optional<bool> bool_val;
-    if( runtime::interpret_argument_value_impl<bool>::_( value, bool_val ) )
-        s_value = *bool_val ? 1L : 0L;
-    else {
-        BOOST_TEST_IMPL_TRY {
-            // if representable as long - this is leak number
-            s_value = boost::lexical_cast<long>( value );
-        }
-        BOOST_TEST_IMPL_CATCH0( boost::bad_lexical_cast ) {
-            // value is leak report file and detection is enabled
-            s_value = 1L;
-        }
-    }
+//____________________________________________________________________________//
 
-    return s_value;
+long
+detect_memory_leaks()
+{
+    return s_params.m_detect_memory_leaks;
+}
+
+//____________________________________________________________________________//
+
+unsigned
+flight_recorder()
+{
+    return s_params.m_flight_recorder;
 }
 
 //____________________________________________________________________________//
@@ -605,28 +1148,39 @@ detect_memory_leaks()
 const_string
 memory_leaks_report_file()
 {
-    if( detect_memory_leaks() != 1 )
-        return const_string();
+    return s_params.m_memory_leaks_report_file;
+}
+
+//____________________________________________________________________________//
+
+unsigned
+random_seed()
+{
+    return s_params.m_random_seed;
+}
 
-    static std::string s_value;
+//____________________________________________________________________________//
 
-    if( s_value.empty() ) {
-        s_value = retrieve_parameter<std::string>( DETECT_MEM_LEAKS, s_cla_parser );
+bool
+isolate()
+{
+    return s_params.m_isolate;
+}
 
-        optional<bool> bool_val;
-        if( runtime::interpret_argument_value_impl<bool>::_( s_value, bool_val ) )
-            s_value.clear();
-    }
+//____________________________________________________________________________//
 
-    return s_value;
+unsigned
+jobs()
+{
+    return s_params.m_jobs;
 }
 
 //____________________________________________________________________________//
 
 unsigned
-random_seed()
+max_failures()
 {
-    return retrieve_parameter( RANDOM_SEED, s_cla_parser, 0U, 1U );
+    return s_params.m_max_failures;
 }
 
 //____________________________________________________________________________//
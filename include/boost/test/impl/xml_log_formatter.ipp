@@ -92,10 +92,32 @@ xml_log_formatter::test_unit_start( std::ostream& ostr, test_unit const& tu )
 //____________________________________________________________________________//
 
 void
-xml_log_formatter::test_unit_finish( std::ostream& ostr, test_unit const& tu, unsigned long elapsed )
+xml_log_formatter::test_unit_finish( std::ostream& ostr, test_unit const& tu, elapsed_time const& elapsed )
 {
+    // dispatch through the wall clock only interface, which formatters derived from this one may have customized
+    m_elapsed = elapsed;
+    test_unit_finish( ostr, tu, elapsed.microseconds() );
+    m_elapsed = elapsed_time();
+}
+
+//____________________________________________________________________________//
+
+void
+xml_log_formatter::test_unit_finish( std::ostream& ostr, test_unit const& tu, unsigned long wall_time )
+{
+    // CPU times are only known if invoked through the interface above
+    elapsed_time elapsed = m_elapsed;
+    if( elapsed.microseconds() != wall_time ) {
+        elapsed = elapsed_time();
+        elapsed.wall = static_cast<elapsed_time::nanoseconds>( wall_time ) * 1000;
+    }
+
+    // testing time is in microseconds; the rest of the times are in nanoseconds
     if( tu.p_type == TUT_CASE )
-        ostr << "<TestingTime>" << elapsed << "</TestingTime>";
+        ostr << "<TestingTime>" << elapsed.microseconds() << "</TestingTime>"
+             << "<WallTime>" << elapsed.wall << "</WallTime>"
+             << "<UserTime>" << elapsed.user << "</UserTime>"
+             << "<SystemTime>" << elapsed.system << "</SystemTime>";
 
     ostr << "</" << tu_type_name( tu ) << ">";
 }
@@ -22,6 +22,7 @@
 #include <boost/test/tree/test_unit.hpp>
 #include <boost/test/utils/xml_printer.hpp>
 #include <boost/test/utils/basic_cstring/io.hpp>
+#include <boost/test/unit_test_parameters.hpp>
 
 #include <boost/test/detail/suppress_warnings.hpp>
 
@@ -80,6 +81,17 @@ xml_report_formatter::test_unit_report_start( test_unit const& tu, std::ostream&
              << " test_cases_aborted"   << attr_value() << tr.p_test_cases_aborted;
     }
 
+    if( runtime_config::report_resource_usage() ) {
+        resource_usage const& usage = tr.p_resource_usage;
+
+        ostr << " max_rss_growth"               << attr_value() << usage.max_rss
+             << " minor_page_faults"            << attr_value() << usage.minor_faults
+             << " major_page_faults"            << attr_value() << usage.major_faults
+             << " voluntary_context_switches"   << attr_value() << usage.voluntary_switches
+             << " involuntary_context_switches" << attr_value() << usage.involuntary_switches
+             << " block_inputs"                 << attr_value() << usage.block_inputs
+             << " block_outputs"                << attr_value() << usage.block_outputs;
+    }
 
     ostr << '>';
 }
@@ -25,6 +25,8 @@
 #include <boost/test/impl/test_main.ipp>
 #include <boost/test/impl/test_tools.ipp>
 #include <boost/test/impl/test_tree.ipp>
+#include <boost/test/impl/timer.ipp>
+#include <boost/test/impl/timing_db.ipp>
 #include <boost/test/impl/unit_test_log.ipp>
 #include <boost/test/impl/unit_test_main.ipp>
 #include <boost/test/impl/unit_test_monitor.ipp>
@@ -12,10 +12,12 @@
 #ifndef BOOST_INCLUDED_UNIT_TEST_FRAMEWORK_HPP_071894GER
 #define BOOST_INCLUDED_UNIT_TEST_FRAMEWORK_HPP_071894GER
 
+#include <boost/test/impl/binary_log_formatter.ipp>
 #include <boost/test/impl/compiler_log_formatter.ipp>
 #include <boost/test/impl/debug.ipp>
 #include <boost/test/impl/decorator.ipp>
 #include <boost/test/impl/framework.ipp>
+#include <boost/test/impl/json_log_formatter.ipp>
 #include <boost/test/impl/execution_monitor.ipp>
 #include <boost/test/impl/plain_report_formatter.ipp>
 #include <boost/test/impl/progress_monitor.ipp>
@@ -23,6 +25,8 @@
 #include <boost/test/impl/results_reporter.ipp>
 #include <boost/test/impl/test_tools.ipp>
 #include <boost/test/impl/test_tree.ipp>
+#include <boost/test/impl/timer.ipp>
+#include <boost/test/impl/timing_db.ipp>
 #include <boost/test/impl/unit_test_log.ipp>
 #include <boost/test/impl/unit_test_main.ipp>
 #include <boost/test/impl/unit_test_monitor.ipp>
@@ -0,0 +1,221 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : defines OF_BIN log formatter and the reader of the binary log
+// ***************************************************************************
+
+#ifndef BOOST_TEST_BINARY_LOG_FORMATTER_101615GER
+#define BOOST_TEST_BINARY_LOG_FORMATTER_101615GER
+
+// Boost.Test
+#include <boost/test/detail/global_typedef.hpp>
+#include <boost/test/unit_test_log_formatter.hpp>
+#include <boost/test/utils/basic_cstring/basic_cstring.hpp>
+
+// Boost
+#include <boost/cstdint.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+
+// STL
+#include <cstddef> // std::size_t
+#include <ostream>
+#include <string>
+#include <vector>
+#include <deque>
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+namespace output {
+
+// ************************************************************************** //
+// **************               binary log records             ************** //
+// ************************************************************************** //
+
+/// The binary log is a sequence of records. Each record is the record type byte, followed by the size of the payload and the payload
+/// itself. The payload is a sequence of operands listed below for each record type:
+/// - numbers are encoded as varints: 7 bits per byte, least significant group first, the high bit set in all the bytes but the last one;
+/// - test unit ids are encoded as numbers id^MIN_TEST_CASE_ID, so that the test case ids take one or two bytes;
+/// - strings are encoded either as the number (size<<1)|1 followed by the characters, or as the number id<<1 referring to the string
+///   defined earlier by STRING record.
+namespace binary_log {
+
+enum record_type {
+    HEADER,             ///< "BTLG" string, format version
+    STRING,             ///< string id, string: defines the string referred to by the following records
+    LOG_START,          ///< test cases amount
+    LOG_FINISH,         ///<
+    BUILD_INFO,         ///< platform, compiler, STL, Boost version
+    UNIT,               ///< test unit id, test unit type, type name, name, file name, line, parent id: defines the test unit
+                        ///< before the first record referring to it; the parent id is INV_TEST_UNIT_ID for the children of the master test suite
+    UNIT_START,         ///< test unit id
+    UNIT_FINISH,        ///< test unit id, wall, user and system time in nanoseconds
+    UNIT_SKIPPED,       ///< test unit id, reason
+    EXCEPTION_START,    ///< test case id, file name, line, function, error code, description,
+                        ///< last checkpoint file name, last checkpoint line, last checkpoint message
+    EXCEPTION_FINISH,   ///<
+    ENTRY_START,        ///< test case id, log entry type, file name, line, log level
+    ENTRY_VALUE,        ///< value
+    ENTRY_FINISH,       ///<
+    CONTEXT_START,      ///< log level
+    CONTEXT_VALUE,      ///< context frame description
+    CONTEXT_FINISH,     ///<
+    CONTENT,            ///< the records written separately, for example by a worker process; the strings they define are not visible
+                        ///< to the records following this one
+    RECORD_TYPES_NUM
+};
+
+/// Number identifying the layout of the records; written by HEADER record
+const unsigned format_version = 1;
+
+} // namespace binary_log
+
+// ************************************************************************** //
+// **************             binary_log_formatter             ************** //
+// ************************************************************************** //
+
+/// Writes the log as a sequence of binary records (see binary_log::record_type). File names, test unit names and short log
+/// entry values are written once into a string table and referred to by id afterwards. The log is meant to be converted into
+/// the human readable, XML or JSON format afterwards using binary_log_reader or the binary_log_decoder tool.
+class BOOST_TEST_DECL binary_log_formatter : public unit_test_log_formatter {
+public:
+    // Constructor
+    binary_log_formatter();
+
+    // Formatter interface
+    void    log_start( std::ostream&, counter_t test_cases_amount );
+    void    log_finish( std::ostream& );
+    void    log_build_info( std::ostream& );
+
+    void    test_unit_start( std::ostream&, test_unit const& tu );
+    void    test_unit_finish( std::ostream&, test_unit const& tu, elapsed_time const& elapsed );
+    void    test_unit_finish( std::ostream&, test_unit const& tu, unsigned long elapsed );
+    void    test_unit_skipped( std::ostream&, test_unit const& tu, const_string reason );
+
+    void    log_exception_start( std::ostream&, log_checkpoint_data const&, execution_exception const& ex );
+    void    log_exception_finish( std::ostream& );
+
+    void    log_entry_start( std::ostream&, log_entry_data const&, log_entry_types let );
+    void    log_entry_value( std::ostream&, const_string value );
+    void    log_entry_value( std::ostream&, lazy_ostream const& value );
+    void    log_entry_finish( std::ostream& );
+
+    void    entry_context_start( std::ostream&, log_level );
+    void    log_entry_context( std::ostream&, const_string );
+    void    entry_context_finish( std::ostream& );
+
+    void    log_content( std::ostream&, const_string content );
+
+private:
+    struct string_hash {
+        std::size_t operator()( const_string s ) const;
+    };
+    typedef unordered_map<const_string,std::size_t,string_hash> string_ids;
+
+    // lazy values are rendered into the buffer reused by all the log entries
+    class value_buffer : public std::streambuf {
+    public:
+        std::string         m_value;
+
+    protected:
+        virtual int_type    overflow( int_type c )
+        {
+            if( !traits_type::eq_int_type( c, traits_type::eof() ) )
+                m_value += traits_type::to_char_type( c );
+
+            return traits_type::not_eof( c );
+        }
+        virtual std::streamsize xsputn( char const* s, std::streamsize n )
+        {
+            m_value.append( s, static_cast<std::size_t>( n ) );
+
+            return n;
+        }
+    };
+
+    // record writing helpers
+    void    set_stream( std::ostream& );
+    void    start_record( std::ostream&, binary_log::record_type type );
+    void    finish_record( std::ostream& );
+    void    append_record( binary_log::record_type type, std::string const& payload );
+    void    put_number( uintmax_t value );
+    void    put_unit_id( test_unit_id id );
+    void    put_string( const_string value, bool intern = true );
+    bool    seen_before( const_string value );
+    void    define_unit( std::ostream&, test_unit_id id );
+
+    // Data members
+    std::string                     m_record;       // payload of the record being written
+    binary_log::record_type         m_record_type;
+    std::string                     m_definition;   // payload of the string definition written ahead of the current record
+    std::string                     m_output;       // records to be written into the stream
+    std::ostream*                   m_stream;       // stream the strings and test units were defined in
+
+    string_ids                      m_string_ids;
+    std::deque<std::string>         m_strings;      // keys of m_string_ids refer to these; deque never moves its elements
+    unordered_set<std::size_t>      m_seen_strings; // hashes of the strings written once
+    unordered_set<test_unit_id>     m_defined_units;
+
+    value_buffer                    m_value_buffer;
+    std::ostream                    m_value_stream;
+};
+
+// ************************************************************************** //
+// **************               binary_log_reader              ************** //
+// ************************************************************************** //
+
+/// Reads the records written by binary_log_formatter from a log loaded into memory. The string references are resolved, so each record
+/// is presented as the sequences of its numeric and string operands in the order listed in binary_log::record_type. HEADER, STRING
+/// and CONTENT records are consumed by the reader itself: the records of CONTENT are presented in place of CONTENT record.
+class BOOST_TEST_DECL binary_log_reader {
+public:
+    struct record {
+        binary_log::record_type     m_type;
+        std::vector<uintmax_t>      m_numbers;  ///< numbers and test unit ids in order of appearance
+        std::vector<const_string>   m_strings;  ///< strings in order of appearance; valid until the next call to the reader
+    };
+
+    // Constructor
+    explicit    binary_log_reader( const_string log );
+
+    /// Reads the next record; returns false at the end of the log. Throws std::runtime_error if the log is malformed.
+    bool        next( record& r );
+
+private:
+    struct scope {
+        char const*         m_end;
+        std::size_t         m_undo_size;    // size of m_undo when the scope was entered
+    };
+
+    // reading helpers
+    uintmax_t   get_number( char const*& pos, char const* end );
+    const_string get_string( char const*& pos, char const* end );
+    void        define_string( std::size_t id, const_string value );
+
+    // Data members
+    const_string                    m_log;
+    char const*                     m_pos;
+    std::vector<std::string>        m_strings;
+    std::vector<scope>              m_scopes;
+    std::vector<std::pair<std::size_t,std::string> > m_undo; // string definitions replaced within the scopes
+};
+
+} // namespace output
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_BINARY_LOG_FORMATTER_101615GER
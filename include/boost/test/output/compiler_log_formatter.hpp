@@ -39,6 +39,7 @@ public:
     void    log_build_info( std::ostream& );
 
     void    test_unit_start( std::ostream&, test_unit const& tu );
+    void    test_unit_finish( std::ostream&, test_unit const& tu, elapsed_time const& elapsed );
     void    test_unit_finish( std::ostream&, test_unit const& tu, unsigned long elapsed );
     void    test_unit_skipped( std::ostream&, test_unit const& tu, const_string reason );
 
@@ -56,6 +57,10 @@ public:
 
 protected:
     virtual void    print_prefix( std::ostream&, const_string file, std::size_t line );
+
+private:
+    // Data members
+    elapsed_time    m_elapsed;
 };
 
 } // namespace output
@@ -0,0 +1,84 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : defines OF_JSON log formatter
+// ***************************************************************************
+
+#ifndef BOOST_TEST_JSON_LOG_FORMATTER_101615GER
+#define BOOST_TEST_JSON_LOG_FORMATTER_101615GER
+
+// Boost.Test
+#include <boost/test/detail/global_typedef.hpp>
+#include <boost/test/unit_test_log_formatter.hpp>
+
+// STL
+#include <string>
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+namespace output {
+
+// ************************************************************************** //
+// **************              json_log_formatter              ************** //
+// ************************************************************************** //
+
+/// Writes the log in JSON lines format: each test unit start, finish or skip, log entry, exception and context frame is
+/// a self-contained JSON object on its own line. The log is flushed at least at the test units boundaries (unless the
+/// flush policy is bytes or end), so it can be consumed while the test module is still running.
+class json_log_formatter : public unit_test_log_formatter {
+public:
+    // Constructor
+    json_log_formatter();
+
+    // Formatter interface
+    void    log_start( std::ostream&, counter_t test_cases_amount );
+    void    log_finish( std::ostream& );
+    void    log_build_info( std::ostream& );
+
+    void    test_unit_start( std::ostream&, test_unit const& tu );
+    void    test_unit_finish( std::ostream&, test_unit const& tu, elapsed_time const& elapsed );
+    void    test_unit_finish( std::ostream&, test_unit const& tu, unsigned long elapsed );
+    void    test_unit_skipped( std::ostream&, test_unit const& tu, const_string reason );
+
+    void    log_exception_start( std::ostream&, log_checkpoint_data const&, execution_exception const& ex );
+    void    log_exception_finish( std::ostream& );
+
+    void    log_entry_start( std::ostream&, log_entry_data const&, log_entry_types let );
+    using   unit_test_log_formatter::log_entry_value; // bring base class functions into overload set
+    void    log_entry_value( std::ostream&, const_string value );
+    void    log_entry_finish( std::ostream& );
+
+    void    entry_context_start( std::ostream&, log_level );
+    void    log_entry_context( std::ostream&, const_string );
+    void    entry_context_finish( std::ostream& );
+
+private:
+    void    print_unit( std::ostream&, char const* event, test_unit const& tu );
+    void    print_test_case( std::ostream& );
+    void    close_entry( std::ostream& );
+
+    // Data members
+    bool            m_entry_open;           // the message of the current entry is being written
+    test_unit_id    m_test_case_id;         // test case m_test_case_name belongs to
+    std::string     m_test_case_name;
+};
+
+} // namespace output
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_JSON_LOG_FORMATTER_101615GER
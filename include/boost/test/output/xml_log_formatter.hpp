@@ -42,6 +42,7 @@ public:
     void    log_build_info( std::ostream& );
 
     void    test_unit_start( std::ostream&, test_unit const& tu );
+    void    test_unit_finish( std::ostream&, test_unit const& tu, elapsed_time const& elapsed );
     void    test_unit_finish( std::ostream&, test_unit const& tu, unsigned long elapsed );
     void    test_unit_skipped( std::ostream&, test_unit const& tu, const_string reason );
 
@@ -61,6 +62,7 @@ private:
     // Data members
     const_string    m_curr_tag;
     bool            m_value_closed;
+    elapsed_time    m_elapsed;
 };
 
 } // namespace output
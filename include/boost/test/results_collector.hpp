@@ -23,6 +23,9 @@
 #include <boost/test/utils/trivial_singleton.hpp>
 #include <boost/test/utils/class_properties.hpp>
 
+// STL
+#include <iosfwd>
+
 #include <boost/test/detail/suppress_warnings.hpp>
 
 //____________________________________________________________________________//
@@ -56,6 +59,8 @@ public:
     typedef BOOST_READONLY_PROPERTY( counter_t, (results_collector_t)(test_results)(results_collect_helper) ) counter_prop;
     /// Type representing boolean like public property
     typedef BOOST_READONLY_PROPERTY( bool,      (results_collector_t)(test_results)(results_collect_helper) ) bool_prop;
+    /// Type representing resource usage public property
+    typedef BOOST_READONLY_PROPERTY( resource_usage, (results_collector_t)(test_results)(results_collect_helper) ) usage_prop;
 
     /// @name Public properties
     counter_prop    p_assertions_passed;
@@ -69,6 +74,8 @@ public:
     counter_prop    p_test_cases_aborted;
     bool_prop       p_aborted;
     bool_prop       p_skipped;
+    /// Resources used by the test case, including its fixtures; the sum of the ones of the test cases for a test suite
+    usage_prop      p_resource_usage;
     /// @}
 
     /// @name Summary conclusion
@@ -99,6 +106,7 @@ public:
     virtual void        test_start( counter_t test_cases_amount );
 
     virtual void        test_unit_start( test_unit const& );
+    virtual void        test_unit_finish( test_unit const&, elapsed_time const&, resource_usage const& );
     virtual void        test_unit_finish( test_unit const&, unsigned long );
     virtual void        test_unit_skipped( test_unit const&, const_string );
     virtual void        test_unit_aborted( test_unit const& );
@@ -113,6 +121,28 @@ public:
     /// @param[in] tu_id id of a test unit
     test_results const& results( test_unit_id tu_id ) const;
 
+    /// Writes results of all enabled test units in a test tree into a stream
+
+    /// This is used to transfer results collected by a worker process back into the main one
+    /// @param[in] tu_id id of the test tree root
+    /// @param[in] ostr stream to write results into
+    void                save_results( test_unit_id tu_id, std::ostream& ostr ) const;
+
+    /// Reads results previously written by save_results and stores them
+
+    /// @param[in] istr stream to read results from
+    /// @returns false if results can't be read
+    bool                load_results( std::istream& istr );
+
+    /// Adds assertion results counted outside of the collector to the results of a test case
+
+    /// This is used to merge assertions counted by a thread executing the test case concurrently
+    /// @param[in] tu_id id of the test case
+    /// @param[in] passed number of passed assertions
+    /// @param[in] failed number of failed assertions
+    /// @param[in] warnings number of failed warnings
+    void                add_assertion_results( test_unit_id tu_id, counter_t passed, counter_t failed, counter_t warnings );
+
 private:
     BOOST_TEST_SINGLETON_CONS( results_collector_t )
 };
@@ -0,0 +1,140 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//! @file
+//! @brief defines portable timer measuring both wall clock and CPU time
+//!
+//! Wall clock time is measured using the monotonic clock, so it is not affected by adjustments of the system time.
+//! CPU time is the time spent by all the threads of the process, separately in user and in kernel mode.
+// ***************************************************************************
+
+#ifndef BOOST_TEST_TIMER_HPP_101915GER
+#define BOOST_TEST_TIMER_HPP_101915GER
+
+// Boost.Test
+#include <boost/test/detail/config.hpp>
+
+// Boost
+#include <boost/cstdint.hpp>
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+
+// ************************************************************************** //
+// **************                 elapsed_time                 ************** //
+// ************************************************************************** //
+
+/// Wall clock and CPU times in nanoseconds
+
+/// Actual resolution depends on the system; CPU time is usually measured with microsecond resolution at best
+struct elapsed_time {
+    typedef boost::uint64_t nanoseconds;
+
+    elapsed_time() : wall( 0 ), user( 0 ), system( 0 ) {}
+
+    nanoseconds     wall;   ///< monotonic wall clock time
+    nanoseconds     user;   ///< CPU time spent by the process in user mode
+    nanoseconds     system; ///< CPU time spent by the process in kernel mode
+
+    /// Wall clock time in microseconds
+    unsigned long   microseconds() const    { return static_cast<unsigned long>( wall / 1000 ); }
+    /// Wall clock time in seconds
+    double          seconds() const         { return static_cast<double>( wall ) / 1e9; }
+};
+
+// ************************************************************************** //
+/// Returns the current reading of the monotonic clock and the CPU times consumed by the process so far
+
+/// Only the differences between the readings are meaningful
+// ************************************************************************** //
+
+BOOST_TEST_DECL elapsed_time current_time();
+
+// ************************************************************************** //
+// **************                process_timer                 ************** //
+// ************************************************************************** //
+
+/// Measures the wall clock and CPU times elapsed since its construction or the last restart
+class BOOST_TEST_DECL process_timer {
+public:
+    process_timer() : m_start( current_time() ) {}
+
+    /// Starts measuring from now on
+    void            restart()               { m_start = current_time(); }
+
+    /// Returns the times elapsed since the start
+    elapsed_time    elapsed() const;
+
+private:
+    // Data members
+    elapsed_time    m_start;
+};
+
+// ************************************************************************** //
+// **************                resource_usage                ************** //
+// ************************************************************************** //
+
+/// Resource usage counters of the process or of a thread
+
+/// The counters are available on POSIX systems only and are zero elsewhere. For the usage of a test unit, max_rss is the
+/// growth of the peak resident set size during its execution and the rest of the counters are the differences
+struct resource_usage {
+    typedef boost::uint64_t counter;
+
+    resource_usage()
+    : max_rss( 0 ), minor_faults( 0 ), major_faults( 0 )
+    , voluntary_switches( 0 ), involuntary_switches( 0 ), block_inputs( 0 ), block_outputs( 0 )
+    {}
+
+    counter         max_rss;                ///< peak resident set size in kilobytes
+    counter         minor_faults;           ///< page faults serviced without any I/O
+    counter         major_faults;           ///< page faults which required I/O
+    counter         voluntary_switches;     ///< context switches due to waiting for a resource
+    counter         involuntary_switches;   ///< context switches due to the preemption
+    counter         block_inputs;           ///< block input operations of the file system
+    counter         block_outputs;          ///< block output operations of the file system
+};
+
+// ************************************************************************** //
+/// Returns the resource usage counters of the process or, where supported, of the calling thread only
+
+/// The peak resident set size is the one of the process in either case
+// ************************************************************************** //
+
+BOOST_TEST_DECL resource_usage current_resource_usage( bool calling_thread = false );
+
+// ************************************************************************** //
+// **************                resource_meter                ************** //
+// ************************************************************************** //
+
+/// Measures the resource usage since its construction
+class BOOST_TEST_DECL resource_meter {
+public:
+    explicit        resource_meter( bool calling_thread = false )
+    : m_calling_thread( calling_thread )
+    , m_start( current_resource_usage( calling_thread ) )
+    {}
+
+    /// Returns the resources used since the start
+    resource_usage  usage() const;
+
+private:
+    // Data members
+    bool            m_calling_thread;
+    resource_usage  m_start;
+};
+
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_TIMER_HPP_101915GER
@@ -0,0 +1,120 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief defines persistent storage for the history of test units durations
+// ***************************************************************************
+
+#ifndef BOOST_TEST_TIMING_DB_HPP_101615GER
+#define BOOST_TEST_TIMING_DB_HPP_101615GER
+
+// Boost.Test
+#include <boost/test/tree/observer.hpp>
+#include <boost/test/utils/trivial_singleton.hpp>
+
+// STL
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+
+// ************************************************************************** //
+// **************                 timing_record                ************** //
+// ************************************************************************** //
+
+/// Durations of a test unit recorded during the last runs
+struct BOOST_TEST_DECL timing_record {
+    /// Number of the most recent durations kept in the history
+    static const std::size_t history_size = 10;
+
+    timing_record() : m_mean( 0 ), m_variance( 0 ) {}
+
+    /// Adds a duration to the history, dropping the oldest one if necessary, and updates the statistics
+
+    /// @param[in] elapsed duration in microseconds
+    void                        add( unsigned long elapsed );
+
+    // Data members
+    std::vector<unsigned long>  m_durations;    ///< durations in microseconds, the most recent one last
+    double                      m_mean;         ///< mean of the durations in the history
+    double                      m_variance;     ///< sample variance of the durations in the history
+};
+
+// ************************************************************************** //
+// **************                   timing_db                  ************** //
+// ************************************************************************** //
+
+/// This class implements test observer interface to keep a rolling history of test units durations in a file
+
+/// The file is a compact binary one. All the integers are little endian, and floating point values are stored as
+/// IEEE 754 doubles with the same byte order:
+/// @code
+/// header: "BTTD", uint32 version, uint32 history size, uint32 number of records
+/// record: uint32 name length, name (full test unit name), uint32 number of durations, uint64 durations[],
+///         double mean, double variance
+/// @endcode
+class BOOST_TEST_DECL timing_db_t : public test_observer, public singleton<timing_db_t> {
+public:
+    typedef std::map<std::string,timing_record> records_t;
+
+    /// @name Test observer interface
+    /// @{
+    virtual void            test_finish();
+
+    virtual void            test_unit_finish( test_unit const&, unsigned long );
+
+    virtual int             priority() { return 4; }
+    /// @}
+
+    /// Reads the history from a file; the same file is updated at the end of the test run
+
+    /// @param[in] file_name file to read the history from
+    /// @returns false if the file exists, but can't be read
+    bool                    load( std::string const& file_name );
+
+    /// Writes the history into a file
+
+    /// @param[in] file_name file to write the history into
+    /// @returns false if the file can't be written
+    bool                    save( std::string const& file_name ) const;
+
+    /// Reads the history from a file, without attaching the database to it
+
+    /// @param[in]  file_name file to read the history from
+    /// @param[out] records   history read from the file; left unchanged if the file can't be read
+    /// @returns false if the file does not exist or can't be read
+    static bool             read( std::string const& file_name, records_t& records );
+
+    /// Timing history of a test unit
+
+    /// @param[in] full_name full name of the test unit
+    /// @returns null if there is no history for the test unit
+    timing_record const*    record( std::string const& full_name ) const;
+
+    /// Timing history of all test units
+    records_t const&        records() const;
+
+private:
+    BOOST_TEST_SINGLETON_CONS( timing_db_t )
+}; // timing_db_t
+
+BOOST_TEST_SINGLETON_INST( timing_db )
+
+} // namespace unit_test
+} // namespace boost
+
+//____________________________________________________________________________//
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_TIMING_DB_HPP_101615GER
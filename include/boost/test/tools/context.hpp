@@ -16,8 +16,13 @@
 #define BOOST_TEST_TOOLS_CONTEXT_HPP_111712GER
 
 // Boost.Test
+#include <boost/test/framework.hpp>
 #include <boost/test/utils/lazy_ostream.hpp>
 
+// Boost
+#include <boost/make_shared.hpp>
+#include <boost/mpl/bool.hpp>
+
 #include <boost/test/detail/suppress_warnings.hpp>
 
 //____________________________________________________________________________//
@@ -32,6 +37,7 @@ namespace tt_detail {
 
 struct BOOST_TEST_DECL context_frame {
     explicit    context_frame( ::boost::unit_test::lazy_ostream const& context_descr );
+    explicit    context_frame( int frame_id ) : m_frame_id( frame_id ) {}
     ~context_frame();
 
     operator    bool();
@@ -43,15 +49,55 @@ private:
 
 //____________________________________________________________________________//
 
-#define BOOST_TEST_INFO( context_descr )                                                        \
-    ::boost::unit_test::framework::add_context( BOOST_TEST_LAZY_MSG( context_descr ) , false )  \
+// ************************************************************************** //
+// **************               add_lazy_context               ************** //
+// ************************************************************************** //
+
+// The context is formatted only when it is reported along with a failure;
+// until then the frame holds copies of the values the description refers to.
+// A description printing values which can't be copied safely is formatted at once.
+template<typename LazyOstream>
+inline int
+add_lazy_context( LazyOstream const& context_descr, bool sticky, mpl::true_ )
+{
+    typedef ::boost::unit_test::lazy_ostream_capture<LazyOstream> capture;
+
+    return ::boost::unit_test::framework::add_context(
+        ::boost::make_shared<typename capture::type const>( capture::make( context_descr ) ), sticky );
+}
+
+//____________________________________________________________________________//
+
+template<typename LazyOstream>
+inline int
+add_lazy_context( LazyOstream const& context_descr, bool sticky, mpl::false_ )
+{
+    return ::boost::unit_test::framework::add_context( context_descr, sticky );
+}
+
+//____________________________________________________________________________//
+
+template<typename LazyOstream>
+inline int
+add_lazy_context( LazyOstream const& context_descr, bool sticky )
+{
+    typedef ::boost::unit_test::lazy_ostream_capture<LazyOstream> capture;
+
+    return add_lazy_context( context_descr, sticky, mpl::bool_<capture::value>() );
+}
+
+//____________________________________________________________________________//
+
+#define BOOST_TEST_INFO( context_descr )                                                            \
+    ::boost::test_tools::tt_detail::add_lazy_context( BOOST_TEST_LAZY_MSG( context_descr ), false ) \
 /**/
 
 //____________________________________________________________________________//
 
-#define BOOST_TEST_CONTEXT( context_descr )                                                     \
-    if( ::boost::test_tools::tt_detail::context_frame BOOST_JOIN( context_frame_, __LINE__ ) =  \
-        ::boost::test_tools::tt_detail::context_frame( BOOST_TEST_LAZY_MSG( context_descr ) ) ) \
+#define BOOST_TEST_CONTEXT( context_descr )                                                         \
+    if( ::boost::test_tools::tt_detail::context_frame BOOST_JOIN( context_frame_, __LINE__ ) =      \
+        ::boost::test_tools::tt_detail::context_frame(                                              \
+            ::boost::test_tools::tt_detail::add_lazy_context( BOOST_TEST_LAZY_MSG( context_descr ), true ) ) ) \
 /**/
 
 //____________________________________________________________________________//
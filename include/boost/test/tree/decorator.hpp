@@ -137,6 +137,23 @@ private:
     unsigned                m_timeout;
 };
 
+// ************************************************************************** //
+// **************             decorator::timeout_ms            ************** //
+// ************************************************************************** //
+
+class BOOST_TEST_DECL timeout_ms : public decorator::base {
+public:
+    explicit                timeout_ms( unsigned t ) : m_timeout( t ) {}
+
+private:
+    // decorator::base interface
+    virtual void            apply( test_unit& tu );
+    virtual base_ptr        clone() const { return base_ptr(new timeout_ms( m_timeout )); }
+
+    // Data members
+    unsigned                m_timeout;
+};
+
 // ************************************************************************** //
 // **************            decorator::description            ************** //
 // ************************************************************************** //
@@ -256,11 +273,23 @@ private:
     predicate_t             m_precondition;
 };
 
+// ************************************************************************** //
+// **************            decorator::concurrent             ************** //
+// ************************************************************************** //
+
+class BOOST_TEST_DECL concurrent : public decorator::base {
+private:
+    // decorator::base interface
+    virtual void            apply( test_unit& tu );
+    virtual base_ptr        clone() const { return base_ptr(new concurrent()); }
+};
+
 } // namespace decorator
 
 using decorator::label;
 using decorator::expected_failures;
 using decorator::timeout;
+using decorator::timeout_ms;
 using decorator::description;
 using decorator::depends_on;
 using decorator::enable_if;
@@ -268,6 +297,7 @@ using decorator::enabled;
 using decorator::disabled;
 using decorator::fixture;
 using decorator::precondition;
+using decorator::concurrent;
 
 } // namespace unit_test
 } // namespace boost
@@ -16,6 +16,7 @@
 #include <boost/test/detail/fwd_decl.hpp>
 #include <boost/test/detail/global_typedef.hpp>
 #include <boost/test/detail/config.hpp>
+#include <boost/test/timer.hpp>
 
 #include <boost/test/detail/suppress_warnings.hpp>
 
@@ -36,7 +37,9 @@ public:
     virtual void    test_aborted() {}
 
     virtual void    test_unit_start( test_unit const& ) {}
-    virtual void    test_unit_finish( test_unit const&, unsigned long /* elapsed */ ) {}
+    virtual void    test_unit_finish( test_unit const& tu, elapsed_time const& elapsed, resource_usage const& ) { test_unit_finish( tu, elapsed ); }
+    virtual void    test_unit_finish( test_unit const& tu, elapsed_time const& elapsed ) { test_unit_finish( tu, elapsed.microseconds() ); }
+    virtual void    test_unit_finish( test_unit const&, unsigned long /* elapsed */ ) {} ///< backward compartibility
     virtual void    test_unit_skipped( test_unit const& tu, const_string ) { test_unit_skipped( tu ); }
     virtual void    test_unit_skipped( test_unit const& ) {} ///< backward compartibility
     virtual void    test_unit_aborted( test_unit const& ) {}
@@ -0,0 +1,123 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : defines the descriptors of the statically registered test units
+// ***************************************************************************
+
+#ifndef BOOST_TEST_TREE_STATIC_REGISTRATION_HPP_071215GER
+#define BOOST_TEST_TREE_STATIC_REGISTRATION_HPP_071215GER
+
+// Boost.Test
+#include <boost/test/detail/config.hpp>
+#include <boost/test/tree/decorator.hpp>
+
+// STL
+#include <cstddef>
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+// The static registration places the descriptors of the test units into a dedicated section, which the linker
+// gathers into one table per module. It is available for the ELF targets of GCC and Clang; elsewhere the test units
+// are registered by static objects as usual even if BOOST_TEST_STATIC_REGISTRATION is defined.
+#if defined(BOOST_TEST_STATIC_REGISTRATION) && defined(__ELF__) && defined(__GNUC__)
+#define BOOST_TEST_IMPL_STATIC_REGISTRATION
+#endif
+
+namespace boost {
+namespace unit_test {
+namespace ut_detail {
+
+// ************************************************************************** //
+// **************               static_test_unit               ************** //
+// ************************************************************************** //
+
+/// Constant initialized descriptor of a test unit registration
+
+/// The descriptors are replayed in their order within the translation unit at the framework initialization, with
+/// the same effect the registrar objects have during the dynamic initialization.
+struct static_test_unit {
+    enum kind_t { TEST_CASE, SUITE_BEGIN, SUITE_END, REGISTRATION };
+
+    typedef decorator::collector& (*decorators_t)();
+
+    void const*     m_tu;           ///< identifies the translation unit; 0 for the padding the linker may add
+    unsigned        m_order;        ///< order within the translation unit
+    unsigned        m_kind;
+    char const*     m_name;
+    char const*     m_file;
+    std::size_t     m_line;
+    void            (*m_func)();    ///< test case body, or the function doing any other registration
+    decorators_t    m_decorators;
+};
+
+// ************************************************************************** //
+// **************          static_test_units_registrar         ************** //
+// ************************************************************************** //
+
+/// Remembers the table of the descriptors of a module
+
+/// Every translation unit using the static registration has one such object, which is constructed during the
+/// dynamic initialization; the test units themselves are registered by framework::init.
+struct BOOST_TEST_DECL static_test_units_registrar {
+                static_test_units_registrar( static_test_unit const* begin, static_test_unit const* end );
+
+    /// Registers the test units of all the tables not registered yet
+    static void register_test_units();
+};
+
+} // namespace ut_detail
+} // namespace unit_test
+} // namespace boost
+
+#ifdef BOOST_TEST_IMPL_STATIC_REGISTRATION
+
+// bounds of the section, defined by the linker in every module which has it
+extern "C" {
+extern boost::unit_test::ut_detail::static_test_unit const __start_boost_test_units[] __attribute__((weak, visibility("hidden")));
+extern boost::unit_test::ut_detail::static_test_unit const __stop_boost_test_units[] __attribute__((weak, visibility("hidden")));
+}
+
+namespace boost {
+namespace unit_test {
+namespace ut_detail {
+namespace {
+
+static_test_units_registrar const s_static_test_units( __start_boost_test_units, __stop_boost_test_units );
+
+} // local namespace
+} // namespace ut_detail
+} // namespace unit_test
+} // namespace boost
+
+#if defined(__COUNTER__)
+#define BOOST_TEST_STATIC_UNIT_ORDER __COUNTER__
+#else
+#define BOOST_TEST_STATIC_UNIT_ORDER __LINE__
+#endif
+
+// the explicit alignment keeps the compiler from padding the descriptors, so the section is an array of them
+#define BOOST_TEST_STATIC_UNIT( var_name, kind, name, file, line, func, decorators )                  \
+static ::boost::unit_test::ut_detail::static_test_unit const var_name                                 \
+__attribute__((used, section("boost_test_units"),                                                     \
+               aligned(__alignof__(::boost::unit_test::ut_detail::static_test_unit)))) = {            \
+    &::boost::unit_test::ut_detail::s_static_test_units,                                              \
+    BOOST_TEST_STATIC_UNIT_ORDER,                                                                     \
+    ::boost::unit_test::ut_detail::static_test_unit::kind,                                            \
+    name, file, line, func, decorators }                                                              \
+/**/
+
+#endif // BOOST_TEST_IMPL_STATIC_REGISTRATION
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_TREE_STATIC_REGISTRATION_HPP_071215GER
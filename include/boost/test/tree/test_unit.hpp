@@ -97,7 +97,9 @@ public:
     readwrite_property<std::string>     p_name;                 ///< name for this test unit
     readwrite_property<std::string>     p_description;          ///< description for this test unit
     readwrite_property<unsigned>        p_timeout;              ///< timeout for the test unit execution in seconds
+    readwrite_property<unsigned>        p_timeout_ms;           ///< timeout in milliseconds; takes precedence over p_timeout if non-zero
     readwrite_property<counter_t>       p_expected_failures;    ///< number of expected failures in this test unit
+    readwrite_property<bool>            p_concurrent;           ///< test cases of this unit may be executed concurrently with each other
 
     readwrite_property<run_status>      p_default_status;       ///< run status obtained by this unit during setup phase
     readwrite_property<run_status>      p_run_status;           ///< run status assigned to this unit before execution phase after applying all filters
@@ -29,6 +29,8 @@
 
 // STL
 #include <iosfwd>   // for std::ostream&
+#include <cstddef>  // std::size_t
+#include <vector>
 
 #include <boost/test/detail/suppress_warnings.hpp>
 
@@ -93,6 +95,7 @@ public:
     virtual void        test_aborted();
 
     virtual void        test_unit_start( test_unit const& );
+    virtual void        test_unit_finish( test_unit const&, elapsed_time const& elapsed );
     virtual void        test_unit_finish( test_unit const&, unsigned long elapsed );
     virtual void        test_unit_skipped( test_unit const&, const_string );
 
@@ -100,11 +103,27 @@ public:
 
     virtual int         priority() { return 1; }
 
-    // log configuration methods
+    // log configuration methods; the log is written into one or more sinks, one per format, each with its
+    // own stream and threshold level. The methods without the format apply to all the sinks
     void                set_stream( std::ostream& );
+    void                set_stream( output_format, std::ostream& );
     void                set_threshold_level( log_level );
+    void                set_threshold_level( output_format, log_level );
+    // the lowest threshold level of all the sinks
+    log_level           threshold_level() const;
+    // replaces all the sinks with the single one, which keeps the stream and level of the first sink
     void                set_format( output_format );
     void                set_formatter( unit_test_log_formatter* );
+    // adds the sink writing into the default log sink with the default level, unless the format is there already
+    void                add_format( output_format );
+    // formats and writes the log in a background thread; the test thread only queues the log events
+    void                set_async( bool );
+    // the log is collected in a user-space buffer of each sink and written into its stream at the flush points of
+    // the policy; the buffer size is only used by FLUSH_BYTES policy
+    void                set_flush_policy( flush_mode, std::size_t buffer_size = 0 );
+    // keeps up to limit bytes of the log of each test case in memory and writes it only if the test case fails; with
+    // 0 limit the log is written as it goes
+    void                set_flight_recorder( std::size_t limit );
 
     // test progress logging
     void                set_checkpoint( const_string file, std::size_t line_num, const_string msg = const_string() );
@@ -118,10 +137,16 @@ public:
 
     ut_detail::entry_value_collector operator()( log_level );   // initiate entry collection
 
+    // formats of the sinks the log is written into
+    std::vector<output_format> formats() const;
+    // writes already formatted log content (for example produced by a worker process) as is into the sink
+    void                append( output_format, const_string content );
+    // waits until the queued log events are written and flushes the stream
+    void                flush();
+
 private:
     // Implementation helpers
     bool                log_entry_start();
-    void                log_entry_context( log_level l );
     void                clear_entry_context();
 
     BOOST_TEST_SINGLETON_CONS( unit_test_log_t )
@@ -19,6 +19,7 @@
 #include <boost/test/detail/global_typedef.hpp>
 #include <boost/test/detail/log_level.hpp>
 #include <boost/test/detail/fwd_decl.hpp>
+#include <boost/test/timer.hpp>
 
 // STL
 #include <iosfwd>
@@ -132,8 +133,14 @@ public:
 
     /// @param[in] os   output stream to write a messages into
     /// @param[in] tu   test unit being finished
-    /// @param[in] elapsed time in milliseconds spend executing this test unit
+    /// @param[in] elapsed wall clock and CPU times spent executing this test unit
     /// @see test_unit_start
+    virtual void        test_unit_finish( std::ostream& os, test_unit const& tu, elapsed_time const& elapsed )
+    {
+        test_unit_finish( os, tu, elapsed.microseconds() );
+    }
+
+    /// Version of this interface reporting wall clock time in microseconds only
     virtual void        test_unit_finish( std::ostream& os, test_unit const& tu, unsigned long elapsed ) = 0;
 
     /// Invoked if test unit skipped for any reason
@@ -235,6 +242,16 @@ public:
     /// @see log_entry_start, entry_context_context
     virtual void        entry_context_finish( std::ostream& os ) = 0;
     // @}
+
+    // @name Log written separately
+
+    /// Invoked by Unit Test Framework to write the log produced separately by the formatter of the same kind, for example by a worker process
+
+    /// Default implementation writes the content as is.
+    /// @param[in] os   output stream to write a messages into
+    /// @param[in] content  log formatted by the formatter of the same kind
+    virtual void        log_content( std::ostream& os, const_string content );
+    // @}
 };
 
 } // namespace unit_test
@@ -43,11 +43,24 @@ public:
 
     static bool is_critical_error( error_level e ) { return e <= fatal_error; }
 
-    // monitor method
+    // monitor method; timeout is in seconds
     error_level execute_and_translate( boost::function<void ()> const& func, unsigned timeout = 0 );
 
+    // monitor method; timeout is in milliseconds
+    error_level execute_and_translate_ms( boost::function<void ()> const& func, unsigned timeout_ms );
+
+    // starts the monitoring session configured by the runtime parameters; outside of the session
+    // they are re-read on every call
+    void        start_session();
+
+    // executes the function using execution monitor configured by the caller
+    static error_level execute_and_translate( execution_monitor& em, boost::function<void ()> const& func );
+
 private:
     BOOST_TEST_SINGLETON_CONS( unit_test_monitor_t )
+
+    // implementation helpers
+    void        configure();
 };
 
 BOOST_TEST_SINGLETON_INST( unit_test_monitor )
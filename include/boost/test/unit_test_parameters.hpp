@@ -16,12 +16,14 @@
 
 #include <boost/test/detail/global_typedef.hpp>
 #include <boost/test/detail/log_level.hpp>
+#include <boost/test/timer.hpp>
 
 #include <boost/test/detail/suppress_warnings.hpp>
 
 // STL
 #include <iosfwd>
 #include <list>
+#include <cstddef> // std::size_t
 
 //____________________________________________________________________________//
 
@@ -33,8 +35,11 @@ namespace runtime_config {
 // **************                 runtime_config               ************** //
 // ************************************************************************** //
 
+/// Resolves all the parameters from the command line, environment and configuration file; the accessors below return these values
 BOOST_TEST_DECL void                    init( int& argc, char** argv );
 
+/// Should the log be formatted and written by a background thread?
+BOOST_TEST_DECL bool                    async_log();
 /// Automatically attach debugger in a location of fatal error
 BOOST_TEST_DECL bool                    auto_start_dbg();
 BOOST_TEST_DECL const_string            break_exec_path();
@@ -46,16 +51,42 @@ BOOST_TEST_DECL bool                    color_output();
 BOOST_TEST_DECL bool                    detect_fp_exceptions();
 /// Should we detect memory leaks (>0)? And if yes, which specific memory allocation should we break.
 BOOST_TEST_DECL long                    detect_memory_leaks();
+/// Amount of the log of each test case (in KB) kept in memory and written only if the test case fails (0 - the log is
+/// written as it goes)
+BOOST_TEST_DECL unsigned                flight_recorder();
+/// Should we execute each test case in a separate worker process?
+BOOST_TEST_DECL bool                    isolate();
+/// Number of worker processes used to execute independent test units
+BOOST_TEST_DECL unsigned                jobs();
 /// List content of test tree?
 BOOST_TEST_DECL output_format           list_content();
 /// List available labels?
 BOOST_TEST_DECL bool                    list_labels();
+/// When the buffered log, report and progress output is flushed
+BOOST_TEST_DECL flush_mode              log_flush();
+/// Amount of the output buffered before it is flushed with FLUSH_BYTES policy
+BOOST_TEST_DECL std::size_t             log_flush_bytes();
 /// Which output format to use
 BOOST_TEST_DECL output_format           log_format();
 /// Which log level to set
 BOOST_TEST_DECL unit_test::log_level    log_level();
 /// Where to direct log stream into
 BOOST_TEST_DECL std::ostream*           log_sink();
+/// File descriptor to write into the log file opened for the stream from a signal handler (-1 - not a log file)
+BOOST_TEST_DECL int                     log_file_descriptor( std::ostream const* log_stream );
+
+/// Log sink specified with the logger parameter
+struct logger_spec {
+    output_format           m_format;
+    unit_test::log_level    m_level;
+    std::ostream*           m_sink;
+};
+
+/// Sinks to write the log into, each with its own format and level. Unless the logger parameter is specified, this is
+/// the single sink defined by log_format, log_level and log_sink
+BOOST_TEST_DECL std::list<logger_spec>  loggers();
+/// Number of failed test cases after which the rest of test units are skipped (0 - no limit, 1 with fail_fast)
+BOOST_TEST_DECL unsigned                max_failures();
 /// If memory leak detection, where to direct the report
 BOOST_TEST_DECL const_string            memory_leaks_report_file();
 /// Do not prodce result code
@@ -66,16 +97,28 @@ BOOST_TEST_DECL unsigned                random_seed();
 BOOST_TEST_DECL output_format           report_format();
 /// Wht lever of report format to set
 BOOST_TEST_DECL unit_test::report_level report_level();
+/// Should the detailed report include the resource usage of the test units?
+BOOST_TEST_DECL bool                    report_resource_usage();
 /// Where to direct results report into
 BOOST_TEST_DECL std::ostream*           report_sink();
+/// File to keep the list of failed test cases in; only these test cases are run if the list is not empty
+BOOST_TEST_DECL std::string             rerun_failed();
+/// Resources a test case may use before it is failed (0 - no limit for the counter)
+BOOST_TEST_DECL resource_usage const&   resource_budget();
 /// Should we save pattern (true) or match against existing pattern (used by output validation tool)
 BOOST_TEST_DECL bool                    save_pattern();
+/// Part of the test cases to run, specified as i/n (run i-th out of n disjoint parts)
+BOOST_TEST_DECL std::string             shard();
+/// Timing history file used to balance the shards by the test cases durations; never written
+BOOST_TEST_DECL std::string             balance_shards();
 /// Should Unit Test framework show the build information?
 BOOST_TEST_DECL bool                    show_build_info();
 /// Tells Unit Test Framework to show test progress (forces specific log level)
 BOOST_TEST_DECL bool                    show_progress();
 /// Specific test units to run/exclude
 BOOST_TEST_DECL std::list<std::string> const& test_to_run();
+/// File to keep the history of test units durations in
+BOOST_TEST_DECL std::string             timing_db();
 /// Should execution monitor use alternative stack for signal handling
 BOOST_TEST_DECL bool                    use_alt_stack();
 /// Tells Unit Test Framework to wait for debugger to attach
@@ -15,6 +15,7 @@
 // Boost.Test
 #include <boost/test/framework.hpp>
 #include <boost/test/tree/auto_registration.hpp>
+#include <boost/test/tree/static_registration.hpp>
 #include <boost/test/tree/test_case_template.hpp>
 #include <boost/test/tree/global_fixture.hpp>
 
@@ -46,18 +47,21 @@ boost::unit_test::make_test_case( (test_function),                         \
 // **************             BOOST_AUTO_TEST_SUITE            ************** //
 // ************************************************************************** //
 
-#define BOOST_AUTO_TEST_SUITE_WITH_DECOR( suite_name, decorators )      \
+#define BOOST_AUTO_TEST_SUITE_IMPL( suite_name, decorators_func )      \
 namespace suite_name {                                                  \
-BOOST_AUTO_TU_REGISTRAR( suite_name )(                                  \
-    BOOST_STRINGIZE( suite_name ),                                      \
-    __FILE__, __LINE__,                                                 \
-    decorators );                                                       \
+BOOST_AUTO_TS_REGISTRAR( suite_name, decorators_func );                 \
+/**/
+
+#define BOOST_AUTO_TEST_SUITE_WITH_DECOR( suite_name, decorators )      \
+BOOST_AUTO_TU_DECORATORS( suite_name, decorators )                      \
+BOOST_AUTO_TEST_SUITE_IMPL( suite_name,                                 \
+    &BOOST_AUTO_TU_DECORATORS_FUNC( suite_name ) )                      \
 /**/
 
 #define BOOST_AUTO_TEST_SUITE_NO_DECOR( suite_name )                    \
-    BOOST_AUTO_TEST_SUITE_WITH_DECOR(                                   \
+    BOOST_AUTO_TEST_SUITE_IMPL(                                         \
         suite_name,                                                     \
-        boost::unit_test::decorator::collector::instance() )            \
+        &boost::unit_test::decorator::collector::instance )             \
 /**/
 
 #if BOOST_PP_VARIADICS
@@ -115,7 +119,7 @@ typedef F BOOST_AUTO_TEST_CASE_FIXTURE;                                 \
 // ************************************************************************** //
 
 #define BOOST_AUTO_TEST_SUITE_END()                                     \
-BOOST_AUTO_TU_REGISTRAR( BOOST_JOIN( end_suite, __LINE__ ) )( 1 );      \
+BOOST_AUTO_TS_END_REGISTRAR( BOOST_JOIN( end_suite, __LINE__ ) );       \
 }                                                                       \
 /**/
 
@@ -132,7 +136,7 @@ BOOST_TEST_DECORATOR( * boost::unit_test::expected_failures( n ) )      \
 // **************            BOOST_FIXTURE_TEST_CASE           ************** //
 // ************************************************************************** //
 
-#define BOOST_FIXTURE_TEST_CASE_WITH_DECOR( test_name, F, decorators )  \
+#define BOOST_FIXTURE_TEST_CASE_IMPL( test_name, F, decorators_func )   \
 struct test_name : public F { void test_method(); };                    \
                                                                         \
 static void BOOST_AUTO_TC_INVOKER( test_name )()                        \
@@ -146,18 +150,20 @@ static void BOOST_AUTO_TC_INVOKER( test_name )()                        \
                                                                         \
 struct BOOST_AUTO_TC_UNIQUE_ID( test_name ) {};                         \
                                                                         \
-BOOST_AUTO_TU_REGISTRAR( test_name )(                                   \
-    boost::unit_test::make_test_case(                                   \
-        &BOOST_AUTO_TC_INVOKER( test_name ),                            \
-        #test_name, __FILE__, __LINE__ ),                               \
-        decorators );                                                   \
+BOOST_AUTO_TC_REGISTRAR( test_name, decorators_func );                  \
                                                                         \
 void test_name::test_method()                                           \
 /**/
 
+#define BOOST_FIXTURE_TEST_CASE_WITH_DECOR( test_name, F, decorators )  \
+BOOST_AUTO_TU_DECORATORS( test_name, decorators )                       \
+BOOST_FIXTURE_TEST_CASE_IMPL( test_name, F,                             \
+    &BOOST_AUTO_TU_DECORATORS_FUNC( test_name ) )                       \
+/**/
+
 #define BOOST_FIXTURE_TEST_CASE_NO_DECOR( test_name, F )                \
-BOOST_FIXTURE_TEST_CASE_WITH_DECOR( test_name, F,                       \
-    boost::unit_test::decorator::collector::instance() )                \
+BOOST_FIXTURE_TEST_CASE_IMPL( test_name, F,                             \
+    &boost::unit_test::decorator::collector::instance )                 \
 /**/
 
 #if BOOST_PP_VARIADICS
@@ -231,11 +237,11 @@ struct BOOST_AUTO_TC_INVOKER( test_name ) {                             \
     }                                                                   \
 };                                                                      \
                                                                         \
-BOOST_AUTO_TU_REGISTRAR( test_name )(                                   \
+BOOST_AUTO_TU_REGISTRATION( test_name, (                                \
     boost::unit_test::ut_detail::template_test_case_gen<                \
         BOOST_AUTO_TC_INVOKER( test_name ),TL >(                        \
           BOOST_STRINGIZE( test_name ), __FILE__, __LINE__ ),           \
-    boost::unit_test::decorator::collector::instance() );               \
+    boost::unit_test::decorator::collector::instance() ) );             \
                                                                         \
 template<typename type_name>                                            \
 void test_name<type_name>::test_method()                                \
@@ -291,11 +297,24 @@ static boost::unit_test::ut_detail::global_fixture_impl<F> BOOST_JOIN( gf_, F )
 // **************             BOOST_TEST_DECORATOR             ************** //
 // ************************************************************************** //
 
+#ifdef BOOST_TEST_IMPL_STATIC_REGISTRATION
+
+#define BOOST_TEST_DECORATOR( D )                                       \
+static void BOOST_JOIN(decorator_collector,__LINE__)() { D; }           \
+BOOST_TEST_STATIC_UNIT( BOOST_JOIN(decorator_static_unit,__LINE__),     \
+    REGISTRATION, 0, 0, 0,                                              \
+    &BOOST_JOIN(decorator_collector,__LINE__), 0 );                     \
+/**/
+
+#else
+
 #define BOOST_TEST_DECORATOR( D )                                       \
 static boost::unit_test::decorator::collector const&                    \
 BOOST_JOIN(decorator_collector,__LINE__) = D;                           \
 /**/
 
+#endif
+
 // ************************************************************************** //
 // **************         BOOST_AUTO_TEST_CASE_FIXTURE         ************** //
 // ************************************************************************** //
@@ -322,6 +341,70 @@ BOOST_JOIN( BOOST_JOIN( test_name, _registrar ), __LINE__ )     \
 #define BOOST_AUTO_TC_INVOKER( test_name )      BOOST_JOIN( test_name, _invoker )
 #define BOOST_AUTO_TC_UNIQUE_ID( test_name )    BOOST_JOIN( test_name, _id )
 
+#define BOOST_AUTO_TU_DECORATORS_FUNC( test_name )                      \
+BOOST_JOIN( BOOST_JOIN( test_name, _decorators ), __LINE__ )            \
+/**/
+#define BOOST_AUTO_TU_DECORATORS( test_name, decorators )               \
+static boost::unit_test::decorator::collector&                          \
+BOOST_AUTO_TU_DECORATORS_FUNC( test_name )() { return decorators; }     \
+/**/
+
+#ifdef BOOST_TEST_IMPL_STATIC_REGISTRATION
+
+// the registrations are described by the constant descriptors replayed by framework::init
+#define BOOST_AUTO_TU_STATIC_UNIT( test_name )                          \
+BOOST_JOIN( BOOST_JOIN( test_name, _static_unit ), __LINE__ )           \
+/**/
+#define BOOST_AUTO_TC_REGISTRAR( test_name, decorators_func )           \
+BOOST_TEST_STATIC_UNIT( BOOST_AUTO_TU_STATIC_UNIT( test_name ),         \
+    TEST_CASE, #test_name, __FILE__, __LINE__,                          \
+    &BOOST_AUTO_TC_INVOKER( test_name ), decorators_func )              \
+/**/
+#define BOOST_AUTO_TS_REGISTRAR( suite_name, decorators_func )          \
+BOOST_TEST_STATIC_UNIT( BOOST_AUTO_TU_STATIC_UNIT( suite_name ),        \
+    SUITE_BEGIN, BOOST_STRINGIZE( suite_name ), __FILE__, __LINE__,     \
+    0, decorators_func )                                                \
+/**/
+#define BOOST_AUTO_TS_END_REGISTRAR( end_name )                         \
+BOOST_TEST_STATIC_UNIT( BOOST_AUTO_TU_STATIC_UNIT( end_name ),          \
+    SUITE_END, 0, 0, 0, 0, 0 )                                          \
+/**/
+#define BOOST_AUTO_TU_REGISTRATION( test_name, registrar_args )         \
+static void BOOST_JOIN( BOOST_JOIN( test_name, _registration ), __LINE__ )() \
+{                                                                       \
+    boost::unit_test::ut_detail::auto_test_unit_registrar registrar     \
+        registrar_args;                                                 \
+    (void)registrar;                                                    \
+}                                                                       \
+BOOST_TEST_STATIC_UNIT( BOOST_AUTO_TU_STATIC_UNIT( test_name ),         \
+    REGISTRATION, 0, 0, 0,                                              \
+    &BOOST_JOIN( BOOST_JOIN( test_name, _registration ), __LINE__ ), 0 )\
+/**/
+
+#else
+
+#define BOOST_AUTO_TC_REGISTRAR( test_name, decorators_func )           \
+BOOST_AUTO_TU_REGISTRAR( test_name )(                                   \
+    boost::unit_test::make_test_case(                                   \
+        &BOOST_AUTO_TC_INVOKER( test_name ),                            \
+        #test_name, __FILE__, __LINE__ ),                               \
+    (decorators_func)() )                                               \
+/**/
+#define BOOST_AUTO_TS_REGISTRAR( suite_name, decorators_func )          \
+BOOST_AUTO_TU_REGISTRAR( suite_name )(                                  \
+    BOOST_STRINGIZE( suite_name ),                                      \
+    __FILE__, __LINE__,                                                 \
+    (decorators_func)() )                                               \
+/**/
+#define BOOST_AUTO_TS_END_REGISTRAR( end_name )                         \
+BOOST_AUTO_TU_REGISTRAR( end_name )( 1 )                                \
+/**/
+#define BOOST_AUTO_TU_REGISTRATION( test_name, registrar_args )         \
+BOOST_AUTO_TU_REGISTRAR( test_name ) registrar_args                     \
+/**/
+
+#endif
+
 // ************************************************************************** //
 // **************                BOOST_TEST_MAIN               ************** //
 // ************************************************************************** //
@@ -0,0 +1,88 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : common code used by any agent serving as OF_JSON printer
+// ***************************************************************************
+
+#ifndef BOOST_TEST_UTILS_JSON_PRINTER_HPP
+#define BOOST_TEST_UTILS_JSON_PRINTER_HPP
+
+// Boost.Test
+#include <boost/test/utils/basic_cstring/basic_cstring.hpp>
+#include <boost/test/utils/custom_manip.hpp>
+
+// STL
+#include <iostream>
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+
+// ************************************************************************** //
+// **************              json print helpers              ************** //
+// ************************************************************************** //
+
+/// Prints the characters of JSON string (without the quotes) escaping the quotes, backslashes and control characters
+inline void
+print_json_escaped( std::ostream& where_to, const_string value )
+{
+    static char const hex_digits[] = "0123456789abcdef";
+
+    const_string::iterator plain = value.begin();
+
+    for( const_string::iterator it = value.begin(); it != value.end(); ++it ) {
+        unsigned char c = static_cast<unsigned char>( *it );
+
+        if( c >= 0x20 && c != '"' && c != '\\' )
+            continue;
+
+        // write the run of the characters not requiring escaping at once
+        where_to.write( plain, it - plain );
+        plain = it + 1;
+
+        switch( c ) {
+        case '"':   where_to << "\\\""; break;
+        case '\\':  where_to << "\\\\"; break;
+        case '\n':  where_to << "\\n"; break;
+        case '\r':  where_to << "\\r"; break;
+        case '\t':  where_to << "\\t"; break;
+        default:
+            where_to << "\\u00" << hex_digits[c >> 4] << hex_digits[c & 0xf];
+        }
+    }
+
+    where_to.write( plain, value.end() - plain );
+}
+
+//____________________________________________________________________________//
+
+typedef custom_manip<struct json_string_t> json_string;
+
+/// Prints the value as quoted JSON string
+inline std::ostream&
+operator<<( custom_printer<json_string> const& p, const_string value )
+{
+    *p << '"';
+    print_json_escaped( *p, value );
+    return *p << '"';
+}
+
+//____________________________________________________________________________//
+
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_UTILS_JSON_PRINTER_HPP
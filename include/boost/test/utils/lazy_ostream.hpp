@@ -14,8 +14,14 @@
 // Boost.Test
 #include <boost/test/detail/config.hpp>
 
+// Boost
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_enum.hpp>
+
 // STL
 #include <iosfwd>
+#include <string>
 
 #include <boost/test/detail/suppress_warnings.hpp>
 
@@ -65,6 +71,10 @@ public:
     {
         return m_prev(ostr) << m_value;
     }
+
+    // access methods
+    PrevType const&         prev() const                                            { return m_prev; }
+    T const&                value() const                                           { return m_value; }
 private:
     // Data members
     PrevType const&         m_prev;
@@ -118,6 +128,102 @@ operator<<( lazy_ostream_impl<PrevPrevType,TPrev> const& prev, R& (BOOST_TEST_CA
 
 #endif
 
+// ************************************************************************** //
+// **************              lazy_ostream_value              ************** //
+// ************************************************************************** //
+
+// lazy_ostream_impl refers to the values and to the previous link, which are gone at the end
+// of the full expression. lazy_ostream_value holds copies of them, so it can be printed later.
+// Character strings are copied, since the pointers may be invalidated before that.
+// Only the values which do not refer to anything else are copied: for any other type the copy
+// may outlive what it refers to (or may not be possible at all), so such a chain is not captured.
+
+template<typename T>
+struct lazy_value_is_captured : mpl::bool_<is_arithmetic<T>::value || is_enum<T>::value> {};
+template<>
+struct lazy_value_is_captured<std::string>              : mpl::true_ {};
+template<std::size_t N>
+struct lazy_value_is_captured<char[N]>                  : mpl::true_ {};
+template<>
+struct lazy_value_is_captured<char const*>              : mpl::true_ {};
+template<>
+struct lazy_value_is_captured<char*>                    : mpl::true_ {};
+template<typename R,typename S>
+struct lazy_value_is_captured<R& (BOOST_TEST_CALL_DECL *)(S&)> : mpl::true_ {};
+
+//____________________________________________________________________________//
+
+template<typename T>
+struct lazy_value_storage                               { typedef T type; };
+template<std::size_t N>
+struct lazy_value_storage<char[N]>                      { typedef std::string type; };
+template<>
+struct lazy_value_storage<char const*>                  { typedef std::string type; };
+template<>
+struct lazy_value_storage<char*>                        { typedef std::string type; };
+
+inline std::string
+lazy_value_copy( char const* value )                    { return value ? std::string( value ) : std::string(); }
+
+inline std::string
+lazy_value_copy( char* value )                          { return lazy_value_copy( static_cast<char const*>( value ) ); }
+
+template<typename T>
+inline T const&
+lazy_value_copy( T const& value )                       { return value; }
+
+//____________________________________________________________________________//
+
+template<typename PrevType, typename T>
+class lazy_ostream_value : public lazy_ostream {
+public:
+    template<typename U>
+    lazy_ostream_value( PrevType const& prev, U const& value )
+    : lazy_ostream( false )
+    , m_prev( prev )
+    , m_value( lazy_value_copy( value ) )
+    {
+    }
+
+    virtual std::ostream&   operator()( std::ostream& ostr ) const
+    {
+        return m_prev(ostr) << m_value;
+    }
+private:
+    // Data members
+    PrevType                                    m_prev;
+    typename lazy_value_storage<T>::type        m_value;
+};
+
+//____________________________________________________________________________//
+
+template<typename LazyOstream>
+struct lazy_ostream_capture;
+
+// value is true if all the values printed by the chain are captured; make is to be used only then
+template<>
+struct lazy_ostream_capture<lazy_ostream> {
+    typedef lazy_ostream type;
+
+    static const bool value = true;
+
+    static type make( lazy_ostream const& o )           { return o; }
+};
+
+template<typename PrevType, typename T, typename StorageT>
+struct lazy_ostream_capture<lazy_ostream_impl<PrevType,T,StorageT> > {
+    typedef lazy_ostream_value<typename lazy_ostream_capture<PrevType>::type,T> type;
+
+    static const bool value = lazy_value_is_captured<T>::value && lazy_ostream_capture<PrevType>::value;
+
+    static type make( lazy_ostream_impl<PrevType,T,StorageT> const& o )
+    {
+        return type( lazy_ostream_capture<PrevType>::make( o.prev() ), o.value() );
+    }
+};
+
+//____________________________________________________________________________//
+
 #define BOOST_TEST_LAZY_MSG( M ) (::boost::unit_test::lazy_ostream::instance() << M)
 
 } // namespace unit_test
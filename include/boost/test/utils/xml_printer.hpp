@@ -17,9 +17,7 @@
 
 // Boost.Test
 #include <boost/test/utils/basic_cstring/basic_cstring.hpp>
-#include <boost/test/utils/fixed_mapping.hpp>
 #include <boost/test/utils/custom_manip.hpp>
-#include <boost/test/utils/foreach.hpp>
 #include <boost/test/utils/basic_cstring/io.hpp>
 
 // Boost
@@ -27,6 +25,13 @@
 
 // STL
 #include <iostream>
+#include <cstring>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define BOOST_TEST_XML_PRINTER_SSE2
+#  include <emmintrin.h>
+#endif
 
 #include <boost/test/detail/suppress_warnings.hpp>
 
@@ -35,6 +40,111 @@
 namespace boost {
 namespace unit_test {
 
+// ************************************************************************** //
+// **************             xml special chars scan           ************** //
+// ************************************************************************** //
+
+namespace ut_detail {
+
+inline char const*
+xml_entity_ref( char c, std::size_t& len )
+{
+    switch( c ) {
+    case '<':  len = 4; return "&lt;";
+    case '>':  len = 4; return "&gt;";
+    case '&':  len = 5; return "&amp;";
+    case '\'': len = 6; return "&apos;";
+    case '"':  len = 6; return "&quot;";
+    default:   len = 0; return 0;
+    }
+}
+
+//____________________________________________________________________________//
+
+// SWAR: non zero iff one of the bytes of the word is zero
+inline std::size_t
+has_zero_byte( std::size_t w )
+{
+    static std::size_t const ones  = ~std::size_t(0) / 0xFF;
+    static std::size_t const highs = ones << 7;
+
+    return (w - ones) & ~w & highs;
+}
+
+//____________________________________________________________________________//
+
+inline std::size_t
+has_byte( std::size_t w, unsigned char c )
+{
+    return has_zero_byte( w ^ (~std::size_t(0) / 0xFF * c) );
+}
+
+//____________________________________________________________________________//
+
+// Returns the first character in [beg,end) which has to be replaced with an entity
+// reference, or end. Clean characters are skipped a SIMD vector or a word at a time;
+// the exact position within the block is found by the byte loop at the end.
+inline char const*
+find_xml_special( char const* beg, char const* end )
+{
+#ifdef BOOST_TEST_XML_PRINTER_SSE2
+    __m128i const lt   = _mm_set1_epi8( '<' );
+    __m128i const gt   = _mm_set1_epi8( '>' );
+    __m128i const amp  = _mm_set1_epi8( '&' );
+    __m128i const apos = _mm_set1_epi8( '\'' );
+    __m128i const quot = _mm_set1_epi8( '"' );
+
+    for( ; end - beg >= 16; beg += 16 ) {
+        __m128i v = _mm_loadu_si128( reinterpret_cast<__m128i const*>( beg ) );
+        __m128i m = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, lt ), _mm_cmpeq_epi8( v, gt ) ),
+                                  _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, amp ), _mm_cmpeq_epi8( v, apos ) ),
+                                                _mm_cmpeq_epi8( v, quot ) ) );
+        if( _mm_movemask_epi8( m ) != 0 )
+            break;
+    }
+#endif
+
+    for( ; static_cast<std::size_t>( end - beg ) >= sizeof(std::size_t); beg += sizeof(std::size_t) ) {
+        std::size_t w;
+        std::memcpy( &w, beg, sizeof(w) );
+
+        if( has_byte( w, '<' ) | has_byte( w, '>' ) | has_byte( w, '&' ) | has_byte( w, '\'' ) | has_byte( w, '"' ) )
+            break;
+    }
+
+    for( ; beg != end; ++beg ) {
+        switch( *beg ) {
+        case '<': case '>': case '&': case '\'': case '"':
+            return beg;
+        }
+    }
+
+    return end;
+}
+
+//____________________________________________________________________________//
+
+// Returns the first "]]>" in [beg,end), or end. memchr is the vectorized search
+// for a single character the C library provides.
+inline char const*
+find_cdata_end( char const* beg, char const* end )
+{
+    while( end - beg >= 3 ) {
+        char const* p = static_cast<char const*>( std::memchr( beg, ']', static_cast<std::size_t>( end - beg - 2 ) ) );
+        if( !p )
+            break;
+
+        if( p[1] == ']' && p[2] == '>' )
+            return p;
+
+        beg = p + 1;
+    }
+
+    return end;
+}
+
+} // namespace ut_detail
+
 // ************************************************************************** //
 // **************               xml print helpers              ************** //
 // ************************************************************************** //
@@ -42,23 +152,23 @@ namespace unit_test {
 inline void
 print_escaped( std::ostream& where_to, const_string value )
 {
-    static fixed_mapping<char,char const*> char_type(
-        '<' , "lt",
-        '>' , "gt",
-        '&' , "amp",
-        '\'', "apos" ,
-        '"' , "quot",
-
-        0
-    );
-
-    BOOST_TEST_FOREACH( char, c, value ) {
-        char const* ref = char_type[c];
-
-        if( ref )
-            where_to << '&' << ref << ';';
-        else
-            where_to << c;
+    char const* run = value.begin();
+    char const* end = value.end();
+
+    for( ;; ) {
+        char const* special = ut_detail::find_xml_special( run, end );
+
+        if( special != run )
+            where_to.write( run, special - run );
+
+        if( special == end )
+            break;
+
+        std::size_t ref_len;
+        char const* ref = ut_detail::xml_entity_ref( *special, ref_len );
+        where_to.write( ref, static_cast<std::streamsize>( ref_len ) );
+
+        run = special + 1;
     }
 }
 
@@ -81,17 +191,25 @@ print_escaped( std::ostream& where_to, T const& value )
 
 //____________________________________________________________________________//
 
+// Every "]]>" in the value is split between two CDATA sections
 inline void
 print_escaped_cdata( std::ostream& where_to, const_string value )
 {
-    static const_string cdata_end( "]]>" );
-
-    const_string::size_type pos = value.find( cdata_end );
-    if( pos == const_string::npos )
-        where_to << value;
-    else {
-        where_to << value.substr( 0, pos+2 ) << cdata_end
-                 << BOOST_TEST_L( "<![CDATA[" ) << value.substr( pos+2 );
+    char const* run = value.begin();
+    char const* end = value.end();
+
+    for( ;; ) {
+        char const* pos = ut_detail::find_cdata_end( run, end );
+
+        if( pos == end ) {
+            where_to.write( run, end - run );
+            break;
+        }
+
+        where_to.write( run, pos + 2 - run );
+        where_to.write( "]]><![CDATA[", 12 );
+
+        run = pos + 2;
     }
 }
 
@@ -0,0 +1,179 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests execution monitoring sessions
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE monitoring session test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/execution_monitor.hpp>
+
+#if defined(BOOST_HAS_SIGACTION)
+
+// SYSTEM API
+#include <signal.h>
+#include <unistd.h>
+
+using namespace boost;
+
+//____________________________________________________________________________//
+
+int raise_segv()    { ::raise( SIGSEGV ); return 0; }
+int good_foo()      { return 1; }
+int reset_segv()    { ::signal( SIGSEGV, SIG_DFL ); return 1; }
+
+int hang_foo()
+{
+    for( int i = 0; i < 20; ++i )
+        ::usleep( 100000 );
+
+    return 0;
+}
+
+//____________________________________________________________________________//
+
+// the test module itself runs within the session of the unit test monitor, so the handlers
+// may be there already; the sessions are expected to restore whatever they found
+typedef void (*signal_handler_t)( int, siginfo_t*, void* );
+
+signal_handler_t
+current_handler( int sig )
+{
+    struct sigaction action;
+    ::sigaction( sig, 0, &action );
+
+    return action.sa_sigaction;
+}
+
+//____________________________________________________________________________//
+
+execution_exception::error_code
+execute( execution_monitor& em, boost::function<int ()> const& F )
+{
+    BOOST_TEST_IMPL_TRY {
+        em.execute( F );
+    }
+    BOOST_TEST_IMPL_CATCH( execution_exception, ex ) {
+        return ex.code();
+    }
+
+    return execution_exception::no_error;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_signals_handled_within_session )
+{
+    execution_monitor em;
+
+    signal_handler_t prev = current_handler( SIGSEGV );
+
+    em.start_session();
+
+    BOOST_TEST( em.in_session() );
+    BOOST_TEST( current_handler( SIGSEGV ) != signal_handler_t() );
+
+    BOOST_TEST( execute( em, &raise_segv ) == execution_exception::system_fatal_error );
+    BOOST_TEST( execute( em, &good_foo ) == execution_exception::no_error );
+    BOOST_TEST( execute( em, &raise_segv ) == execution_exception::system_fatal_error );
+
+    // the handlers stay installed between the calls
+    BOOST_TEST( current_handler( SIGSEGV ) != signal_handler_t() );
+
+    em.stop_session();
+
+    BOOST_TEST( !em.in_session() );
+    BOOST_TEST( current_handler( SIGSEGV ) == prev );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_timeout_armed_per_call )
+{
+    execution_monitor em;
+
+    em.start_session();
+
+    em.p_timeout_ms.value = 100;
+    BOOST_TEST( execute( em, &hang_foo ) == execution_exception::timeout_error );
+
+    // the timer is disarmed after each call
+    em.p_timeout_ms.value = 0;
+    BOOST_TEST( execute( em, &good_foo ) == execution_exception::no_error );
+    ::usleep( 200000 );
+
+    em.stop_session();
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_nested_sessions )
+{
+    execution_monitor em;
+
+    signal_handler_t prev = current_handler( SIGSEGV );
+
+    em.start_session();
+
+    em.p_catch_system_errors.value = false;
+    em.start_session();
+
+    BOOST_TEST( execute( em, &good_foo ) == execution_exception::no_error );
+
+    em.stop_session();
+
+    // back to the properties of the enclosing session
+    BOOST_TEST( em.p_catch_system_errors );
+    BOOST_TEST( execute( em, &raise_segv ) == execution_exception::system_fatal_error );
+
+    em.stop_session();
+
+    BOOST_TEST( current_handler( SIGSEGV ) == prev );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_handlers_reinstalled_after_call )
+{
+    // the session installs its own handlers only where there are none
+    struct sigaction prev;
+    ::sigaction( SIGSEGV, 0, &prev );
+    ::signal( SIGSEGV, SIG_DFL );
+
+    execution_monitor em;
+
+    em.start_session();
+
+    // the handler reset by the monitored function is reinstalled once it returns
+    BOOST_TEST( execute( em, &reset_segv ) == execution_exception::no_error );
+    BOOST_TEST( current_handler( SIGSEGV ) != signal_handler_t() );
+    BOOST_TEST( execute( em, &raise_segv ) == execution_exception::system_fatal_error );
+
+    em.stop_session();
+
+    ::sigaction( SIGSEGV, &prev, 0 );
+}
+
+//____________________________________________________________________________//
+
+#else
+
+BOOST_AUTO_TEST_CASE( test_signals_handled_within_session )
+{
+    BOOST_TEST_MESSAGE( "signal handling is not supported on this platform" );
+}
+
+#endif
+
+//____________________________________________________________________________//
+
+// EOF
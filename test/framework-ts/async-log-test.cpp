@@ -0,0 +1,112 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests the log written by the background thread
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE async log test
+#include <boost/test/unit_test.hpp>
+
+#include "framework-test.hpp"
+
+#if defined(BOOST_HAS_SIGACTION)
+// SYSTEM API
+#include <signal.h>
+#endif
+
+using namespace boost::unit_test;
+using namespace framework_test_cases;
+
+//____________________________________________________________________________//
+
+// more entries than the buffer holds, so that the test thread has to wait for the background one
+void chatty_foo()
+{
+    for( int i = 0; i < 5000; ++i ) {
+        BOOST_TEST_MESSAGE( "message " << i );
+
+        BOOST_TEST_CONTEXT( "iteration " << i ) {
+            BOOST_TEST( i % 1000 != 999 );
+        }
+    }
+}
+
+#if defined(BOOST_HAS_SIGACTION)
+void crashing_foo()
+{
+    BOOST_TEST_MESSAGE( "about to crash" );
+    ::raise( SIGSEGV );
+}
+#endif
+
+//____________________________________________________________________________//
+
+std::string
+run_logged( test_suite* ts, bool async )
+{
+    setup_test_tree( ts );
+
+    unit_test_log.set_async( async );
+
+    return run_test_tree( ts, log_messages );
+}
+
+//____________________________________________________________________________//
+
+std::string
+run_test_tree( bool async )
+{
+    test_suite* ts = BOOST_TEST_SUITE( "ts" );
+        ts->add( BOOST_TEST_CASE( chatty_foo ) );
+        ts->add( BOOST_TEST_CASE( failing_foo ) );
+        ts->add( BOOST_TEST_CASE( throwing_foo ) );
+
+    return run_logged( ts, async );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_async_log_matches_sync_log )
+{
+    std::string sync_log    = run_test_tree( false );
+    std::string async_log   = run_test_tree( true );
+
+    BOOST_TEST( sync_log.find( "message 4999" ) != std::string::npos );
+    BOOST_TEST( sync_log.find( "error: in \"ts/failing_foo\"" ) != std::string::npos );
+    BOOST_TEST( sync_log.find( "some error" ) != std::string::npos );
+
+    // same entries in the same order, attributed to the same test cases
+    BOOST_TEST( async_log == sync_log );
+}
+
+//____________________________________________________________________________//
+
+#if defined(BOOST_HAS_SIGACTION)
+
+BOOST_AUTO_TEST_CASE( test_async_log_drained_on_abort )
+{
+    test_suite* ts = BOOST_TEST_SUITE( "ts" );
+        ts->add( BOOST_TEST_CASE( crashing_foo ) );
+
+    // nothing queued before the fatal error is lost
+    std::string log = run_logged( ts, true );
+
+    BOOST_TEST( log.find( "about to crash" ) != std::string::npos );
+    BOOST_TEST( log.find( "fatal error: in \"ts/crashing_foo\"" ) != std::string::npos );
+    BOOST_TEST( log.find( "Test is aborted" ) != std::string::npos );
+}
+
+#endif
+
+//____________________________________________________________________________//
+
+// EOF
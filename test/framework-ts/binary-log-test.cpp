@@ -0,0 +1,190 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests the binary log format and its reader
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE binary log test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/output/binary_log_formatter.hpp>
+
+#include "framework-test.hpp"
+
+// STL
+#include <map>
+#include <set>
+
+using namespace boost::unit_test;
+using namespace framework_test_cases;
+using boost::unit_test::output::binary_log_reader;
+namespace binary_log = boost::unit_test::output::binary_log;
+
+//____________________________________________________________________________//
+
+void chatty_foo()
+{
+    for( int i = 0; i < 1000; ++i ) {
+        BOOST_TEST_CONTEXT( "iteration " << i ) {
+            BOOST_TEST( i >= 0 );
+        }
+    }
+
+    BOOST_TEST_MESSAGE( "message from test case" );
+}
+
+void skipped_foo()  { BOOST_TEST( true ); }
+
+//____________________________________________________________________________//
+
+set_jobs s_set_jobs( "2" );
+
+//____________________________________________________________________________//
+
+void
+run_test_tree( std::ostringstream& xml_output, std::ostringstream& bin_output )
+{
+    log_guard G;
+
+    test_suite* ts = BOOST_TEST_SUITE( "ts" );
+        test_case* failing = BOOST_TEST_CASE( failing_foo );
+        test_case* skipped = BOOST_TEST_CASE( skipped_foo );
+
+        ts->add( BOOST_TEST_CASE( chatty_foo ) );
+        ts->add( failing );
+        ts->add( BOOST_TEST_CASE( throwing_foo ) );
+        ts->add( skipped );
+
+        skipped->depends_on( failing );
+
+    setup_test_tree( ts );
+
+    unit_test_log.set_format( OF_XML );
+    unit_test_log.add_format( OF_BIN );
+
+    unit_test_log.set_stream( OF_XML, xml_output );
+    unit_test_log.set_threshold_level( OF_XML, log_successful_tests );
+    unit_test_log.set_stream( OF_BIN, bin_output );
+    unit_test_log.set_threshold_level( OF_BIN, log_successful_tests );
+
+    framework::run( ts );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_binary_log_content )
+{
+    std::ostringstream xml_output;
+    std::ostringstream bin_output;
+
+    run_test_tree( xml_output, bin_output );
+
+    std::string const& bin_log = bin_output.str();
+    binary_log_reader reader( bin_log );
+    binary_log_reader::record r;
+
+    std::map<test_unit_id,std::string> units;
+    std::set<std::string> started;
+    std::set<std::string> finished;
+    std::set<std::string> skipped;
+    std::set<std::string> values;
+    std::set<std::string> frames;
+    std::string exception_what;
+    int passed_entries = 0;
+
+    while( reader.next( r ) ) {
+        switch( r.m_type ) {
+        case binary_log::UNIT:
+            units[static_cast<test_unit_id>( r.m_numbers[0] )] = std::string( r.m_strings[1].begin(), r.m_strings[1].size() );
+            break;
+        case binary_log::UNIT_START:
+            started.insert( units[static_cast<test_unit_id>( r.m_numbers[0] )] );
+            break;
+        case binary_log::UNIT_FINISH:
+            finished.insert( units[static_cast<test_unit_id>( r.m_numbers[0] )] );
+            break;
+        case binary_log::UNIT_SKIPPED:
+            skipped.insert( units[static_cast<test_unit_id>( r.m_numbers[0] )] );
+            break;
+        case binary_log::EXCEPTION_START:
+            exception_what.assign( r.m_strings[2].begin(), r.m_strings[2].size() );
+            BOOST_TEST( r.m_strings[4] == "about to throw" );
+            break;
+        case binary_log::ENTRY_START:
+            if( r.m_numbers[1] == unit_test_log_formatter::BOOST_UTL_ET_INFO )
+                ++passed_entries;
+            break;
+        case binary_log::ENTRY_VALUE:
+            values.insert( std::string( r.m_strings[0].begin(), r.m_strings[0].size() ) );
+            break;
+        case binary_log::CONTEXT_VALUE:
+            frames.insert( std::string( r.m_strings[0].begin(), r.m_strings[0].size() ) );
+            break;
+        default:
+            break;
+        }
+    }
+
+    // the test cases run by the worker processes are there as well
+    BOOST_TEST( started.count( "chatty_foo" ) == 1U );
+    BOOST_TEST( started.count( "failing_foo" ) == 1U );
+    BOOST_TEST( started.count( "throwing_foo" ) == 1U );
+    BOOST_TEST( finished.count( "ts" ) == 1U );
+    BOOST_TEST( skipped.count( "skipped_foo" ) == 1U );
+
+    BOOST_TEST( passed_entries >= 1000 );
+    BOOST_TEST( values.count( "message from test case" ) == 1U );
+    BOOST_TEST( frames.count( "iteration 999" ) == 1U );
+    BOOST_TEST( frames.count( "some info" ) == 1U );
+    BOOST_TEST( exception_what.find( "some error" ) != std::string::npos );
+
+    // file names, test unit names and the repeated values are written once
+    BOOST_TEST( bin_log.size() * 4 < xml_output.str().size() );
+}
+
+//____________________________________________________________________________//
+
+std::size_t
+read_records( const_string log )
+{
+    binary_log_reader reader( log );
+    binary_log_reader::record r;
+
+    std::size_t res = 0;
+    while( reader.next( r ) )
+        ++res;
+
+    return res;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_malformed_binary_log )
+{
+    std::ostringstream xml_output;
+    std::ostringstream bin_output;
+
+    run_test_tree( xml_output, bin_output );
+
+    std::string const& bin_log = bin_output.str();
+
+    BOOST_TEST( read_records( bin_log ) > 1000U );
+    BOOST_TEST( read_records( const_string() ) == 0U );
+
+    // truncated in the middle of the last record
+    BOOST_CHECK_THROW( read_records( const_string( bin_log.data(), bin_log.size() - 1 ) ), std::runtime_error );
+
+    BOOST_CHECK_THROW( read_records( "<TestLog>" ), std::runtime_error );
+}
+
+//____________________________________________________________________________//
+
+// EOF
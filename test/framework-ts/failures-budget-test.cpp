@@ -0,0 +1,155 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests stopping the test execution after the given number of failures
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE failures budget test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/results_collector.hpp>
+
+#include "framework-test.hpp"
+
+using namespace boost::unit_test;
+using namespace framework_test_cases;
+
+//____________________________________________________________________________//
+
+void bad_foo()  { BOOST_TEST( 1 == 2 ); BOOST_TEST( 2 == 3 ); }
+
+//____________________________________________________________________________//
+
+test_suite*
+make_test_tree()
+{
+    test_suite* ts_1 = BOOST_TEST_SUITE( "ts_1" );
+        ts_1->add( BOOST_TEST_CASE( good_foo ) );
+        ts_1->add( BOOST_TEST_CASE( bad_foo ) );
+
+    test_suite* ts_main = BOOST_TEST_SUITE( "ts_main" );
+        ts_main->add( BOOST_TEST_CASE( good_foo ) );
+        ts_main->add( BOOST_TEST_CASE( bad_foo ) );
+        ts_main->add( BOOST_TEST_CASE( bad_foo ) );
+        ts_main->add( BOOST_TEST_CASE( good_foo ) );
+        ts_main->add( ts_1 );
+        ts_main->add( BOOST_TEST_CASE( good_foo ) );
+
+    setup_test_tree( ts_main );
+
+    return ts_main;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_no_limit )
+{
+    test_suite* ts = make_test_tree();
+    run_test_tree( ts, log_test_units );
+
+    test_results const& res = results_collector.results( ts->p_id );
+
+    BOOST_TEST( res.p_test_cases_passed == 4U );
+    BOOST_TEST( res.p_test_cases_failed == 3U );
+    BOOST_TEST( res.p_test_cases_skipped == 0U );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_max_failures )
+{
+    char const* argv[] = { "a.exe", "--max_failures=2" };
+    config_guard G( argv );
+
+    test_suite* ts = make_test_tree();
+    std::string log = run_test_tree( ts, log_test_units );
+
+    test_results const& res = results_collector.results( ts->p_id );
+
+    // the budget counts failed test cases, not failed assertions
+    BOOST_TEST( res.p_test_cases_passed == 1U );
+    BOOST_TEST( res.p_test_cases_failed == 2U );
+    BOOST_TEST( res.p_test_cases_skipped == 4U );
+    BOOST_TEST( res.p_assertions_failed == 4U );
+
+    BOOST_TEST( log.find( "Test suite \"ts_main/ts_1\" is skipped because the maximum number of failed test cases is reached" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_fail_fast )
+{
+    char const* argv[] = { "a.exe", "--fail_fast" };
+    config_guard G( argv );
+
+    test_suite* ts = make_test_tree();
+    run_test_tree( ts, log_test_units );
+
+    test_results const& res = results_collector.results( ts->p_id );
+
+    BOOST_TEST( res.p_test_cases_passed == 1U );
+    BOOST_TEST( res.p_test_cases_failed == 1U );
+    BOOST_TEST( res.p_test_cases_skipped == 5U );
+}
+
+//____________________________________________________________________________//
+
+#if defined(BOOST_HAS_UNISTD_H)
+
+test_suite*
+make_suites_tree()
+{
+    test_suite* ts_1 = BOOST_TEST_SUITE( "ts_1" );
+        ts_1->add( BOOST_TEST_CASE( bad_foo ) );
+        ts_1->add( BOOST_TEST_CASE( bad_foo ) );
+        ts_1->add( BOOST_TEST_CASE( good_foo ) );
+
+    test_suite* ts_2 = BOOST_TEST_SUITE( "ts_2" );
+        ts_2->add( BOOST_TEST_CASE( good_foo ) );
+
+    test_suite* ts_3 = BOOST_TEST_SUITE( "ts_3" );
+        ts_3->add( BOOST_TEST_CASE( good_foo ) );
+
+    test_suite* ts_main = BOOST_TEST_SUITE( "ts_main" );
+        ts_main->add( ts_1 );
+        ts_main->add( ts_2 );
+        ts_main->add( ts_3 );
+
+    setup_test_tree( ts_main );
+
+    return ts_main;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_max_failures_in_workers )
+{
+    char const* argv[] = { "a.exe", "--jobs=2", "--max_failures=1" };
+    config_guard G( argv );
+
+    test_suite* ts = make_suites_tree();
+    std::string log = run_test_tree( ts, log_test_units );
+
+    test_results const& res = results_collector.results( ts->p_id );
+
+    // ts_1 stops in its worker after the first failure; ts_2 already running completes; ts_3 is not started
+    BOOST_TEST( res.p_test_cases_passed == 1U );
+    BOOST_TEST( res.p_test_cases_failed == 1U );
+    BOOST_TEST( res.p_test_cases_skipped == 3U );
+
+    BOOST_TEST( log.find( "Test suite \"ts_main/ts_3\" is skipped because the maximum number of failed test cases is reached" ) != std::string::npos );
+}
+
+#endif
+
+//____________________________________________________________________________//
+
+// EOF
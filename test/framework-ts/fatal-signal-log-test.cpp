@@ -0,0 +1,125 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests the log kept in memory is written out when the test module is killed by a signal
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE fatal signal log test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/tree/observer.hpp>
+
+#include "framework-test.hpp"
+
+// STL
+#include <cstdio>
+
+#if defined(BOOST_HAS_SIGACTION)
+
+// SYSTEM API
+#include <signal.h>
+
+using namespace boost::unit_test;
+
+//____________________________________________________________________________//
+
+// kills the test module once the test case is finished, outside of the monitored calls
+struct crashing_observer : test_observer {
+    virtual void    test_unit_finish( test_unit const& tu, unsigned long )
+    {
+        if( tu.p_type == TUT_CASE )
+            ::raise( SIGSEGV );
+    }
+
+    // notified before the log
+    virtual int     priority() { return 5; }
+};
+
+crashing_observer s_crashing_observer;
+
+//____________________________________________________________________________//
+
+// executed by the test module started by run_crashing_module only
+BOOST_AUTO_TEST_CASE( crashing_module, * disabled() )
+{
+    framework::register_observer( s_crashing_observer );
+
+    for( int i = 0; i < 5000; ++i )
+        BOOST_TEST_MESSAGE( "message " << i );
+
+    BOOST_TEST_MESSAGE( "last message" );
+}
+
+//____________________________________________________________________________//
+
+// runs crashing_module in another instance of this test module and returns its log
+std::string
+run_crashing_module( char const* arg )
+{
+    char const* log_file = "fatal-signal-log-test.log";
+    std::string log_sink = std::string( "--log_sink=" ) + log_file;
+
+    char const* args[] = { "--run_test=crashing_module", "--log_level=message", log_sink.c_str(), arg };
+
+    BOOST_TEST( WIFSIGNALED( run_test_module( args ) ) );
+
+    std::string log = file_content( log_file );
+    std::remove( log_file );
+
+    return log;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_buffered_log )
+{
+    std::string log = run_crashing_module( "--log_flush=end" );
+
+    BOOST_TEST( log.find( "message 0" ) != std::string::npos );
+    BOOST_TEST( log.find( "last message" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_flight_recorder )
+{
+    std::string log = run_crashing_module( "--flight_recorder=16" );
+
+    // only the last log records of the crashed test case are kept
+    BOOST_TEST( log.find( "message 0\n" ) == std::string::npos );
+    BOOST_TEST( log.find( "last message" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_async_log )
+{
+    std::string log = run_crashing_module( "--async_log" );
+
+    // the entries still queued for the background thread are written by the signal handler
+    BOOST_TEST( log.find( "message 4999" ) != std::string::npos );
+    BOOST_TEST( log.find( "last message" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+#else
+
+BOOST_AUTO_TEST_CASE( test_buffered_log )
+{
+    BOOST_TEST_MESSAGE( "signal handling is not supported on this platform" );
+}
+
+#endif
+
+//____________________________________________________________________________//
+
+// EOF
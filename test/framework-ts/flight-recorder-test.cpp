@@ -0,0 +1,141 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests the flight recorder keeping the log of the passed test cases out of the log
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE flight recorder test
+#include <boost/test/unit_test.hpp>
+
+#include "framework-test.hpp"
+
+using namespace boost::unit_test;
+
+//____________________________________________________________________________//
+
+void good_foo()
+{
+    BOOST_TEST_MESSAGE( "good_foo message" );
+    BOOST_TEST( 1 == 1 );
+}
+
+void failing_foo()
+{
+    BOOST_TEST_MESSAGE( "failing_foo message" );
+    BOOST_TEST_CONTEXT( "failing_foo frame" ) {
+        BOOST_TEST( 1 == 2 );
+    }
+}
+
+void throwing_foo()
+{
+    BOOST_TEST_MESSAGE( "throwing_foo message" );
+    throw std::runtime_error( "throwing_foo error" );
+}
+
+void chatty_foo()
+{
+    for( int i = 0; i < 1000; ++i )
+        BOOST_TEST_MESSAGE( "chatty_foo message " << i );
+
+    BOOST_TEST( false );
+}
+
+//____________________________________________________________________________//
+
+std::string
+run_test_tree( output_format format, std::size_t limit )
+{
+    test_suite* ts = BOOST_TEST_SUITE( "ts" );
+        ts->add( BOOST_TEST_CASE( good_foo ) );
+        ts->add( BOOST_TEST_CASE( failing_foo ) );
+        ts->add( BOOST_TEST_CASE( throwing_foo ) );
+        ts->add( BOOST_TEST_CASE( chatty_foo ) );
+
+    setup_test_tree( ts );
+
+    unit_test_log.set_format( format );
+    unit_test_log.set_flight_recorder( limit );
+
+    return run_test_tree( ts, log_successful_tests );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_passed_test_case_log_is_dropped )
+{
+    std::string log = run_test_tree( OF_CLF, 1024 * 1024 );
+
+    BOOST_TEST( count( log, "good_foo" ) == 0U );
+
+    BOOST_TEST( count( log, "Entering test suite \"ts\"" ) == 1U );
+    BOOST_TEST( count( log, "Leaving test suite \"ts\"" ) == 1U );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_failed_test_case_log_is_written )
+{
+    std::string log = run_test_tree( OF_CLF, 1024 * 1024 );
+
+    BOOST_TEST( count( log, "Entering test case \"failing_foo\"" ) == 1U );
+    BOOST_TEST( count( log, "failing_foo message" ) == 1U );
+    BOOST_TEST( count( log, "check 1 == 2 has failed" ) == 1U );
+    BOOST_TEST( count( log, "failing_foo frame" ) == 1U );
+    BOOST_TEST( count( log, "Leaving test case \"failing_foo\"" ) == 1U );
+
+    // the order of the records is kept
+    BOOST_TEST( log.find( "Entering test case \"failing_foo\"" ) < log.find( "failing_foo message" ) );
+    BOOST_TEST( log.find( "failing_foo message" ) < log.find( "check 1 == 2 has failed" ) );
+    BOOST_TEST( log.find( "check 1 == 2 has failed" ) < log.find( "Leaving test case \"failing_foo\"" ) );
+
+    // aborted test case
+    BOOST_TEST( count( log, "throwing_foo message" ) == 1U );
+    BOOST_TEST( count( log, "throwing_foo error" ) == 1U );
+
+    BOOST_TEST( count( log, "chatty_foo message" ) == 1000U );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_only_last_records_are_kept )
+{
+    std::string log = run_test_tree( OF_CLF, 8 * 1024 );
+
+    // the test case start and the last records are kept
+    BOOST_TEST( count( log, "Entering test case \"chatty_foo\"" ) == 1U );
+    BOOST_TEST( count( log, "chatty_foo message 999" ) == 1U );
+    BOOST_TEST( count( log, "chatty_foo message 0\n" ) == 0U );
+    BOOST_TEST( count( log, "earlier log records of the test case are dropped by the flight recorder" ) == 1U );
+    BOOST_TEST( count( log, "check false has failed" ) == 1U );
+
+    BOOST_TEST( count( log, "chatty_foo message" ) < 100U );
+    BOOST_TEST( count( log, "chatty_foo message" ) > 5U );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_xml_log_stays_well_formed )
+{
+    std::string log = run_test_tree( OF_XML, 8 * 1024 );
+
+    BOOST_TEST( count( log, "<TestCase " ) == 3U );
+    BOOST_TEST( count( log, "</TestCase>" ) == 3U );
+    BOOST_TEST( count( log, "<TestSuite " ) == 1U );
+    BOOST_TEST( count( log, "</TestSuite>" ) == 1U );
+    BOOST_TEST( count( log, "<Message " ) == count( log, "</Message>" ) );
+    BOOST_TEST( count( log, "good_foo" ) == 0U );
+}
+
+//____________________________________________________________________________//
+
+// EOF
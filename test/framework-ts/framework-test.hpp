@@ -0,0 +1,205 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : framework test helpers: running a test tree built by the test and restoring the configuration
+// ***************************************************************************
+
+#ifndef BOOST_TEST_TEST_FRAMEWORK_TEST_HPP
+#define BOOST_TEST_TEST_FRAMEWORK_TEST_HPP
+
+// Boost.Test
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+#include <boost/test/framework.hpp>
+#include <boost/test/tree/test_unit.hpp>
+
+// STL
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <cstdlib>
+
+#if defined(BOOST_HAS_UNISTD_H)
+// SYSTEM API
+#include <unistd.h>
+#include <sys/wait.h>
+#include <errno.h>
+#endif
+
+//____________________________________________________________________________//
+
+// test case bodies shared by the test trees; the tests with bodies of their own under these names do not use them
+namespace framework_test_cases {
+
+inline void good_foo()      { BOOST_TEST( true ); }
+
+inline void failing_foo()
+{
+    BOOST_TEST_INFO( "some info" );
+    BOOST_TEST( 1 == 2 );
+}
+
+inline void throwing_foo()
+{
+    BOOST_TEST_CHECKPOINT( "about to throw" );
+    throw std::runtime_error( "some error" );
+}
+
+} // namespace framework_test_cases
+
+//____________________________________________________________________________//
+
+// restores the log configuration of the test module, changed to run a test tree
+struct log_guard {
+    ~log_guard()
+    {
+        using namespace boost::unit_test;
+
+        unit_test_log.set_async( false );
+        unit_test_log.set_flight_recorder( 0 );
+        unit_test_log.set_format( OF_CLF );
+        unit_test_log.set_flush_policy( FLUSH_LINE );
+        unit_test_log.set_stream( std::cout );
+        unit_test_log.set_threshold_level( log_all_errors );
+    }
+};
+
+//____________________________________________________________________________//
+
+// applies the runtime parameters for the duration of the test case
+struct config_guard {
+    config_guard() {}
+
+    template<int N>
+    explicit config_guard( char const* (&argv)[N] )
+    {
+        init( argv );
+    }
+    ~config_guard()
+    {
+        char const* argv[] = { "a.exe" };
+        init( argv );
+    }
+
+    template<int N>
+    void    init( char const* (&argv)[N] )
+    {
+        int argc = N;
+        boost::unit_test::runtime_config::init( argc, (char**)argv );
+    }
+};
+
+//____________________________________________________________________________//
+
+// the environment is consulted once, so this has to happen before the framework reads the parameter
+struct set_jobs {
+    explicit set_jobs( char const* jobs )
+    {
+#if defined(BOOST_HAS_UNISTD_H)
+        ::setenv( "BOOST_TEST_JOBS", jobs, 0 );
+#else
+        (void)jobs;
+#endif
+    }
+};
+
+//____________________________________________________________________________//
+
+// enables all the test units of the test tree built by the test
+inline void
+setup_test_tree( boost::unit_test::test_suite* ts )
+{
+    ts->p_default_status.value = boost::unit_test::test_unit::RS_ENABLED;
+    boost::unit_test::framework::finalize_setup_phase( ts->p_id );
+}
+
+//____________________________________________________________________________//
+
+// runs the test tree and returns its log, written at the given level
+inline std::string
+run_test_tree( boost::unit_test::test_unit const* tu, boost::unit_test::log_level level = boost::unit_test::log_all_errors )
+{
+    using namespace boost::unit_test;
+
+    log_guard G;
+
+    std::ostringstream log_output;
+    unit_test_log.set_stream( log_output );
+    unit_test_log.set_threshold_level( level );
+
+    framework::run( tu );
+
+    return log_output.str();
+}
+
+//____________________________________________________________________________//
+
+// number of occurrences of what in the log
+inline std::size_t
+count( std::string const& log, char const* what )
+{
+    std::size_t res = 0;
+
+    for( std::size_t pos = log.find( what ); pos != std::string::npos; pos = log.find( what, pos + 1 ) )
+        ++res;
+
+    return res;
+}
+
+//____________________________________________________________________________//
+
+inline std::string
+file_content( char const* file_name )
+{
+    std::ifstream in( file_name );
+    std::ostringstream content;
+
+    content << in.rdbuf();
+
+    return content.str();
+}
+
+//____________________________________________________________________________//
+
+#if defined(BOOST_HAS_UNISTD_H)
+
+// runs this test module in a child process with the given arguments; returns its wait status
+template<int N>
+inline int
+run_test_module( char const* (&args)[N] )
+{
+    char const* argv[N + 2];
+
+    argv[0] = boost::unit_test::framework::master_test_suite().argv[0];
+    std::copy( args, args + N, argv + 1 );
+    argv[N + 1] = 0;
+
+    pid_t pid = ::fork();
+    if( pid == 0 ) {
+        ::execv( argv[0], const_cast<char**>( argv ) );
+        ::_exit( 1 );
+    }
+
+    int status = 0;
+    while( ::waitpid( pid, &status, 0 ) == -1 && errno == EINTR )
+        ;
+
+    return status;
+}
+
+#endif
+
+//____________________________________________________________________________//
+
+#endif // BOOST_TEST_TEST_FRAMEWORK_TEST_HPP
@@ -0,0 +1,160 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests execution of the test cases in isolated worker processes
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE isolation test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/results_collector.hpp>
+
+#include "framework-test.hpp"
+
+#if defined(BOOST_HAS_UNISTD_H)
+
+// SYSTEM API
+#include <unistd.h>
+#include <signal.h>
+
+using namespace boost::unit_test;
+using namespace framework_test_cases;
+
+//____________________________________________________________________________//
+
+static int s_counter = 0;
+
+void count_foo()    { ++s_counter; BOOST_TEST( s_counter > 0 ); }
+void crash_foo()    { ::raise( SIGSEGV ); }
+void exit_foo()     { ::_exit( 3 ); }
+
+void hang_foo()
+{
+    // the worker can't interrupt the test case which blocks the timeout signal
+    sigset_t mask;
+    ::sigemptyset( &mask );
+    ::sigaddset( &mask, SIGALRM );
+    ::sigprocmask( SIG_BLOCK, &mask, 0 );
+
+    while( true )
+        ::sleep( 1 );
+}
+
+//____________________________________________________________________________//
+
+test_suite*
+make_test_tree()
+{
+    test_case* tc_crash = BOOST_TEST_CASE( crash_foo );
+    test_case* tc_good  = BOOST_TEST_CASE( good_foo );
+
+    test_case* tc_dep_crash = BOOST_TEST_CASE( good_foo );
+    tc_dep_crash->depends_on( tc_crash );
+
+    test_case* tc_dep_good = BOOST_TEST_CASE( good_foo );
+    tc_dep_good->depends_on( tc_good );
+
+    test_suite* ts_1 = BOOST_TEST_SUITE( "ts_1" );
+        ts_1->add( BOOST_TEST_CASE( count_foo ) );
+        ts_1->add( BOOST_TEST_CASE( count_foo ) );
+        ts_1->add( BOOST_TEST_CASE( exit_foo ) );
+
+    test_suite* ts_main = BOOST_TEST_SUITE( "ts_main" );
+        ts_main->add( tc_good );
+        ts_main->add( tc_crash );
+        ts_main->add( ts_1 );
+        ts_main->add( tc_dep_crash );
+        ts_main->add( tc_dep_good );
+
+    setup_test_tree( ts_main );
+
+    return ts_main;
+}
+
+//____________________________________________________________________________//
+
+void
+check_isolated_run( test_suite* ts, std::string const& log )
+{
+    test_results const& res = results_collector.results( ts->p_id );
+
+    // the state of the main process is not affected by the test cases
+    BOOST_TEST( s_counter == 0 );
+
+    BOOST_TEST( res.p_test_cases_passed == 4U );
+    BOOST_TEST( res.p_test_cases_failed == 2U );
+    BOOST_TEST( res.p_test_cases_skipped == 1U );
+    BOOST_TEST( res.p_test_cases_aborted == 2U );
+
+    BOOST_TEST( log.find( "SIGSEGV" ) != std::string::npos );
+    BOOST_TEST( log.find( "worker process executing this test unit terminated abnormally" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_isolated_execution )
+{
+    char const* argv[] = { "a.exe", "--isolate" };
+    config_guard G( argv );
+
+    test_suite* ts = make_test_tree();
+
+    check_isolated_run( ts, run_test_tree( ts ) );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_isolated_parallel_execution )
+{
+    char const* argv[] = { "a.exe", "--isolate", "--jobs=2" };
+    config_guard G( argv );
+
+    test_suite* ts = make_test_tree();
+
+    check_isolated_run( ts, run_test_tree( ts ) );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_unresponsive_worker_is_terminated )
+{
+    char const* argv[] = { "a.exe", "--isolate" };
+    config_guard G( argv );
+
+    test_suite* ts = BOOST_TEST_SUITE( "ts_main" );
+        ts->add( BOOST_TEST_CASE( hang_foo ), 0, 1 );
+        ts->add( BOOST_TEST_CASE( good_foo ) );
+
+    setup_test_tree( ts );
+
+    std::string log = run_test_tree( ts );
+
+    test_results const& res = results_collector.results( ts->p_id );
+
+    BOOST_TEST( res.p_test_cases_passed == 1U );
+    BOOST_TEST( res.p_test_cases_failed == 1U );
+    BOOST_TEST( log.find( "did not respond within the time limit" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+#else
+
+BOOST_AUTO_TEST_CASE( test_isolated_execution )
+{
+    BOOST_TEST_MESSAGE( "test cases isolation is not supported on this platform" );
+}
+
+#endif
+
+//____________________________________________________________________________//
+
+// EOF
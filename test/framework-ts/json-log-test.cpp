@@ -0,0 +1,157 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests the JSON lines log format
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE json log test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/utils/foreach.hpp>
+
+#include "framework-test.hpp"
+
+// STL
+#include <vector>
+
+using namespace boost::unit_test;
+using framework_test_cases::throwing_foo;
+
+//____________________________________________________________________________//
+
+// the content of the log visible to a reader tailing the log file: only what was flushed
+struct flushed_buf : std::stringbuf {
+    virtual int sync()
+    {
+        m_flushed = str();
+        return 0;
+    }
+
+    std::string m_flushed;
+};
+
+static flushed_buf* s_log_buf = 0;
+static std::string  s_flushed_in_test_case;
+
+//____________________________________________________________________________//
+
+void good_foo()
+{
+    s_flushed_in_test_case = s_log_buf->m_flushed;
+
+    BOOST_TEST_MESSAGE( "quote \" backslash \\ new line \n tab \t bell \a" );
+}
+
+void failing_foo()
+{
+    BOOST_TEST_CONTEXT( "frame 1" ) {
+        BOOST_TEST( 1 == 2 );
+    }
+}
+
+void skipped_foo()  { BOOST_TEST( true ); }
+
+//____________________________________________________________________________//
+
+std::vector<std::string>
+run_test_tree( flushed_buf& buf )
+{
+    std::ostream log_output( &buf );
+    s_log_buf = &buf;
+
+    log_guard G;
+
+    test_suite* ts = BOOST_TEST_SUITE( "ts" );
+        test_case* failing = BOOST_TEST_CASE( failing_foo );
+        test_case* skipped = BOOST_TEST_CASE( skipped_foo );
+
+        ts->add( BOOST_TEST_CASE( good_foo ) );
+        ts->add( failing );
+        ts->add( BOOST_TEST_CASE( throwing_foo ) );
+        ts->add( skipped );
+
+        skipped->depends_on( failing );
+
+    setup_test_tree( ts );
+
+    unit_test_log.set_format( OF_JSON );
+    unit_test_log.set_stream( log_output );
+    unit_test_log.set_threshold_level( log_successful_tests );
+
+    framework::run( ts );
+
+    std::vector<std::string> lines;
+    std::istringstream log( buf.str() );
+    std::string line;
+
+    while( std::getline( log, line ) )
+        lines.push_back( line );
+
+    return lines;
+}
+
+//____________________________________________________________________________//
+
+bool
+has_line( std::vector<std::string> const& lines, char const* event, char const* content )
+{
+    BOOST_TEST_FOREACH( std::string const&, line, lines ) {
+        if( line.find( std::string( "{\"event\":\"" ) + event + '"' ) == 0 && line.find( content ) != std::string::npos )
+            return true;
+    }
+
+    return false;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_json_log_content )
+{
+    flushed_buf buf;
+    std::vector<std::string> lines = run_test_tree( buf );
+
+    // each line is self-contained object
+    BOOST_TEST( lines.size() > 10U );
+    BOOST_TEST_FOREACH( std::string const&, line, lines ) {
+        BOOST_TEST( line.size() >= 2U );
+        BOOST_TEST( line[0] == '{' );
+        BOOST_TEST( line[line.size()-1] == '}' );
+    }
+
+    BOOST_TEST( has_line( lines, "unit_start", "\"unit\":\"suite\",\"name\":\"ts\"" ) );
+    BOOST_TEST( has_line( lines, "unit_start", "\"full_name\":\"ts/good_foo\"" ) );
+    BOOST_TEST( has_line( lines, "unit_finish", "\"full_name\":\"ts/good_foo\",\"wall_ns\":" ) );
+    BOOST_TEST( has_line( lines, "unit_skipped", "\"full_name\":\"ts/skipped_foo\",\"reason\":" ) );
+
+    BOOST_TEST( has_line( lines, "message", "\"message\":\"quote \\\" backslash \\\\ new line \\n tab \\t bell \\u0007\"" ) );
+    BOOST_TEST( has_line( lines, "error", "\"test_case\":\"ts/failing_foo\"" ) );
+    BOOST_TEST( has_line( lines, "context", "\"frame\":\"frame 1\"" ) );
+    BOOST_TEST( has_line( lines, "exception", "\"checkpoint\":{\"file\":" ) );
+    BOOST_TEST( has_line( lines, "exception", "some error" ) );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_json_log_flushed_per_unit )
+{
+    flushed_buf buf;
+    std::vector<std::string> lines = run_test_tree( buf );
+
+    // the start of the running test case has been flushed already
+    BOOST_TEST( s_flushed_in_test_case.find( "\"full_name\":\"ts/good_foo\"" ) != std::string::npos );
+    BOOST_TEST( s_flushed_in_test_case[s_flushed_in_test_case.size()-1] == '\n' );
+
+    BOOST_TEST( buf.m_flushed == buf.str() );
+}
+
+//____________________________________________________________________________//
+
+// EOF
@@ -0,0 +1,183 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests the context frames formatted only when they are reported
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE lazy context test
+#include <boost/test/unit_test.hpp>
+
+#include "framework-test.hpp"
+
+// Boost
+#include <boost/noncopyable.hpp>
+
+using namespace boost::unit_test;
+
+//____________________________________________________________________________//
+
+// counts how many times it was printed; enumerations are copied into the context
+enum counted {};
+
+static int s_printed = 0;
+
+std::ostream&
+operator<<( std::ostream& ostr, counted c )
+{
+    ++s_printed;
+    return ostr << "counted " << static_cast<int>( c );
+}
+
+//____________________________________________________________________________//
+
+// refers to a value, which is gone at the end of the full expression
+struct int_ref {
+    explicit int_ref( int const& v ) : m_value( v ) {}
+
+    int const& m_value;
+};
+
+std::ostream&
+operator<<( std::ostream& ostr, int_ref const& r )
+{
+    return ostr << "int_ref " << r.m_value;
+}
+
+int     make_int()                  { return 7; }
+int_ref show( int const& v )        { return int_ref( v ); }
+
+//____________________________________________________________________________//
+
+struct not_copyable : boost::noncopyable {
+    explicit not_copyable( int v ) : m_value( v ) {}
+
+    int m_value;
+};
+
+std::ostream&
+operator<<( std::ostream& ostr, not_copyable const& n )
+{
+    return ostr << "not_copyable " << n.m_value;
+}
+
+//____________________________________________________________________________//
+
+void passing_foo()
+{
+    for( int i = 0; i < 100; ++i ) {
+        BOOST_TEST_CONTEXT( "sticky " << counted( i ) ) {
+            BOOST_TEST_INFO( "info " << counted( i ) );
+            BOOST_TEST( i < 100 );
+        }
+    }
+}
+
+void failing_foo()
+{
+    for( int i = 0; i < 100; ++i ) {
+        BOOST_TEST_CONTEXT( "sticky " << counted( i ) ) {
+            BOOST_TEST_INFO( "info " << counted( i ) );
+            BOOST_TEST( i != 42 );
+        }
+    }
+}
+
+std::string make_string( char const* s ) { return s; }
+
+void temporaries_foo()
+{
+    int i = 1;
+
+    BOOST_TEST_INFO( "value " << i << ", " << make_string( "temporary string" ) << ", "
+                              << make_string( "temporary c_str" ).c_str() );
+    i = 2;
+    BOOST_TEST( i == 1 );
+}
+
+void references_foo()
+{
+    not_copyable n( 3 );
+
+    BOOST_TEST_INFO( "value " << show( make_int() ) );
+    BOOST_TEST_INFO( "nc " << n );
+    BOOST_TEST( 1 == 2 );
+}
+
+//____________________________________________________________________________//
+
+std::string
+run_test_case( void (*test_func)(), log_level level )
+{
+    test_suite* ts = BOOST_TEST_SUITE( "ts" );
+        ts->add( BOOST_TEST_CASE( test_func ) );
+
+    setup_test_tree( ts );
+
+    s_printed = 0;
+
+    return run_test_tree( ts, level );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_context_of_passed_assertions_is_not_formatted )
+{
+    std::string log = run_test_case( &passing_foo, log_all_errors );
+
+    BOOST_TEST( log.find( "counted" ) == std::string::npos );
+    BOOST_TEST( s_printed == 0 );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_context_of_failure_is_formatted )
+{
+    std::string log = run_test_case( &failing_foo, log_all_errors );
+
+    BOOST_TEST( log.find( "sticky counted 42" ) != std::string::npos );
+    BOOST_TEST( log.find( "info counted 42" ) != std::string::npos );
+    BOOST_TEST( s_printed == 2 );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_context_of_logged_passed_assertions_is_formatted )
+{
+    std::string log = run_test_case( &passing_foo, log_successful_tests );
+
+    BOOST_TEST( log.find( "sticky counted 99" ) != std::string::npos );
+    BOOST_TEST( log.find( "info counted 99" ) != std::string::npos );
+    BOOST_TEST( s_printed == 200 );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_context_values_are_captured )
+{
+    std::string log = run_test_case( &temporaries_foo, log_all_errors );
+
+    BOOST_TEST( log.find( "value 1, temporary string, temporary c_str" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_context_values_not_captured_are_formatted_at_once )
+{
+    std::string log = run_test_case( &references_foo, log_all_errors );
+
+    BOOST_TEST( log.find( "value int_ref 7" ) != std::string::npos );
+    BOOST_TEST( log.find( "nc not_copyable 3" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+// EOF
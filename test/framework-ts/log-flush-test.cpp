@@ -0,0 +1,140 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests the flush policies of the log
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE log flush test
+#include <boost/test/unit_test.hpp>
+
+#include "framework-test.hpp"
+
+using namespace boost::unit_test;
+
+//____________________________________________________________________________//
+
+// the content of the log visible to a reader of the log file: only what was flushed
+struct flushed_buf : std::stringbuf {
+    flushed_buf() : m_syncs( 0 ) {}
+
+    virtual int sync()
+    {
+        m_flushed = str();
+        ++m_syncs;
+        return 0;
+    }
+
+    std::string m_flushed;
+    int         m_syncs;
+};
+
+static flushed_buf* s_log_buf = 0;
+static std::string  s_flushed_in_test_case;
+
+//____________________________________________________________________________//
+
+void failing_foo()
+{
+    BOOST_TEST( 1 == 2 );
+
+    s_flushed_in_test_case = s_log_buf->m_flushed;
+}
+
+void chatty_foo()
+{
+    for( int i = 0; i < 1000; ++i )
+        BOOST_TEST( i >= 0 );
+}
+
+//____________________________________________________________________________//
+
+void
+run_test_tree( flushed_buf& buf, flush_mode mode, std::size_t buffer_size = 0 )
+{
+    std::ostream log_output( &buf );
+    s_log_buf = &buf;
+    s_flushed_in_test_case.clear();
+
+    log_guard G;
+
+    test_suite* ts = BOOST_TEST_SUITE( "ts" );
+        ts->add( BOOST_TEST_CASE( failing_foo ) );
+        ts->add( BOOST_TEST_CASE( chatty_foo ) );
+
+    setup_test_tree( ts );
+
+    unit_test_log.set_stream( log_output );
+    unit_test_log.set_threshold_level( log_successful_tests );
+    unit_test_log.set_flush_policy( mode, buffer_size );
+
+    framework::run( ts );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_flush_line )
+{
+    flushed_buf buf;
+    run_test_tree( buf, FLUSH_LINE );
+
+    // the failure is visible right after the assertion
+    BOOST_TEST( s_flushed_in_test_case.find( "check 1 == 2 has failed" ) != std::string::npos );
+    BOOST_TEST( buf.m_syncs > 1000 );
+    BOOST_TEST( buf.m_flushed == buf.str() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_flush_unit )
+{
+    flushed_buf buf;
+    run_test_tree( buf, FLUSH_UNIT );
+
+    // the test case start is flushed, but not the entries within it
+    BOOST_TEST( s_flushed_in_test_case.find( "Entering test case \"failing_foo\"" ) != std::string::npos );
+    BOOST_TEST( s_flushed_in_test_case.find( "check 1 == 2 has failed" ) == std::string::npos );
+    BOOST_TEST( buf.m_syncs < 20 );
+    BOOST_TEST( buf.m_flushed == buf.str() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_flush_bytes )
+{
+    flushed_buf buf;
+    run_test_tree( buf, FLUSH_BYTES, 4096 );
+
+    // flushed each time 4096 bytes are buffered and at the end
+    std::size_t log_size = buf.str().size();
+
+    BOOST_TEST( s_flushed_in_test_case.empty() );
+    BOOST_TEST( buf.m_syncs >= static_cast<int>( log_size / 4096 ) );
+    BOOST_TEST( buf.m_syncs <= static_cast<int>( log_size / 4096 ) + 5 );
+    BOOST_TEST( buf.m_flushed == buf.str() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_flush_end )
+{
+    flushed_buf buf;
+    run_test_tree( buf, FLUSH_END );
+
+    BOOST_TEST( s_flushed_in_test_case.empty() );
+    BOOST_TEST( buf.m_syncs < 5 );
+    BOOST_TEST( buf.m_flushed == buf.str() );
+    BOOST_TEST( buf.str().find( "Leaving test case \"chatty_foo\"" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+// EOF
@@ -0,0 +1,151 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests the log written into several sinks with different formats and levels
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE multiple loggers test
+#include <boost/test/unit_test.hpp>
+
+#include "framework-test.hpp"
+
+using namespace boost::unit_test;
+using namespace framework_test_cases;
+
+//____________________________________________________________________________//
+
+void bad_foo()      { BOOST_TEST( 1 == 2 ); }
+void message_foo()  { BOOST_TEST_MESSAGE( "message from test case" ); BOOST_TEST( true ); }
+
+//____________________________________________________________________________//
+
+set_jobs s_set_jobs( "2" );
+
+//____________________________________________________________________________//
+
+void
+run_test_tree( std::ostringstream& clf_output, std::ostringstream& xml_output )
+{
+    log_guard G;
+
+    test_suite* ts = BOOST_TEST_SUITE( "ts" );
+        ts->add( BOOST_TEST_CASE( good_foo ) );
+        ts->add( BOOST_TEST_CASE( bad_foo ) );
+        ts->add( BOOST_TEST_CASE( message_foo ) );
+
+    setup_test_tree( ts );
+
+    unit_test_log.set_format( OF_CLF );
+    unit_test_log.add_format( OF_XML );
+
+    unit_test_log.set_stream( OF_CLF, clf_output );
+    unit_test_log.set_threshold_level( OF_CLF, log_warnings );
+    unit_test_log.set_stream( OF_XML, xml_output );
+    unit_test_log.set_threshold_level( OF_XML, log_successful_tests );
+
+    BOOST_TEST( unit_test_log.threshold_level() == log_successful_tests );
+
+    framework::run( ts );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_sinks_with_different_levels )
+{
+    std::ostringstream clf_output;
+    std::ostringstream xml_output;
+
+    run_test_tree( clf_output, xml_output );
+
+    std::string const& clf_log = clf_output.str();
+    std::string const& xml_log = xml_output.str();
+
+    // each sink gets the entries at or above its level, in its own format
+    BOOST_TEST( clf_log.find( "error: in \"ts/bad_foo\"" ) != std::string::npos );
+    BOOST_TEST( clf_log.find( "message from test case" ) == std::string::npos );
+    BOOST_TEST( clf_log.find( "<" ) == std::string::npos );
+
+    BOOST_TEST( xml_log.find( "<Error" ) != std::string::npos );
+    BOOST_TEST( xml_log.find( "message from test case" ) != std::string::npos );
+    BOOST_TEST( xml_log.find( "<Info" ) != std::string::npos );
+    BOOST_TEST( xml_log.find( "<TestCase name=\"good_foo\"" ) != std::string::npos );
+
+    // the entries of the test cases executed in the worker processes are merged into the sink of the same format
+    BOOST_TEST( xml_log.find( "<TestCase name=\"message_foo\"" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_single_sink_configuration )
+{
+    log_guard G;
+
+    unit_test_log.add_format( OF_XML );
+    unit_test_log.set_threshold_level( OF_XML, log_messages );
+
+    std::vector<output_format> formats = unit_test_log.formats();
+    BOOST_TEST_REQUIRE( formats.size() == 2U );
+    BOOST_TEST( formats[0] == OF_CLF );
+    BOOST_TEST( formats[1] == OF_XML );
+
+    // the format is there already
+    unit_test_log.add_format( OF_XML );
+    BOOST_TEST( unit_test_log.formats().size() == 2U );
+
+    // replaces all the sinks
+    unit_test_log.set_format( OF_XML );
+    formats = unit_test_log.formats();
+    BOOST_TEST_REQUIRE( formats.size() == 1U );
+    BOOST_TEST( formats[0] == OF_XML );
+    BOOST_TEST( unit_test_log.threshold_level() == log_all_errors );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_logger_parameter )
+{
+    config_guard G;
+
+    char const* argv[] = { "a.exe", "--log_level=message", "--logger=HRF,warning,stderr:XML:CLF" };
+    BOOST_CHECK_THROW( G.init( argv ), framework::setup_error );
+
+    char const* argv_ok[] = { "a.exe", "--log_level=message", "--logger=HRF,warning,stderr:XML" };
+    G.init( argv_ok );
+
+    std::list<runtime_config::logger_spec> loggers = runtime_config::loggers();
+    BOOST_TEST_REQUIRE( loggers.size() == 2U );
+
+    BOOST_TEST( loggers.front().m_format == OF_CLF );
+    BOOST_TEST( loggers.front().m_level == log_warnings );
+    BOOST_TEST( loggers.front().m_sink == &std::cerr );
+
+    // the level and sink omitted are the ones of log_level and log_sink
+    BOOST_TEST( loggers.back().m_format == OF_XML );
+    BOOST_TEST( loggers.back().m_level == log_messages );
+    BOOST_TEST( loggers.back().m_sink == &std::cout );
+
+    char const* argv_invalid[] = { "a.exe", "--logger=HRF,sometimes" };
+    BOOST_CHECK_THROW( G.init( argv_invalid ), framework::setup_error );
+
+    // without the logger parameter there is a single sink
+    char const* argv_default[] = { "a.exe", "--log_format=XML", "--log_level=all" };
+    G.init( argv_default );
+
+    loggers = runtime_config::loggers();
+    BOOST_TEST_REQUIRE( loggers.size() == 1U );
+    BOOST_TEST( loggers.front().m_format == OF_XML );
+    BOOST_TEST( loggers.front().m_level == log_successful_tests );
+}
+
+//____________________________________________________________________________//
+
+// EOF
@@ -0,0 +1,125 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests execution of the test tree in worker processes
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE parallel execution test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/results_collector.hpp>
+
+#include "framework-test.hpp"
+
+using namespace boost::unit_test;
+using namespace framework_test_cases;
+
+//____________________________________________________________________________//
+
+void bad_foo()      { BOOST_TEST( 1 == 2 ); }
+void warn_foo()     { BOOST_WARN( false ); BOOST_TEST( true ); }
+void message_foo()  { BOOST_TEST_MESSAGE( "message from test case" ); BOOST_TEST( true ); }
+
+#if defined(BOOST_HAS_UNISTD_H)
+void crash_foo()    { ::_exit( 3 ); }
+#endif
+
+//____________________________________________________________________________//
+
+set_jobs s_set_jobs( "3" );
+
+//____________________________________________________________________________//
+
+test_suite*
+make_test_tree( bool with_crash )
+{
+    test_suite* ts_1 = BOOST_TEST_SUITE( "ts_1" );
+        ts_1->add( BOOST_TEST_CASE( good_foo ) );
+        ts_1->add( BOOST_TEST_CASE( bad_foo ) );
+        ts_1->add( BOOST_TEST_CASE( warn_foo ) );
+
+    test_suite* ts_2 = BOOST_TEST_SUITE( "ts_2" );
+        ts_2->add( BOOST_TEST_CASE( message_foo ) );
+        ts_2->add( BOOST_TEST_CASE( good_foo ) );
+
+    test_case* tc_bad = BOOST_TEST_CASE( bad_foo );
+    test_case* tc_dep = BOOST_TEST_CASE( good_foo );
+    tc_dep->depends_on( tc_bad );
+
+    test_suite* ts_main = BOOST_TEST_SUITE( "ts_main" );
+        ts_main->add( ts_1 );
+        ts_main->add( ts_2 );
+        ts_main->add( tc_bad );
+        ts_main->add( tc_dep );
+        ts_main->add( BOOST_TEST_CASE( good_foo ) );
+        ts_main->add( BOOST_TEST_CASE( good_foo ) );
+
+#if defined(BOOST_HAS_UNISTD_H)
+    if( with_crash )
+        ts_main->add( BOOST_TEST_CASE( crash_foo ) );
+#endif
+
+    setup_test_tree( ts_main );
+
+    return ts_main;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_results_are_merged )
+{
+    test_suite* ts  = make_test_tree( false );
+    std::string log = run_test_tree( ts, log_messages );
+
+    test_results const& res = results_collector.results( ts->p_id );
+
+    BOOST_TEST( res.p_assertions_passed == 6U );
+    BOOST_TEST( res.p_assertions_failed == 2U );
+    BOOST_TEST( res.p_warnings_failed == 1U );
+    BOOST_TEST( res.p_test_cases_passed == 5U );
+    BOOST_TEST( res.p_test_cases_warned == 1U );
+    BOOST_TEST( res.p_test_cases_failed == 2U );
+    BOOST_TEST( res.p_test_cases_skipped == 1U );
+
+    test_suite const& ts_1 = framework::get<test_suite>( ts->get( "ts_1" ) );
+    BOOST_TEST( results_collector.results( ts_1.p_id ).p_test_cases_failed == 1U );
+
+    // log output of the siblings appears in the order of execution
+    std::string::size_type warn_pos     = log.find( "condition false is not satisfied" );
+    std::string::size_type message_pos  = log.find( "message from test case" );
+
+    BOOST_TEST( warn_pos != std::string::npos );
+    BOOST_TEST( message_pos != std::string::npos );
+    BOOST_TEST( warn_pos < message_pos );
+}
+
+//____________________________________________________________________________//
+
+#if defined(BOOST_HAS_UNISTD_H)
+
+BOOST_AUTO_TEST_CASE( test_worker_crash_is_contained )
+{
+    test_suite* ts  = make_test_tree( true );
+    std::string log = run_test_tree( ts, log_messages );
+
+    test_results const& res = results_collector.results( ts->p_id );
+
+    BOOST_TEST( res.p_test_cases_passed == 5U );
+    BOOST_TEST( res.p_test_cases_failed == 3U );
+    BOOST_TEST( res.p_test_cases_aborted == 1U );
+    BOOST_TEST( log.find( "worker process executing this test unit terminated abnormally" ) != std::string::npos );
+}
+
+#endif
+
+//____________________________________________________________________________//
+
+// EOF
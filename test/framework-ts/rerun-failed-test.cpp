@@ -0,0 +1,150 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests re-running of the test cases failed during the previous run
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE rerun failed test
+#include <boost/test/unit_test.hpp>
+
+#include "framework-test.hpp"
+
+// STL
+#include <cstdio>
+
+using namespace boost::unit_test;
+using namespace framework_test_cases;
+
+//____________________________________________________________________________//
+
+char const* const   LIST_FILE   = "rerun-failed-test.lst";
+char const* const   FIXED_FILE  = "rerun-failed-test.fixed";
+char const* const   LOG_FILE    = "rerun-failed-test.log";
+
+// the flaky test cases fail until the fix is marked by the existence of FIXED_FILE
+bool is_fixed() { return std::ifstream( FIXED_FILE ).good(); }
+
+//____________________________________________________________________________//
+
+void
+write_file( char const* file_name, std::string const& content )
+{
+    std::ofstream out( file_name );
+
+    out << content;
+}
+
+//____________________________________________________________________________//
+
+// executed by the test module started by run_module only
+BOOST_AUTO_TEST_SUITE( rerun, * disabled() )
+
+BOOST_AUTO_TEST_CASE( good_a )  { BOOST_TEST( true ); }
+BOOST_AUTO_TEST_CASE( flaky_b ) { BOOST_TEST( is_fixed() ); }
+
+BOOST_AUTO_TEST_SUITE( ts_1 )
+
+BOOST_AUTO_TEST_CASE( good_c )  { BOOST_TEST( true ); }
+BOOST_AUTO_TEST_CASE( good_d )  { BOOST_TEST( true ); }
+BOOST_AUTO_TEST_CASE( flaky_e, * depends_on( "rerun/ts_1/good_c" ) ) { BOOST_TEST( is_fixed() ); }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//____________________________________________________________________________//
+
+#if defined(BOOST_HAS_UNISTD_H)
+
+// runs the selected test units in another instance of this test module and returns the number of the test
+// cases it executed
+std::size_t
+run_module( char const* run_test )
+{
+    std::string run_test_arg = std::string( "--run_test=" ) + run_test;
+    std::string rerun_arg = std::string( "--rerun_failed=" ) + LIST_FILE;
+    std::string log_arg = std::string( "--log_sink=" ) + LOG_FILE;
+
+    char const* args[] = { run_test_arg.c_str(), rerun_arg.c_str(), log_arg.c_str(), "--log_level=test_suite", "--report_level=no" };
+
+    run_test_module( args );
+
+    std::string const& log = file_content( LOG_FILE );
+    std::remove( LOG_FILE );
+
+    return count( log, "Leaving test case" );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_rerun_failed )
+{
+    std::remove( LIST_FILE );
+    std::remove( FIXED_FILE );
+
+    // 10. no list yet: everything selected runs
+    BOOST_TEST( run_module( "rerun" ) == 5U );
+    BOOST_TEST( file_content( LIST_FILE ) == "rerun/flaky_b\nrerun/ts_1/flaky_e\n" );
+
+    // 20. only failed test cases and their dependencies run
+    BOOST_TEST( run_module( "rerun" ) == 3U );
+    BOOST_TEST( file_content( LIST_FILE ) == "rerun/flaky_b\nrerun/ts_1/flaky_e\n" );
+
+    // 30. the failed test cases outside of the selection do not run, but stay in the list
+    BOOST_TEST( run_module( "rerun/ts_1" ) == 2U );
+    BOOST_TEST( file_content( LIST_FILE ) == "rerun/flaky_b\nrerun/ts_1/flaky_e\n" );
+
+    // 40. once fixed, the list becomes empty
+    write_file( FIXED_FILE, "fixed" );
+
+    BOOST_TEST( run_module( "rerun" ) == 3U );
+    BOOST_TEST( file_content( LIST_FILE ).empty() );
+
+    // 50. and everything runs again
+    BOOST_TEST( run_module( "rerun" ) == 5U );
+
+    std::remove( LIST_FILE );
+    std::remove( FIXED_FILE );
+}
+
+#endif
+
+//____________________________________________________________________________//
+
+void bad_foo()  { BOOST_TEST( false ); }
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_nested_run_keeps_list )
+{
+    std::string rerun_arg = std::string( "--rerun_failed=" ) + LIST_FILE;
+    char const* argv[] = { "a.exe", rerun_arg.c_str() };
+    config_guard G( argv );
+
+    write_file( LIST_FILE, "rerun/flaky_b\n" );
+
+    test_suite* ts_main = BOOST_TEST_SUITE( "ts_main" );
+        ts_main->add( BOOST_TEST_CASE( good_foo ) );
+        ts_main->add( BOOST_TEST_CASE( bad_foo ) );
+
+    setup_test_tree( ts_main );
+    run_test_tree( ts_main );
+
+    // the run over a part of the test tree does not know the failures of the rest of it
+    BOOST_TEST( file_content( LIST_FILE ) == "rerun/flaky_b\n" );
+
+    std::remove( LIST_FILE );
+}
+
+//____________________________________________________________________________//
+
+// EOF
@@ -0,0 +1,144 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests the resource usage recorded for the test units and the resource budget
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE resource usage test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/results_collector.hpp>
+#include <boost/test/results_reporter.hpp>
+
+#include "framework-test.hpp"
+
+// STL
+#include <vector>
+#include <cstring>
+
+using namespace boost::unit_test;
+using namespace framework_test_cases;
+
+//____________________________________________________________________________//
+
+// grows the resident set by touching 64MB
+void memory_foo()
+{
+    std::vector<char> memory( 64 * 1024 * 1024 );
+    std::memset( &memory[0], 1, memory.size() );
+
+    BOOST_TEST( memory.back() == 1 );
+}
+
+//____________________________________________________________________________//
+
+struct test_tree {
+    test_tree()
+    {
+        ts_main = BOOST_TEST_SUITE( "ts_main" );
+            ts_main->add( tc_good = BOOST_TEST_CASE( good_foo ) );
+            ts_main->add( tc_memory = BOOST_TEST_CASE( memory_foo ) );
+
+        setup_test_tree( ts_main );
+    }
+
+    void    run()   { m_log = run_test_tree( ts_main ); }
+
+    test_results const& results( test_unit const* tu ) const { return results_collector.results( tu->p_id ); }
+
+    std::string m_log;
+    test_suite* ts_main;
+    test_case*  tc_good;
+    test_case*  tc_memory;
+};
+
+//____________________________________________________________________________//
+
+#if defined(BOOST_HAS_UNISTD_H)
+
+BOOST_AUTO_TEST_CASE( test_recorded_usage )
+{
+    test_tree tree;
+    tree.run();
+
+    BOOST_TEST( tree.results( tree.ts_main ).passed() );
+
+    // the peak of the resident set does not shrink, so only the first test case touching the memory sees the growth
+    resource_usage const& usage = tree.results( tree.tc_memory ).p_resource_usage;
+    BOOST_TEST( usage.minor_faults > 0U );
+
+    // the test suite accumulates the usage of its test cases
+    resource_usage const& suite_usage = tree.results( tree.ts_main ).p_resource_usage;
+    BOOST_TEST( suite_usage.minor_faults >= usage.minor_faults );
+    BOOST_TEST( suite_usage.max_rss >= usage.max_rss );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_resource_budget )
+{
+    char const* argv[] = { "a.exe", "--resource_budget=minor_faults:1000" };
+    config_guard G( argv );
+
+    BOOST_TEST( runtime_config::resource_budget().minor_faults == 1000U );
+    BOOST_TEST( runtime_config::resource_budget().max_rss == 0U );
+
+    test_tree tree;
+    tree.run();
+
+    BOOST_TEST( tree.results( tree.tc_good ).passed() );
+    BOOST_TEST( !tree.results( tree.tc_memory ).passed() );
+    BOOST_TEST( tree.results( tree.tc_memory ).p_assertions_failed == 1U );
+    BOOST_TEST( tree.results( tree.ts_main ).p_test_cases_failed == 1U );
+    BOOST_TEST( tree.m_log.find( "resource budget is exceeded: minor_faults" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_usage_of_workers )
+{
+    char const* argv[] = { "a.exe", "--jobs=2", "--resource_budget=minor_faults:1000" };
+    config_guard G( argv );
+
+    test_tree tree;
+    tree.run();
+
+    BOOST_TEST( tree.results( tree.tc_memory ).p_resource_usage.get().minor_faults > 1000U );
+    BOOST_TEST( tree.results( tree.ts_main ).p_test_cases_failed == 1U );
+}
+
+#endif
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_usage_report )
+{
+    char const* argv[] = { "a.exe", "--report_resource_usage" };
+    config_guard G( argv );
+
+    BOOST_TEST( runtime_config::report_resource_usage() );
+
+    test_tree tree;
+    tree.run();
+
+    std::ostringstream report;
+    results_reporter::set_stream( report );
+    results_reporter::detailed_report( tree.ts_main->p_id );
+    results_reporter::set_stream( std::cerr );
+
+    // the report format is the one of this module
+    BOOST_TEST( ( report.str().find( "resource usage: " ) != std::string::npos ||
+                  report.str().find( "max_rss_growth=" ) != std::string::npos ) );
+}
+
+//____________________________________________________________________________//
+
+// EOF
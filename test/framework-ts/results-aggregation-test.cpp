@@ -0,0 +1,140 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests the results of the test suites accumulated as their test units finish
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE results aggregation test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/results_collector.hpp>
+
+#include "framework-test.hpp"
+
+using namespace boost::unit_test;
+using namespace framework_test_cases;
+
+//____________________________________________________________________________//
+
+void bad_foo()      { BOOST_TEST( 1 == 2 ); BOOST_TEST( 2 == 2 ); }
+void warning_foo()  { BOOST_WARN( false ); BOOST_TEST( true ); }
+
+//____________________________________________________________________________//
+
+struct test_tree {
+    test_tree()
+    {
+        ts_1 = BOOST_TEST_SUITE( "ts_1" );
+            ts_1->add( BOOST_TEST_CASE( good_foo ) );
+            ts_1->add( BOOST_TEST_CASE( bad_foo ) );
+            ts_1->add( BOOST_TEST_CASE( warning_foo ) );
+
+        ts_2 = BOOST_TEST_SUITE( "ts_2" );
+            ts_2->add( BOOST_TEST_CASE( good_foo ) );
+            ts_2->add( BOOST_TEST_CASE( good_foo ) );
+
+        // skipped, since ts_1 fails
+        ts_3 = BOOST_TEST_SUITE( "ts_3" );
+            ts_3->add( BOOST_TEST_CASE( good_foo ) );
+            ts_3->add( ts_2 );
+            ts_3->depends_on( ts_1 );
+
+        ts_main = BOOST_TEST_SUITE( "ts_main" );
+            ts_main->add( BOOST_TEST_CASE( good_foo ) );
+            ts_main->add( ts_1 );
+            ts_main->add( ts_3 );
+
+        setup_test_tree( ts_main );
+    }
+
+    void    run( test_unit* tu )    { run_test_tree( tu ); }
+
+    test_suite* ts_1;
+    test_suite* ts_2;
+    test_suite* ts_3;
+    test_suite* ts_main;
+};
+
+//____________________________________________________________________________//
+
+void
+check_main_results( test_tree const& tree )
+{
+    test_results const& res = results_collector.results( tree.ts_main->p_id );
+
+    BOOST_TEST( res.p_test_cases_passed == 2U );
+    BOOST_TEST( res.p_test_cases_warned == 1U );
+    BOOST_TEST( res.p_test_cases_failed == 1U );
+    BOOST_TEST( res.p_test_cases_skipped == 3U );
+    BOOST_TEST( res.p_assertions_passed == 4U );
+    BOOST_TEST( res.p_assertions_failed == 1U );
+    BOOST_TEST( res.p_warnings_failed == 1U );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_nested_suites )
+{
+    test_tree tree;
+    tree.run( tree.ts_main );
+
+    test_results const& res_1 = results_collector.results( tree.ts_1->p_id );
+
+    BOOST_TEST( res_1.p_test_cases_passed == 1U );
+    BOOST_TEST( res_1.p_test_cases_warned == 1U );
+    BOOST_TEST( res_1.p_test_cases_failed == 1U );
+    BOOST_TEST( res_1.p_assertions_passed == 3U );
+
+    // the test cases of a skipped test suite are counted without being visited
+    test_results const& res_3 = results_collector.results( tree.ts_3->p_id );
+
+    BOOST_TEST( res_3.p_skipped );
+    BOOST_TEST( res_3.p_test_cases_skipped == 3U );
+
+    check_main_results( tree );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_repeated_runs )
+{
+    test_tree tree;
+    tree.run( tree.ts_main );
+    tree.run( tree.ts_main );
+
+    check_main_results( tree );
+
+    // the results of a test suite executed again replace the ones it had in its parent
+    tree.run( tree.ts_1 );
+
+    check_main_results( tree );
+}
+
+//____________________________________________________________________________//
+
+#if defined(BOOST_HAS_UNISTD_H)
+
+BOOST_AUTO_TEST_CASE( test_results_of_workers )
+{
+    char const* argv[] = { "a.exe", "--jobs=2" };
+    config_guard G( argv );
+
+    test_tree tree;
+    tree.run( tree.ts_main );
+
+    check_main_results( tree );
+}
+
+#endif
+
+//____________________________________________________________________________//
+
+// EOF
@@ -16,8 +16,15 @@
 #define BOOST_TEST_MODULE Boost.Test run by name/label implementation test
 #include <boost/test/unit_test.hpp>
 #include <boost/test/unit_test_parameters.hpp>
+#include <boost/test/timing_db.hpp>
 #include <boost/test/tree/test_case_counter.hpp>
 #include <boost/test/tree/traverse.hpp>
+#include <boost/test/tree/visitor.hpp>
+#include <boost/test/utils/foreach.hpp>
+
+// STL
+#include <set>
+#include <cstdio>
 
 namespace utf = boost::unit_test;
 
@@ -452,5 +459,146 @@ BOOST_AUTO_TEST_CASE( test_dependency_handling )
 
 //____________________________________________________________________________//
 
+struct enabled_tc_collector : utf::test_tree_visitor {
+    virtual void    visit( utf::test_case const& tc ) { m_tcs.insert( tc.p_id ); }
+
+    std::set<utf::test_unit_id> m_tcs;
+};
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_run_by_shard )
+{
+    utf::test_case* tc;
+    utf::test_case* tcB;
+    utf::test_case* tcE;
+
+    //  same tree as in test_dependency_handling
+    //
+    //  D => TS1
+    //  B => F
+
+    utf::test_suite* master_ts = BOOST_TEST_SUITE("local master");
+
+    utf::test_suite* ts1 = BOOST_TEST_SUITE("ts1");
+    ts1->add( BOOST_TEST_CASE( &A ) );
+    ts1->add( tcB=BOOST_TEST_CASE( &B ) );
+
+    utf::test_suite* ts2 = BOOST_TEST_SUITE("ts2");
+    ts2->add( BOOST_TEST_CASE( &C ) );
+    ts2->add( tc=BOOST_TEST_CASE( &D ) );
+    tc->depends_on( ts1 );
+
+    utf::test_suite* ts3 = BOOST_TEST_SUITE("ts3");
+    ts3->add( tcE=BOOST_TEST_CASE( &E ) );
+    ts3->add( tc=BOOST_TEST_CASE( &F ) );
+    tcB->depends_on( tc );
+
+    utf::test_suite* ts4 = BOOST_TEST_SUITE("ts4");
+    ts4->add( ts1 );
+
+    master_ts->add( ts2 );
+    master_ts->add( ts3 );
+    master_ts->add( ts4 );
+
+    master_ts->p_default_status.value = utf::test_unit::RS_ENABLED;
+    utf::framework::finalize_setup_phase( master_ts->p_id );
+
+    // dependent test cases stay together: { D, A, B, F }, { C }, { E }
+    {
+        char const* argv[] = { "a.exe", "--shard=1/2" };
+        test_count( master_ts, argv, sizeof(argv), 4 );
+    }
+
+    {
+        char const* argv[] = { "a.exe", "--shard=2/2" };
+        test_count( master_ts, argv, sizeof(argv), 2 );
+    }
+
+    {
+        char const* argv[] = { "a.exe", "--shard=3/3" };
+        test_count( master_ts, argv, sizeof(argv), 1 );
+    }
+
+    {
+        char const* argv[] = { "a.exe", "--shard=4/4" };
+        test_count( master_ts, argv, sizeof(argv), 0 );
+    }
+
+    {
+        char const* argv[] = { "a.exe", "--run=ts3", "--shard=1/2" };
+        test_count( master_ts, argv, sizeof(argv), 1 );
+    }
+
+    {
+        char const* argv[] = { "a.exe", "--run=ts3", "--shard=2/2" };
+        test_count( master_ts, argv, sizeof(argv), 1 );
+    }
+
+    // every test case runs in exactly one shard
+    std::set<utf::test_unit_id> all_tcs;
+
+    for( int i = 0; i < 3; ++i ) {
+        std::string shard_arg = "--shard=" + std::string( 1, char('1' + i) ) + "/3";
+        char const* argv[] = { "a.exe", shard_arg.c_str() };
+        int argc = 2;
+
+        utf::runtime_config::init( argc, (char**)argv );
+        utf::framework::impl::setup_for_execution( *master_ts );
+
+        enabled_tc_collector collector;
+        utf::traverse_test_tree( master_ts->p_id, collector );
+
+        BOOST_TEST_FOREACH( utf::test_unit_id, tc_id, collector.m_tcs )
+            BOOST_TEST( all_tcs.insert( tc_id ).second );
+    }
+
+    BOOST_TEST( all_tcs.size() == 6U );
+
+    // the shards are weighted only by the timing history given explicitly: E lasts as long as all the others
+    {
+        utf::timing_db.load( "" );
+        BOOST_TEST_FOREACH( utf::test_unit_id, tc_id, all_tcs )
+            utf::timing_db.test_unit_finish( utf::framework::get( tc_id, utf::TUT_CASE ), tc_id == tcE->p_id ? 100 : 1 );
+
+        BOOST_TEST( utf::timing_db.save( "shard-weights.tdb" ) );
+        utf::timing_db.load( "" );
+    }
+
+    {
+        char const* argv[] = { "a.exe", "--shard=1/2", "--balance_shards=shard-weights.tdb" };
+        test_count( master_ts, argv, sizeof(argv), 1 );
+    }
+
+    {
+        char const* argv[] = { "a.exe", "--shard=2/2", "--balance_shards=shard-weights.tdb" };
+        test_count( master_ts, argv, sizeof(argv), 5 );
+    }
+
+    std::remove( "shard-weights.tdb" );
+
+    {
+        char const* argv[] = { "a.exe", "--shard=1/2", "--balance_shards=shard-weights.tdb" };
+        BOOST_CHECK_THROW( test_count( master_ts, argv, sizeof(argv), 0 ), utf::framework::setup_error );
+    }
+
+    {
+        char const* argv[] = { "a.exe", "--shard=3/2" };
+        BOOST_CHECK_THROW( test_count( master_ts, argv, sizeof(argv), 0 ), utf::framework::setup_error );
+    }
+
+    {
+        char const* argv[] = { "a.exe", "--shard=1/2/3" };
+        BOOST_CHECK_THROW( test_count( master_ts, argv, sizeof(argv), 0 ), utf::framework::setup_error );
+    }
+
+    {
+        char const* argv[] = { "a.exe", "--run=*" };
+        test_count( master_ts, argv, sizeof(argv), 6 );
+    }
+}
+
+//____________________________________________________________________________//
+
 // EOF
 
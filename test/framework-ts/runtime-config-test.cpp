@@ -0,0 +1,163 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests resolution of the runtime parameters from the command line,
+//                environment and configuration file
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE runtime config test
+#include <boost/test/unit_test.hpp>
+
+#include "framework-test.hpp"
+
+// STL
+#include <fstream>
+#include <cstdio>
+
+using namespace boost::unit_test;
+
+//____________________________________________________________________________//
+
+// config_guard with the configuration file read by the test case
+struct config_file_guard : config_guard {
+    config_file_guard() : m_file_name( "runtime-config-test.cfg" ) {}
+    ~config_file_guard() { std::remove( m_file_name.c_str() ); }
+
+    void    write( char const* content )
+    {
+        std::ofstream file( m_file_name.c_str() );
+        file << content;
+    }
+
+    std::string m_file_name;
+};
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_config_file )
+{
+    config_file_guard G;
+
+    G.write( "# runtime parameters\n"
+             "\n"
+             "log_level = message\n"
+             "jobs=3\n"
+             "catch_system_errors = no\n"
+             "run_test = suite1\n"
+             "run_test = \"suite2/case\"\n"
+             "random\n" );
+
+    char const* argv[] = { "a.exe", "--config_file=runtime-config-test.cfg" };
+    G.init( argv );
+
+    BOOST_TEST( runtime_config::log_level() == log_messages );
+    BOOST_TEST( runtime_config::jobs() == 3U );
+    BOOST_TEST( !runtime_config::catch_sys_errors() );
+    BOOST_TEST( runtime_config::random_seed() == 1U );
+    BOOST_TEST( runtime_config::max_failures() == 0U );
+
+    std::list<std::string> const& tests = runtime_config::test_to_run();
+
+    BOOST_TEST_REQUIRE( tests.size() == 2U );
+    BOOST_TEST( tests.front() == "suite1" );
+    BOOST_TEST( tests.back() == "suite2/case" );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_command_line_overrides_config_file )
+{
+    config_file_guard G;
+
+    G.write( "log_level = message\n"
+             "max_failures = 5\n" );
+
+    char const* argv[] = { "a.exe", "--config_file=runtime-config-test.cfg", "--log_level=nothing" };
+    G.init( argv );
+
+    BOOST_TEST( runtime_config::log_level() == log_nothing );
+    BOOST_TEST( runtime_config::max_failures() == 5U );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_snapshot_is_immutable )
+{
+    config_file_guard G;
+
+    G.write( "report_level = detailed\n" );
+
+    char const* argv[] = { "a.exe", "--config_file=runtime-config-test.cfg" };
+    G.init( argv );
+
+    BOOST_TEST( runtime_config::report_level() == DETAILED_REPORT );
+    BOOST_TEST( runtime_config::use_alt_stack() );
+
+    // the parameters are resolved once by init
+    G.write( "report_level = short\n" );
+    BOOST_TEST( runtime_config::report_level() == DETAILED_REPORT );
+
+    G.init( argv );
+    BOOST_TEST( runtime_config::report_level() == SHORT_REPORT );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_invalid_config_file )
+{
+    config_file_guard G;
+
+    char const* argv_missing[] = { "a.exe", "--config_file=no-such-file.cfg" };
+    BOOST_CHECK_THROW( G.init( argv_missing ), framework::setup_error );
+
+    G.write( "no_such_parameter = 1\n" );
+
+    char const* argv[] = { "a.exe", "--config_file=runtime-config-test.cfg" };
+    BOOST_CHECK_THROW( G.init( argv ), framework::setup_error );
+
+    G.write( "jobs = many\n" );
+    BOOST_CHECK_THROW( G.init( argv ), framework::setup_error );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_log_flush_policy )
+{
+    config_file_guard G;
+
+    BOOST_TEST( runtime_config::log_flush() == FLUSH_LINE );
+
+    char const* argv_unit[] = { "a.exe", "--log_flush=unit" };
+    G.init( argv_unit );
+    BOOST_TEST( runtime_config::log_flush() == FLUSH_UNIT );
+
+    char const* argv_bytes[] = { "a.exe", "--log_flush=bytes:4096" };
+    G.init( argv_bytes );
+    BOOST_TEST( runtime_config::log_flush() == FLUSH_BYTES );
+    BOOST_TEST( runtime_config::log_flush_bytes() == 4096U );
+
+    G.write( "log_flush = end\n" );
+
+    char const* argv_config[] = { "a.exe", "--config_file=runtime-config-test.cfg" };
+    G.init( argv_config );
+    BOOST_TEST( runtime_config::log_flush() == FLUSH_END );
+
+    char const* argv_no_size[] = { "a.exe", "--log_flush=bytes:0" };
+    BOOST_CHECK_THROW( G.init( argv_no_size ), framework::setup_error );
+
+    char const* argv_invalid[] = { "a.exe", "--log_flush=sometimes" };
+    BOOST_CHECK_THROW( G.init( argv_invalid ), framework::setup_error );
+}
+
+//____________________________________________________________________________//
+
+// EOF
@@ -0,0 +1,167 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests time-outs with millisecond granularity
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE timeout_ms test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/timer.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+#include <boost/test/results_collector.hpp>
+#include <boost/test/tree/decorator.hpp>
+
+#include "framework-test.hpp"
+
+#if defined(BOOST_HAS_UNISTD_H)
+
+// SYSTEM API
+#include <unistd.h>
+
+using namespace boost::unit_test;
+
+//____________________________________________________________________________//
+
+void short_foo()    { ::usleep( 50000 ); BOOST_TEST( true ); }
+
+void long_foo()
+{
+    for( int i = 0; i < 20; ++i )
+        ::usleep( 100000 );
+
+    BOOST_TEST( true );
+}
+
+//____________________________________________________________________________//
+
+void
+set_timeout_ms( test_unit& tu, unsigned timeout )
+{
+    decorator::collector& c = decorator::collector::instance();
+
+    c * decorator::timeout_ms( timeout );
+    c.store_in( tu );
+    c.reset();
+}
+
+//____________________________________________________________________________//
+
+std::string
+run_test_tree( test_suite* ts, elapsed_time& elapsed )
+{
+    setup_test_tree( ts );
+
+    process_timer t;
+    std::string log = run_test_tree( ts );
+    elapsed = t.elapsed();
+
+    return log;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_case_timeout_ms )
+{
+    test_case* tc_short = BOOST_TEST_CASE( short_foo );
+    test_case* tc_long  = BOOST_TEST_CASE( long_foo );
+
+    set_timeout_ms( *tc_short, 1000 );
+    set_timeout_ms( *tc_long, 200 );
+
+    test_suite* ts = BOOST_TEST_SUITE( "ts" );
+        ts->add( tc_short );
+        ts->add( tc_long );
+
+    elapsed_time elapsed;
+    std::string log = run_test_tree( ts, elapsed );
+
+    BOOST_TEST( tc_long->p_timeout_ms == 200U );
+
+    test_results const& res = results_collector.results( ts->p_id );
+
+    BOOST_TEST( res.p_test_cases_passed == 1U );
+    BOOST_TEST( res.p_test_cases_failed == 1U );
+    BOOST_TEST( log.find( "timeout" ) != std::string::npos );
+
+    // interrupted well before the second it would take to stop with alarm()
+    BOOST_TEST( elapsed.wall < 1000000000U );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_suite_timeout_limits_test_cases )
+{
+    test_suite* ts = BOOST_TEST_SUITE( "ts" );
+        ts->add( BOOST_TEST_CASE( short_foo ) );
+        ts->add( BOOST_TEST_CASE( long_foo ) );
+        ts->add( BOOST_TEST_CASE( short_foo ) );
+
+    set_timeout_ms( *ts, 300 );
+
+    elapsed_time elapsed;
+    run_test_tree( ts, elapsed );
+
+    test_results const& res = results_collector.results( ts->p_id );
+
+    // the test case without a time-out of its own is given the time left for the test suite
+    BOOST_TEST( res.p_test_cases_passed == 1U );
+    BOOST_TEST( res.p_test_cases_failed == 1U );
+    BOOST_TEST( res.p_test_cases_skipped == 1U );
+    BOOST_TEST( elapsed.wall < 1000000000U );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_timeout_in_seconds_is_saturated )
+{
+    BOOST_TEST( boost::detail::timeout_in_ms( 5 ) == 5000U );
+    BOOST_TEST( boost::detail::timeout_in_ms( 4294968 ) == (std::numeric_limits<unsigned>::max)() );
+
+    // 4294968 seconds would wrap around to 704 milliseconds
+    test_case* tc_long = BOOST_TEST_CASE( long_foo );
+
+    decorator::collector& c = decorator::collector::instance();
+    c * decorator::timeout( 4294968 );
+    c.store_in( *tc_long );
+    c.reset();
+
+    test_suite* ts = BOOST_TEST_SUITE( "ts" );
+        ts->add( tc_long );
+
+    elapsed_time elapsed;
+    run_test_tree( ts, elapsed );
+
+    BOOST_TEST( results_collector.results( ts->p_id ).p_test_cases_passed == 1U );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_monitor_timeout_units )
+{
+    // the time-out of execute_and_translate is in seconds as it always was
+    BOOST_TEST( unit_test_monitor.execute_and_translate( &short_foo, 1 ) == unit_test_monitor_t::test_ok );
+}
+
+//____________________________________________________________________________//
+
+#else
+
+BOOST_AUTO_TEST_CASE( test_case_timeout_ms )
+{
+    BOOST_TEST_MESSAGE( "time-outs are not supported on this platform" );
+}
+
+#endif
+
+//____________________________________________________________________________//
+
+// EOF
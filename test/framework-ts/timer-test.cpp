@@ -0,0 +1,140 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests wall clock and CPU time measurement of test units
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE timer test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/timer.hpp>
+#include <boost/test/tree/observer.hpp>
+
+#include "framework-test.hpp"
+
+using namespace boost::unit_test;
+
+//____________________________________________________________________________//
+
+static volatile unsigned long s_sink = 0;
+
+void
+busy_foo()
+{
+    process_timer t;
+
+    while( t.elapsed().user < 20000000 )
+        for( int i = 0; i < 1000; ++i )
+            s_sink += i;
+
+    BOOST_TEST( true );
+}
+
+//____________________________________________________________________________//
+
+#if defined(BOOST_HAS_UNISTD_H)
+
+void
+sleep_foo()
+{
+    ::usleep( 100000 );
+    BOOST_TEST( true );
+}
+
+#endif
+
+//____________________________________________________________________________//
+
+struct elapsed_collector : test_observer {
+    virtual void    test_unit_finish( test_unit const& tu, elapsed_time const& elapsed )
+    {
+        if( tu.p_type == TUT_CASE )
+            m_elapsed = elapsed;
+    }
+
+    elapsed_time    m_elapsed;
+};
+
+//____________________________________________________________________________//
+
+elapsed_time
+run_test_case( test_case* tc, output_format format, std::string& log )
+{
+    test_suite* ts = BOOST_TEST_SUITE( "ts" );
+        ts->add( tc );
+
+    setup_test_tree( ts );
+
+    elapsed_collector collector;
+
+    unit_test_log.set_format( format );
+
+    framework::register_observer( collector );
+    log = run_test_tree( ts, log_test_units );
+    framework::deregister_observer( collector );
+
+    return collector.m_elapsed;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_timer )
+{
+    process_timer t;
+
+    elapsed_time first = t.elapsed();
+    elapsed_time second = t.elapsed();
+
+    BOOST_TEST( second.wall >= first.wall );
+    BOOST_TEST( second.user >= first.user );
+    BOOST_TEST( second.system >= first.system );
+
+    t.restart();
+    BOOST_TEST( t.elapsed().wall <= second.wall + 1000000000 );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_cpu_bound_test_case )
+{
+    std::string log;
+    elapsed_time elapsed = run_test_case( BOOST_TEST_CASE( busy_foo ), OF_CLF, log );
+
+    BOOST_TEST( elapsed.user >= 20000000U );
+    BOOST_TEST( elapsed.wall >= elapsed.user / 2 );
+
+    BOOST_TEST( log.find( "Leaving test case \"busy_foo\"; testing time: " ) != std::string::npos );
+    BOOST_TEST( log.find( "; CPU time: " ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+#if defined(BOOST_HAS_UNISTD_H)
+
+BOOST_AUTO_TEST_CASE( test_waiting_test_case )
+{
+    std::string log;
+    elapsed_time elapsed = run_test_case( BOOST_TEST_CASE( sleep_foo ), OF_XML, log );
+
+    // time spent waiting is not CPU time
+    BOOST_TEST( elapsed.wall >= 100000000U );
+    BOOST_TEST( elapsed.user + elapsed.system < elapsed.wall / 2 );
+
+    BOOST_TEST( log.find( "<WallTime>" ) != std::string::npos );
+    BOOST_TEST( log.find( "<UserTime>" ) != std::string::npos );
+    BOOST_TEST( log.find( "<SystemTime>" ) != std::string::npos );
+}
+
+#endif
+
+//____________________________________________________________________________//
+
+// EOF
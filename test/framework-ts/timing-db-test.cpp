@@ -0,0 +1,145 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests persistent history of test units durations
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE timing database test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/timing_db.hpp>
+
+#include "framework-test.hpp"
+
+// STL
+#include <cstdio>
+
+namespace tt = boost::test_tools;
+using namespace boost::unit_test;
+using namespace framework_test_cases;
+
+//____________________________________________________________________________//
+
+struct db_file_guard {
+    db_file_guard() : m_file_name( "timing-db-test.bttd" ) { std::remove( m_file_name.c_str() ); }
+    ~db_file_guard() { std::remove( m_file_name.c_str() ); }
+
+    std::string m_file_name;
+};
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_record_statistics )
+{
+    timing_record tr;
+
+    tr.add( 10 );
+    BOOST_TEST( tr.m_mean == 10., tt::tolerance( 1e-9 ) );
+    BOOST_CHECK_SMALL( tr.m_variance, 1e-9 );
+
+    tr.add( 20 );
+    tr.add( 30 );
+    BOOST_TEST( tr.m_mean == 20., tt::tolerance( 1e-9 ) );
+    BOOST_TEST( tr.m_variance == 100., tt::tolerance( 1e-9 ) );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_record_history_is_bounded )
+{
+    timing_record tr;
+
+    for( unsigned long i = 0; i < timing_record::history_size + 5; ++i )
+        tr.add( i );
+
+    BOOST_TEST( tr.m_durations.size() == timing_record::history_size );
+    BOOST_TEST( tr.m_durations.front() == 5U );
+    BOOST_TEST( tr.m_durations.back() == timing_record::history_size + 4 );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_save_and_load )
+{
+    db_file_guard G;
+
+    BOOST_TEST( timing_db.load( G.m_file_name ) );
+    BOOST_TEST( timing_db.records().empty() );
+
+    test_case* tc = BOOST_TEST_CASE( good_foo );
+
+    timing_db.test_unit_finish( *tc, 100 );
+    timing_db.test_unit_finish( *tc, 300 );
+    BOOST_TEST_REQUIRE( timing_db.save( G.m_file_name ) );
+
+    BOOST_TEST_REQUIRE( timing_db.load( G.m_file_name ) );
+
+    timing_record const* tr = timing_db.record( tc->full_name() );
+    BOOST_TEST_REQUIRE( tr != (timing_record const*)0 );
+
+    BOOST_TEST( tr->m_durations.size() == 2U );
+    BOOST_TEST( tr->m_durations.back() == 300U );
+    BOOST_TEST( tr->m_mean == 200., tt::tolerance( 1e-9 ) );
+    BOOST_TEST( tr->m_variance == 20000., tt::tolerance( 1e-9 ) );
+
+    BOOST_TEST( timing_db.record( "unknown" ) == (timing_record const*)0 );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_corrupted_file )
+{
+    db_file_guard G;
+
+    {
+        std::ofstream file( G.m_file_name.c_str() );
+        file << "BTTD garbage";
+    }
+
+    BOOST_TEST( !timing_db.load( G.m_file_name ) );
+    BOOST_TEST( timing_db.records().empty() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_durations_are_recorded )
+{
+    db_file_guard G;
+
+    test_suite* ts_main = BOOST_TEST_SUITE( "ts_main" );
+        ts_main->add( BOOST_TEST_CASE( good_foo ) );
+
+    setup_test_tree( ts_main );
+
+    for( int i = 0; i < 2; ++i ) {
+        BOOST_TEST_REQUIRE( timing_db.load( G.m_file_name ) );
+
+        framework::register_observer( timing_db );
+        framework::run( ts_main );
+        framework::deregister_observer( timing_db );
+
+        // nested run continues this test, so the end of it has to be signaled explicitly
+        timing_db.test_finish();
+    }
+    BOOST_TEST_REQUIRE( timing_db.load( G.m_file_name ) );
+
+    timing_record const* tr = timing_db.record( "ts_main/good_foo" );
+    BOOST_TEST_REQUIRE( tr != (timing_record const*)0 );
+    BOOST_TEST( tr->m_durations.size() == 2U );
+
+    tr = timing_db.record( "ts_main" );
+    BOOST_TEST_REQUIRE( tr != (timing_record const*)0 );
+    BOOST_TEST( tr->m_durations.size() == 2U );
+}
+
+//____________________________________________________________________________//
+
+// EOF
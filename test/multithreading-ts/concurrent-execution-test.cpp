@@ -0,0 +1,229 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : tests concurrent execution of the test cases marked as concurrent
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE concurrent execution test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/results_collector.hpp>
+#include <boost/test/framework.hpp>
+#include <boost/test/tree/test_unit.hpp>
+#include <boost/test/detail/concurrency.hpp>
+
+// Boost
+#include <boost/bind.hpp>
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <sstream>
+#include <iostream>
+
+namespace utf = boost::unit_test;
+using namespace boost::unit_test;
+
+//____________________________________________________________________________//
+
+static std::atomic<int> s_running( 0 );
+static std::atomic<int> s_max_running( 0 );
+
+struct running_guard {
+    running_guard()
+    {
+        int running = ++s_running;
+        int max_running = s_max_running;
+
+        while( running > max_running && !s_max_running.compare_exchange_weak( max_running, running ) )
+            ;
+    }
+    ~running_guard() { --s_running; }
+};
+
+//____________________________________________________________________________//
+
+void concurrent_foo( int i )
+{
+    running_guard G;
+
+#ifdef BOOST_TEST_CONCURRENT_EXECUTION
+    // give other test cases a chance to start, so that they overlap with this one
+    bool concurrent = framework::get<test_suite>( framework::current_test_case().p_parent_id ).p_concurrent;
+
+    for( int n = 0; concurrent && n < 2000 && s_max_running < 2; ++n )
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+#endif
+
+    for( int j = 0; j < 100; ++j )
+        BOOST_TEST( j >= 0 );
+
+    BOOST_TEST_INFO( "case " << i );
+    BOOST_TEST( i % 2 == 0 );
+}
+
+//____________________________________________________________________________//
+
+void serial_foo()
+{
+    running_guard G;
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+
+    BOOST_TEST( true );
+}
+
+//____________________________________________________________________________//
+
+struct log_guard {
+    ~log_guard()
+    {
+        unit_test_log.set_stream( std::cout );
+        unit_test_log.set_threshold_level( log_all_errors );
+    }
+};
+
+//____________________________________________________________________________//
+
+std::string
+case_name( int i )
+{
+    std::ostringstream name;
+    name << "case_" << i;
+    return name.str();
+}
+
+//____________________________________________________________________________//
+
+test_suite*
+make_test_tree( bool concurrent )
+{
+    test_suite* ts_main = BOOST_TEST_SUITE( "ts_main" );
+
+    test_suite* ts = BOOST_TEST_SUITE( "ts" );
+    ts->p_concurrent.value = concurrent;
+
+    for( int i = 0; i < 8; ++i )
+        ts->add( make_test_case( boost::bind( &concurrent_foo, i ), case_name( i ), __FILE__, __LINE__ ) );
+
+    ts_main->add( ts );
+    ts_main->add( BOOST_TEST_CASE( serial_foo ) );
+    ts_main->add( BOOST_TEST_CASE( serial_foo ) );
+
+    ts_main->p_default_status.value = test_unit::RS_ENABLED;
+    framework::finalize_setup_phase( ts_main->p_id );
+
+    return ts_main;
+}
+
+//____________________________________________________________________________//
+
+std::string
+run_test_tree( test_suite* ts )
+{
+    log_guard G;
+
+    std::ostringstream log_output;
+    unit_test_log.set_stream( log_output );
+    unit_test_log.set_threshold_level( log_all_errors );
+
+    s_max_running = 0;
+
+    framework::run( ts );
+
+    return log_output.str();
+}
+
+//____________________________________________________________________________//
+
+void
+check_results( test_suite* ts_main, std::string const& log )
+{
+    test_results const& res = results_collector.results( ts_main->p_id );
+
+    BOOST_TEST( res.p_assertions_passed == 806U );
+    BOOST_TEST( res.p_assertions_failed == 4U );
+    BOOST_TEST( res.p_test_cases_passed == 6U );
+    BOOST_TEST( res.p_test_cases_failed == 4U );
+
+    test_suite const& ts = framework::get<test_suite>( ts_main->get( "ts" ) );
+
+    for( int i = 0; i < 8; ++i ) {
+        test_results const& tc_res = results_collector.results( ts.get( case_name( i ) ) );
+
+        BOOST_TEST( tc_res.p_assertions_passed == (i % 2 == 0 ? 101U : 100U) );
+        BOOST_TEST( tc_res.p_assertions_failed == (i % 2 == 0 ? 0U : 1U) );
+
+        if( i % 2 == 0 )
+            continue;
+
+        // context of the failure belongs to the test case it was reported from
+        std::string::size_type entry_pos = log.find( "ts/" + case_name( i ) + "\": check" );
+        BOOST_TEST_REQUIRE( entry_pos != std::string::npos );
+
+        std::string::size_type context_pos = log.find( "\n    case ", entry_pos );
+        BOOST_TEST_REQUIRE( context_pos != std::string::npos );
+
+        std::ostringstream expected_context;
+        expected_context << "\n    case " << i << '\n';
+        BOOST_TEST( log.substr( context_pos, expected_context.str().size() ) == expected_context.str() );
+    }
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_concurrent_execution )
+{
+    test_suite* ts  = make_test_tree( true );
+    std::string log = run_test_tree( ts );
+
+    check_results( ts, log );
+
+#ifdef BOOST_TEST_CONCURRENT_EXECUTION
+    BOOST_TEST( s_max_running >= 2 );
+#endif
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_serial_execution )
+{
+    test_suite* ts  = make_test_tree( false );
+    std::string log = run_test_tree( ts );
+
+    check_results( ts, log );
+
+    BOOST_TEST( s_max_running == 1 );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_SUITE( decorated, * utf::concurrent() )
+
+BOOST_AUTO_TEST_CASE( test_decorator )
+{
+    test_unit const& ts = framework::get<test_suite>( framework::current_test_case().p_parent_id );
+
+    BOOST_TEST( ts.p_concurrent );
+}
+
+BOOST_AUTO_TEST_CASE( test_per_thread_current_test_case )
+{
+    BOOST_TEST( framework::current_test_case().p_name.get() == "test_per_thread_current_test_case" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//____________________________________________________________________________//
+
+// EOF
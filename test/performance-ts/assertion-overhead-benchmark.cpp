@@ -0,0 +1,100 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : measures the cost of the passing assertions and of the messages
+//                which are not logged with the default log level
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE assertion overhead benchmark
+#include <boost/test/unit_test.hpp>
+#include <boost/test/timer.hpp>
+
+// STL
+#include <iostream>
+#include <iomanip>
+
+using namespace boost::unit_test;
+
+//____________________________________________________________________________//
+
+static unsigned const s_iterations = 1000000;
+
+// not known to the compiler, so the assertions are not optimized away
+static unsigned volatile s_limit = s_iterations;
+
+//____________________________________________________________________________//
+
+void
+report( char const* name, elapsed_time const& elapsed )
+{
+    std::cout << std::setw( 40 ) << std::left << name
+              << std::setw( 10 ) << std::right << elapsed.wall / s_iterations << " ns" << std::endl;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( passing_boost_test )
+{
+    unsigned limit = s_limit;
+    process_timer t;
+
+    for( unsigned i = 0; i < s_iterations; ++i )
+        BOOST_TEST( i < limit );
+
+    report( "BOOST_TEST", t.elapsed() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( passing_boost_check_equal )
+{
+    unsigned limit = s_limit;
+    process_timer t;
+
+    for( unsigned i = 0; i < s_iterations; ++i )
+        BOOST_CHECK_EQUAL( limit, s_iterations );
+
+    report( "BOOST_CHECK_EQUAL", t.elapsed() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( passing_boost_test_in_context )
+{
+    unsigned limit = s_limit;
+    process_timer t;
+
+    for( unsigned i = 0; i < s_iterations; ++i ) {
+        BOOST_TEST_CONTEXT( "iteration " << i ) {
+            BOOST_TEST_INFO( "limit " << limit );
+            BOOST_TEST( i < limit );
+        }
+    }
+
+    report( "BOOST_TEST, context and info frames", t.elapsed() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( filtered_boost_test_message )
+{
+    process_timer t;
+
+    for( unsigned i = 0; i < s_iterations; ++i )
+        BOOST_TEST_MESSAGE( "iteration " << i );
+
+    report( "BOOST_TEST_MESSAGE, not logged", t.elapsed() );
+}
+
+//____________________________________________________________________________//
+
+// EOF
@@ -0,0 +1,113 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : measures the size and the cost of formatting of the log written
+//                in each of the log formats
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE log format benchmark
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/framework.hpp>
+#include <boost/test/tree/test_unit.hpp>
+#include <boost/test/timer.hpp>
+
+// STL
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+using namespace boost::unit_test;
+
+//____________________________________________________________________________//
+
+static unsigned const s_iterations = 100000;
+
+void passing_foo()
+{
+    for( unsigned i = 0; i < s_iterations; ++i )
+        BOOST_TEST( i < s_iterations );
+}
+
+void context_foo()
+{
+    for( unsigned i = 0; i < s_iterations; ++i ) {
+        BOOST_TEST_CONTEXT( "iteration " << i ) {
+            BOOST_TEST( i < s_iterations );
+        }
+    }
+}
+
+//____________________________________________________________________________//
+
+struct log_guard {
+    ~log_guard()
+    {
+        unit_test_log.set_format( OF_CLF );
+        unit_test_log.set_stream( std::cout );
+        unit_test_log.set_threshold_level( log_all_errors );
+    }
+};
+
+//____________________________________________________________________________//
+
+void
+run_test_tree( char const* name, output_format format, void (*test_func)() )
+{
+    std::ostringstream log_output;
+
+    {
+        log_guard G;
+
+        test_suite* ts = BOOST_TEST_SUITE( "ts" );
+            ts->add( BOOST_TEST_CASE( test_func ) );
+
+        ts->p_default_status.value = test_unit::RS_ENABLED;
+        framework::finalize_setup_phase( ts->p_id );
+
+        unit_test_log.set_format( format );
+        unit_test_log.set_stream( log_output );
+        unit_test_log.set_threshold_level( log_successful_tests );
+
+        process_timer t;
+
+        framework::run( ts );
+
+        elapsed_time elapsed = t.elapsed();
+
+        std::cout << std::setw( 20 ) << std::left << name
+                  << std::setw( 10 ) << std::right << log_output.str().size() / s_iterations << " bytes"
+                  << std::setw( 10 ) << std::right << elapsed.wall / s_iterations << " ns" << std::endl;
+    }
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( passed_assertions )
+{
+    run_test_tree( "HRF", OF_CLF, &passing_foo );
+    run_test_tree( "XML", OF_XML, &passing_foo );
+    run_test_tree( "BIN", OF_BIN, &passing_foo );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( passed_assertions_with_context )
+{
+    run_test_tree( "HRF, context", OF_CLF, &context_foo );
+    run_test_tree( "XML, context", OF_XML, &context_foo );
+    run_test_tree( "BIN, context", OF_BIN, &context_foo );
+}
+
+//____________________________________________________________________________//
+
+// EOF
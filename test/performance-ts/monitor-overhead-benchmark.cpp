@@ -0,0 +1,96 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : measures the overhead of the monitored execution of a test unit
+//                with and without a monitoring session
+// ***************************************************************************
+
+// Boost.Test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+#include <boost/test/timer.hpp>
+#include <boost/test/tree/observer.hpp>
+
+// STL
+#include <iostream>
+#include <iomanip>
+
+using namespace boost::unit_test;
+
+//____________________________________________________________________________//
+
+static unsigned const s_iterations = 20000;
+
+void empty_foo() {}
+
+//____________________________________________________________________________//
+
+void
+report( char const* name, elapsed_time const& elapsed )
+{
+    std::cout << std::setw( 40 ) << std::left << name
+              << std::setw( 10 ) << std::right << elapsed.wall / s_iterations << " ns" << std::endl;
+}
+
+//____________________________________________________________________________//
+
+elapsed_time
+monitored_calls( unsigned timeout_ms )
+{
+    process_timer t;
+
+    for( unsigned i = 0; i < s_iterations; ++i )
+        unit_test_monitor.execute_and_translate_ms( &empty_foo, timeout_ms );
+
+    return t.elapsed();
+}
+
+//____________________________________________________________________________//
+
+// measures the whole run of the empty test cases, which is done within the session
+struct run_timer : test_observer {
+    virtual void    test_start( counter_t )     { m_timer.restart(); }
+    virtual void    test_finish()               { report( "per empty test case, whole run", m_timer.elapsed() ); }
+
+    process_timer   m_timer;
+};
+
+static run_timer s_run_timer;
+
+//____________________________________________________________________________//
+
+test_suite*
+init_unit_test_suite( int, char* [] )
+{
+    framework::master_test_suite().p_name.value = "monitor overhead benchmark";
+
+    std::cout << "per monitored call, " << s_iterations << " iterations" << std::endl;
+
+    // the test tree is not being executed yet, so there is no session in progress
+    report( "without session", monitored_calls( 0 ) );
+    report( "without session, with timeout", monitored_calls( 60000 ) );
+
+    unit_test_monitor.start_session();
+    report( "within session", monitored_calls( 0 ) );
+    report( "within session, with timeout", monitored_calls( 60000 ) );
+    unit_test_monitor.stop_session();
+
+    for( unsigned i = 0; i < s_iterations; ++i )
+        framework::master_test_suite().add( BOOST_TEST_CASE( &empty_foo ) );
+
+    framework::register_observer( s_run_timer );
+
+    return 0;
+}
+
+//____________________________________________________________________________//
+
+// EOF
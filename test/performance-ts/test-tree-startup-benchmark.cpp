@@ -0,0 +1,110 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : measures the time and the memory it takes to build the test tree
+//                of a generated module with 200k test cases
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE test tree startup benchmark
+#include <boost/test/unit_test.hpp>
+#include <boost/test/framework.hpp>
+#include <boost/test/tree/test_unit.hpp>
+#include <boost/test/timer.hpp>
+
+// STL
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+using namespace boost::unit_test;
+
+//____________________________________________________________________________//
+
+static unsigned const s_test_suites = 200;
+static unsigned const s_test_cases  = 1000; // per test suite
+
+void generated_foo() {}
+
+//____________________________________________________________________________//
+
+// resident set size of the process in KB, or 0 if unknown
+long
+resident_set_size()
+{
+#if defined(__linux__)
+    std::ifstream statm( "/proc/self/statm" );
+    long size = 0, resident = 0;
+
+    if( statm >> size >> resident )
+        return resident * (::sysconf( _SC_PAGESIZE ) / 1024);
+#endif
+    return 0;
+}
+
+//____________________________________________________________________________//
+
+void
+report( char const* name, elapsed_time const& elapsed, long rss_delta )
+{
+    std::cout << std::setw( 40 ) << std::left << name
+              << std::setw( 10 ) << std::right << std::fixed << std::setprecision( 1 )
+              << double(elapsed.wall) / 1000000 << " ms"
+              << std::setw( 10 ) << std::right << rss_delta << " KB" << std::endl;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_tree_startup )
+{
+    std::vector<test_suite*> suites;
+    std::vector<std::string> tc_names;
+
+    for( unsigned i = 0; i < s_test_cases; ++i ) {
+        std::ostringstream tc_name;
+        tc_name << "generated_test_case_" << i;
+        tc_names.push_back( tc_name.str() );
+    }
+
+    long          rss_start = resident_set_size();
+    process_timer t;
+
+    // the same calls BOOST_AUTO_TEST_SUITE and BOOST_AUTO_TEST_CASE( name, * label( "generated" ) ) make
+    for( unsigned s = 0; s < s_test_suites; ++s ) {
+        std::ostringstream ts_name;
+        ts_name << "generated_test_suite_" << s;
+
+        ut_detail::auto_test_unit_registrar( ts_name.str(), __FILE__, __LINE__, decorator::collector::instance() );
+        suites.push_back( &framework::current_auto_test_suite() );
+
+        for( unsigned i = 0; i < s_test_cases; ++i )
+            ut_detail::auto_test_unit_registrar( make_test_case( &generated_foo, tc_names[i], __FILE__, __LINE__ ),
+                                                 *decorator::label( "generated" ),
+                                                 0 );
+
+        ut_detail::auto_test_unit_registrar( 0 );
+    }
+
+    report( "build the test tree (200k test cases)", t.elapsed(), resident_set_size() - rss_start );
+
+    BOOST_TEST( framework::get<test_case>( suites.back()->get( "generated_test_case_999" ) ).p_decorators->size() == 1U );
+}
+
+//____________________________________________________________________________//
+
+// EOF
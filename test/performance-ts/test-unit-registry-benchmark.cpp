@@ -0,0 +1,137 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : measures the cost of the test unit and results lookups by id
+//                in a module with 100k test cases
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE test unit registry benchmark
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/results_collector.hpp>
+#include <boost/test/framework.hpp>
+#include <boost/test/tree/test_unit.hpp>
+#include <boost/test/tree/traverse.hpp>
+#include <boost/test/tree/test_case_counter.hpp>
+#include <boost/test/timer.hpp>
+
+// STL
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace boost::unit_test;
+
+//____________________________________________________________________________//
+
+static unsigned const s_test_cases = 100000;
+static unsigned const s_repeat     = 20;
+
+void warning_foo()
+{
+    for( int i = 0; i < 10; ++i )
+        BOOST_WARN( i < 0 );
+}
+
+//____________________________________________________________________________//
+
+void
+report( char const* name, elapsed_time const& elapsed, unsigned long count )
+{
+    std::cout << std::setw( 40 ) << std::left << name
+              << std::setw( 10 ) << std::right << std::fixed << std::setprecision( 1 )
+              << double(elapsed.wall) / count << " ns" << std::endl;
+}
+
+//____________________________________________________________________________//
+
+struct log_guard {
+    log_guard()     { unit_test_log.set_threshold_level( log_nothing ); }
+    ~log_guard()    { unit_test_log.set_threshold_level( log_all_errors ); }
+};
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_unit_registry )
+{
+    test_suite* ts = BOOST_TEST_SUITE( "ts" );
+    std::vector<test_unit_id> ids;
+
+    {
+        process_timer t;
+
+        for( unsigned i = 0; i < s_test_cases; ++i ) {
+            test_case* tc = BOOST_TEST_CASE( &warning_foo );
+            ts->add( tc );
+            ids.push_back( tc->p_id );
+        }
+
+        report( "registration, per test case", t.elapsed(), s_test_cases );
+    }
+
+    ts->p_default_status.value = test_unit::RS_ENABLED;
+    framework::finalize_setup_phase( ts->p_id );
+
+    {
+        process_timer t;
+        std::size_t   sum = 0;
+
+        for( unsigned r = 0; r < s_repeat; ++r ) {
+            for( unsigned i = 0; i < s_test_cases; ++i )
+                sum += framework::get( ids[i], TUT_CASE ).p_line_num;
+        }
+
+        report( "framework::get", t.elapsed(), s_repeat * s_test_cases );
+        BOOST_TEST( sum != 0U );
+    }
+
+    {
+        log_guard G;
+        process_timer t;
+
+        // enables the test cases
+        framework::run( ts );
+
+        report( "run, per test case (10 warnings)", t.elapsed(), s_test_cases );
+    }
+
+    {
+        process_timer t;
+        counter_t     count = 0;
+
+        for( unsigned r = 0; r < s_repeat; ++r ) {
+            test_case_counter tcc;
+            traverse_test_tree( *ts, tcc );
+            count += tcc.p_count;
+        }
+
+        report( "tree traversal, per test case", t.elapsed(), s_repeat * s_test_cases );
+        BOOST_TEST( count == s_repeat * s_test_cases );
+    }
+
+    {
+        process_timer t;
+        counter_t     count = 0;
+
+        for( unsigned r = 0; r < s_repeat; ++r ) {
+            for( unsigned i = 0; i < s_test_cases; ++i )
+                count += results_collector.results( ids[i] ).p_warnings_failed;
+        }
+
+        report( "results_collector.results", t.elapsed(), s_repeat * s_test_cases );
+        BOOST_TEST( count == s_repeat * s_test_cases * 10 );
+    }
+}
+
+//____________________________________________________________________________//
+
+// EOF
@@ -0,0 +1,145 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : measures the throughput of the xml escaping used by the XML log
+//                and report formatters
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE xml escaping benchmark
+#include <boost/test/unit_test.hpp>
+#include <boost/test/utils/xml_printer.hpp>
+#include <boost/test/utils/fixed_mapping.hpp>
+#include <boost/test/utils/foreach.hpp>
+#include <boost/test/timer.hpp>
+
+// STL
+#include <iostream>
+#include <iomanip>
+#include <streambuf>
+#include <string>
+
+using namespace boost::unit_test;
+
+//____________________________________________________________________________//
+
+static unsigned const s_iterations = 2000;
+static std::size_t const s_value_size = 64 * 1024;
+
+// discards the output, so only the escaping and the stream insertion are measured
+struct null_buf : std::streambuf {
+    std::streamsize xsputn( char const*, std::streamsize n ) { return n; }
+    int_type        overflow( int_type c )                   { return traits_type::not_eof( c ); }
+};
+
+//____________________________________________________________________________//
+
+// the character by character implementation the scanning kernel replaces
+void
+per_char_escaped( std::ostream& where_to, const_string value )
+{
+    static fixed_mapping<char,char const*> char_type(
+        '<' , "lt",
+        '>' , "gt",
+        '&' , "amp",
+        '\'', "apos" ,
+        '"' , "quot",
+
+        0
+    );
+
+    BOOST_TEST_FOREACH( char, c, value ) {
+        char const* ref = char_type[c];
+
+        if( ref )
+            where_to << '&' << ref << ';';
+        else
+            where_to << c;
+    }
+}
+
+//____________________________________________________________________________//
+
+std::string
+make_value( std::size_t special_every )
+{
+    static char const text[]     = "check v1 == v2 has failed [0.25 != 0.5]. ";
+    static char const specials[] = "<>&'\"]";
+
+    std::string value;
+    for( std::size_t i = 0; value.size() < s_value_size; ++i ) {
+        value += text[i % (sizeof(text) - 1)];
+
+        if( special_every && i % special_every == 0 )
+            value += specials[i / special_every % (sizeof(specials) - 1)];
+    }
+
+    return value;
+}
+
+//____________________________________________________________________________//
+
+void
+report( char const* name, void (*print)( std::ostream&, const_string ), std::string const& value )
+{
+    null_buf     buf;
+    std::ostream ostr( &buf );
+
+    process_timer t;
+
+    for( unsigned i = 0; i < s_iterations; ++i )
+        print( ostr, value );
+
+    elapsed_time elapsed = t.elapsed();
+
+    double mb = double(value.size()) * s_iterations / (1024 * 1024);
+
+    std::cout << std::setw( 40 ) << std::left << name
+              << std::setw( 10 ) << std::right << std::fixed << std::setprecision( 0 )
+              << mb / elapsed.seconds() << " MB/s" << std::endl;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( clean_text )
+{
+    std::string value = make_value( 0 );
+
+    report( "attribute, per character", &per_char_escaped, value );
+    report( "attribute", &print_escaped, value );
+    report( "CDATA", &print_escaped_cdata, value );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( special_char_every_40_chars )
+{
+    std::string value = make_value( 40 );
+
+    report( "attribute, per character", &per_char_escaped, value );
+    report( "attribute", &print_escaped, value );
+    report( "CDATA", &print_escaped_cdata, value );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( special_char_every_4_chars )
+{
+    std::string value = make_value( 4 );
+
+    report( "attribute, per character", &per_char_escaped, value );
+    report( "attribute", &print_escaped, value );
+    report( "CDATA", &print_escaped_cdata, value );
+}
+
+//____________________________________________________________________________//
+
+// EOF
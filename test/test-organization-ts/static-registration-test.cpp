@@ -0,0 +1,125 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : static registration of the test units unit test
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE static registration test
+#define BOOST_TEST_STATIC_REGISTRATION
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+// Boost
+#include <boost/mpl/list.hpp>
+
+// STL
+#include <vector>
+#include <string>
+
+using namespace boost::unit_test;
+
+//____________________________________________________________________________//
+
+static std::vector<std::string> s_executed;
+
+struct fixture {
+    fixture() : m_value( 10 ) {}
+
+    int m_value;
+};
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_SUITE( S1 )
+
+BOOST_AUTO_TEST_CASE( tc1, * label( "l1" ) ) { s_executed.push_back( "S1/tc1" ); }
+BOOST_AUTO_TEST_CASE( tc2 ) { s_executed.push_back( "S1/tc2" ); }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( S2, * label( "suite" ) )
+
+BOOST_FIXTURE_TEST_CASE( fixture_tc, fixture ) { BOOST_TEST( m_value == 10 ); s_executed.push_back( "S2/fixture_tc" ); }
+
+BOOST_AUTO_TEST_SUITE( S21 )
+
+typedef boost::mpl::list<int,long> test_types;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( template_tc, T, test_types ) { s_executed.push_back( "S2/S21/template_tc" ); }
+
+BOOST_DATA_TEST_CASE( data_tc, data::xrange( 3 ), i ) { s_executed.push_back( "S2/S21/data_tc" ); }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_TEST_DECORATOR( * expected_failures( 1 ) ) BOOST_AUTO_TEST_CASE( expected_failure_tc ) { BOOST_ERROR( "expected" ); }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// the suite is reopened
+BOOST_AUTO_TEST_SUITE( S1 )
+
+BOOST_AUTO_TEST_CASE( tc3 ) { s_executed.push_back( "S1/tc3" ); }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//____________________________________________________________________________//
+
+// the test units registered by the dynamic initialization of this translation unit
+static std::size_t const s_units_at_dynamic_init = framework::master_test_suite().size();
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_tree )
+{
+#ifdef BOOST_TEST_IMPL_STATIC_REGISTRATION
+    BOOST_TEST( s_units_at_dynamic_init == 0U );
+#endif
+
+    test_suite const& mts = framework::master_test_suite();
+
+    BOOST_TEST( mts.size() == 4U );
+
+    test_suite const& s1 = framework::get<test_suite>( mts.get( "S1" ) );
+    BOOST_TEST( s1.size() == 3U );
+    BOOST_TEST( s1.get( "tc3" ) != INV_TEST_UNIT_ID );
+    BOOST_TEST( framework::get<test_case>( s1.get( "tc1" ) ).has_label( "l1" ) );
+    BOOST_TEST( !framework::get<test_case>( s1.get( "tc2" ) ).has_label( "l1" ) );
+
+    test_suite const& s2 = framework::get<test_suite>( mts.get( "S2" ) );
+    BOOST_TEST( s2.size() == 3U );
+    BOOST_TEST( s2.has_label( "suite" ) );
+    BOOST_TEST( framework::get<test_case>( s2.get( "expected_failure_tc" ) ).p_expected_failures == 1U );
+    BOOST_TEST( framework::get<test_case>( s2.get( "fixture_tc" ) ).p_line_num == 52U );
+
+    test_suite const& s21 = framework::get<test_suite>( s2.get( "S21" ) );
+    BOOST_TEST( s21.size() == 5U );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( execution_order )
+{
+    char const* expected[] = {
+        "S1/tc1", "S1/tc2", "S1/tc3",
+        "S2/fixture_tc",
+        "S2/S21/template_tc", "S2/S21/template_tc",
+        "S2/S21/data_tc", "S2/S21/data_tc", "S2/S21/data_tc"
+    };
+
+    BOOST_CHECK_EQUAL_COLLECTIONS( s_executed.begin(), s_executed.end(),
+                                   expected, expected + sizeof(expected)/sizeof(expected[0]) );
+}
+
+//____________________________________________________________________________//
+
+// EOF
@@ -0,0 +1,70 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : unit test for the pool of the file names of the test units
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE string pool test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/detail/string_pool.hpp>
+
+// STL
+#include <string>
+
+using namespace boost::unit_test;
+using ut_detail::string_pool;
+
+//____________________________________________________________________________//
+
+void empty_() {}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( interned_strings )
+{
+    string_pool& pool = string_pool::instance();
+
+    std::string  file1( "some/test/file.cpp" );
+    std::string  file2( file1 );
+    const_string interned = pool.intern( file1 );
+
+    BOOST_TEST( interned == file1 );
+    BOOST_TEST( (void const*)interned.begin() != (void const*)file1.c_str() );
+    BOOST_TEST( interned.begin()[interned.size()] == '\0' );
+
+    // the equal strings are stored once
+    BOOST_TEST( (void const*)pool.intern( file2 ).begin() == (void const*)interned.begin() );
+    BOOST_TEST( (void const*)pool.intern( "other.cpp" ).begin() != (void const*)interned.begin() );
+    BOOST_TEST( (void const*)pool.intern( file2 ).begin() == (void const*)interned.begin() );
+
+    BOOST_TEST( pool.intern( const_string() ).is_empty() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_units_refer_to_interned_file_names )
+{
+    std::string file1( "generated/test/file.cpp" );
+    std::string file2( file1 );
+
+    test_case* tc1 = make_test_case( &empty_, "tc1", file1, 1 );
+    test_case* tc2 = make_test_case( &empty_, "tc2", file2, 2 );
+
+    file1.assign( file1.size(), 'x' );
+
+    BOOST_TEST( tc1->p_file_name == const_string( "generated/test/file.cpp" ) );
+    BOOST_TEST( (void const*)tc1->p_file_name.get().begin() == (void const*)tc2->p_file_name.get().begin() );
+}
+
+//____________________________________________________________________________//
+
+// EOF
@@ -214,7 +214,7 @@ BOOST_AUTO_TEST_CASE( automated_test_units_registration )
 {
     test_suite& mts = framework::master_test_suite();
 
-    BOOST_TEST( mts.size() == 10U );
+    BOOST_TEST( mts.size() == 11U );
     BOOST_TEST( mts.p_expected_failures == 2U );
 
     BOOST_TEST( framework::get<test_case>( mts.get( "automated_test_units_registration" ) ).p_expected_failures == 0U );
@@ -326,4 +326,21 @@ BOOST_AUTO_TEST_CASE( user_class_test_case )
 
 //____________________________________________________________________________//
 
+BOOST_AUTO_TEST_CASE( invalid_test_unit_id_lookup )
+{
+    test_case* tc1 = BOOST_TEST_CASE( &empty_ );
+    test_unit_id tc1_id = tc1->p_id;
+
+    BOOST_CHECK_THROW( framework::get( INV_TEST_UNIT_ID, TUT_ANY ), framework::internal_error );
+    BOOST_CHECK_THROW( framework::get( 0, TUT_ANY ), framework::internal_error );
+    BOOST_CHECK_THROW( framework::get( tc1_id + 1000, TUT_ANY ), framework::internal_error );
+    BOOST_CHECK_THROW( framework::get( MAX_TEST_SUITE_ID - 1, TUT_ANY ), framework::internal_error );
+
+    // the failed lookups do not leave anything behind
+    BOOST_TEST( &framework::get( tc1_id, TUT_CASE ) == tc1 );
+    BOOST_CHECK_THROW( framework::get( tc1_id + 1000, TUT_ANY ), framework::internal_error );
+}
+
+//____________________________________________________________________________//
+
 // EOF
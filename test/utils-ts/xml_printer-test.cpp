@@ -0,0 +1,124 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : xml printer unit test
+// *****************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE xml printer unit test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/utils/xml_printer.hpp>
+
+// STL
+#include <sstream>
+#include <string>
+
+namespace utf = boost::unit_test;
+
+//____________________________________________________________________________//
+
+static std::string
+escaped( std::string const& value )
+{
+    std::ostringstream ostr;
+    utf::print_escaped( ostr, value );
+    return ostr.str();
+}
+
+//____________________________________________________________________________//
+
+static std::string
+escaped_cdata( std::string const& value )
+{
+    std::ostringstream ostr;
+    utf::print_escaped_cdata( ostr, value );
+    return ostr.str();
+}
+
+//____________________________________________________________________________//
+
+// character by character reference implementation
+static std::string
+reference_escaped( std::string const& value )
+{
+    std::string res;
+
+    for( std::string::size_type i = 0; i < value.size(); ++i ) {
+        switch( value[i] ) {
+        case '<':  res += "&lt;";   break;
+        case '>':  res += "&gt;";   break;
+        case '&':  res += "&amp;";  break;
+        case '\'': res += "&apos;"; break;
+        case '"':  res += "&quot;"; break;
+        default:   res += value[i];
+        }
+    }
+
+    return res;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_print_escaped )
+{
+    BOOST_TEST( escaped( "" ) == "" );
+    BOOST_TEST( escaped( "abc" ) == "abc" );
+    BOOST_TEST( escaped( "<>&'\"" ) == "&lt;&gt;&amp;&apos;&quot;" );
+    BOOST_TEST( escaped( "a < b && c > \"d\"" ) == "a &lt; b &amp;&amp; c &gt; &quot;d&quot;" );
+    BOOST_TEST( escaped( std::string( "a\0<b", 4 ) ) == std::string( "a\0&lt;b", 7 ) );
+    BOOST_TEST( escaped( "\x80\xff<\x3c" ) == "\x80\xff&lt;&lt;" );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_print_escaped_at_every_position )
+{
+    char const specials[] = "<>&'\"";
+
+    // special characters at every offset relative to the word and vector boundaries
+    for( std::size_t len = 0; len < 70; ++len ) {
+        for( std::size_t pos = 0; pos < len; ++pos ) {
+            for( std::size_t s = 0; s < sizeof(specials) - 1; ++s ) {
+                std::string value( len, 'x' );
+                value[pos] = specials[s];
+                value[len - 1 - pos] = specials[(s + 1) % (sizeof(specials) - 1)];
+
+                BOOST_TEST_REQUIRE( escaped( value ) == reference_escaped( value ) );
+            }
+        }
+    }
+
+    // characters one off the special ones
+    std::string value;
+    for( int c = 1; c < 256; ++c )
+        value += static_cast<char>( c );
+
+    BOOST_TEST( escaped( value ) == reference_escaped( value ) );
+    BOOST_TEST( escaped( value + value + value ) == reference_escaped( value + value + value ) );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_print_escaped_cdata )
+{
+    BOOST_TEST( escaped_cdata( "" ) == "" );
+    BOOST_TEST( escaped_cdata( "<a & b>" ) == "<a & b>" );
+    BOOST_TEST( escaped_cdata( "]]" ) == "]]" );
+    BOOST_TEST( escaped_cdata( "]>]]" ) == "]>]]" );
+    BOOST_TEST( escaped_cdata( "]]>" ) == "]]]]><![CDATA[>" );
+    BOOST_TEST( escaped_cdata( "a]]]>b" ) == "a]]]]]><![CDATA[>b" );
+    BOOST_TEST( escaped_cdata( "a]]>b]]>c" ) == "a]]]]><![CDATA[>b]]]]><![CDATA[>c" );
+    BOOST_TEST( escaped_cdata( "]]>]]>" ) == "]]]]><![CDATA[>]]]]><![CDATA[>" );
+}
+
+//____________________________________________________________________________//
+
+// EOF
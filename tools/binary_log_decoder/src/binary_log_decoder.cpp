@@ -0,0 +1,619 @@
+//  (C) Copyright Gennadiy Rozental 2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  Description : converts the log written with --log_format=BIN into the human readable, XML or JSON lines format
+// ***************************************************************************
+
+// Boost.Test
+#include <boost/test/output/binary_log_formatter.hpp>
+#include <boost/test/execution_monitor.hpp>
+#include <boost/test/utils/xml_printer.hpp>
+#include <boost/test/utils/json_printer.hpp>
+#include <boost/test/utils/basic_cstring/io.hpp>
+#include <boost/test/utils/basic_cstring/compare.hpp>
+
+// Boost.Runtime.Param
+#include <boost/test/utils/runtime/cla/named_parameter.hpp>
+#include <boost/test/utils/runtime/cla/parser.hpp>
+
+namespace rt  = boost::runtime;
+namespace cla = boost::runtime::cla;
+
+// Boost
+#include <boost/scoped_ptr.hpp>
+
+// STL
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <stdexcept>
+
+using namespace boost::unit_test;
+using boost::unit_test::output::binary_log_reader;
+namespace binary_log = boost::unit_test::output::binary_log;
+
+typedef binary_log_reader::record   log_record;
+typedef boost::uintmax_t            number;
+
+//____________________________________________________________________________//
+
+// Test units defined by the log, along with the state shared by all the writers
+class log_writer {
+public:
+    explicit log_writer( std::ostream& os ) : m_os( os ) {}
+    virtual ~log_writer() {}
+
+    void                write( log_record const& r )
+    {
+        if( r.m_type == binary_log::UNIT ) {
+            unit_info& u = m_units[static_cast<test_unit_id>( r.m_numbers[0] )];
+
+            u.m_type        = static_cast<test_unit_type>( r.m_numbers[1] );
+            u.m_type_name   = std::string( r.m_strings[0].begin(), r.m_strings[0].size() );
+            u.m_name        = std::string( r.m_strings[1].begin(), r.m_strings[1].size() );
+            u.m_file_name   = std::string( r.m_strings[2].begin(), r.m_strings[2].size() );
+            u.m_line_num    = static_cast<std::size_t>( r.m_numbers[2] );
+            u.m_parent_id   = static_cast<test_unit_id>( r.m_numbers[3] );
+            return;
+        }
+
+        write_record( r );
+    }
+
+protected:
+    struct unit_info {
+        unit_info() : m_type( TUT_CASE ), m_line_num( 0 ), m_parent_id( INV_TEST_UNIT_ID ) {}
+
+        test_unit_type  m_type;
+        std::string     m_type_name;
+        std::string     m_name;
+        std::string     m_file_name;
+        std::size_t     m_line_num;
+        test_unit_id    m_parent_id;
+    };
+
+    virtual void        write_record( log_record const& r ) = 0;
+
+    unit_info const&    unit( number id )
+    {
+        std::map<test_unit_id,unit_info>::const_iterator it = m_units.find( static_cast<test_unit_id>( id ) );
+        if( it == m_units.end() )
+            throw std::runtime_error( "malformed binary log: undefined test unit" );
+
+        return it->second;
+    }
+
+    std::string         full_name( number id )
+    {
+        unit_info const& u = unit( id );
+
+        return u.m_parent_id == INV_TEST_UNIT_ID ? u.m_name : full_name( u.m_parent_id ) + "/" + u.m_name;
+    }
+
+    std::ostream&       m_os;
+
+private:
+    std::map<test_unit_id,unit_info> m_units;
+};
+
+//____________________________________________________________________________//
+
+std::string
+boost_version( number version )
+{
+    std::ostringstream res;
+    res << version/100000 << "." << version/100 % 1000 << "." << version % 100;
+
+    return res.str();
+}
+
+//____________________________________________________________________________//
+
+// Same output as compiler_log_formatter without colors
+class hrf_writer : public log_writer {
+public:
+    explicit hrf_writer( std::ostream& os ) : log_writer( os ) {}
+
+private:
+    void                print_prefix( const_string file_name, number line_num )
+    {
+        if( !file_name.empty() )
+        {
+#ifdef __APPLE_CC__
+            m_os << file_name << ':' << line_num << ": ";
+#else
+            m_os << file_name << '(' << line_num << "): ";
+#endif
+        }
+    }
+
+    std::string         print_time( number value )
+    {
+        number us = value / 1000;
+
+        std::ostringstream res;
+        if( us != 0 && us % 1000 == 0 )
+            res << us/1000 << "ms";
+        else
+            res << us << "us";
+
+        return res.str();
+    }
+
+    std::string         test_phase_identifier( number tc_id )
+    {
+        return tc_id != INV_TEST_UNIT_ID ? full_name( tc_id ) : std::string( "Test setup" );
+    }
+
+    virtual void        write_record( log_record const& r )
+    {
+        std::vector<number> const&          n = r.m_numbers;
+        std::vector<const_string> const&    s = r.m_strings;
+
+        switch( r.m_type ) {
+        case binary_log::LOG_START:
+            if( n[0] > 0 )
+                m_os << "Running " << n[0] << " test " << (n[0] > 1 ? "cases" : "case") << "...\n";
+            break;
+        case binary_log::LOG_FINISH:
+            m_os.flush();
+            break;
+        case binary_log::BUILD_INFO:
+            m_os << "Platform: " << s[0] << '\n'
+                 << "Compiler: " << s[1] << '\n'
+                 << "STL     : " << s[2] << '\n'
+                 << "Boost   : " << boost_version( n[0] ) << std::endl;
+            break;
+        case binary_log::UNIT_START: {
+            unit_info const& u = unit( n[0] );
+
+            print_prefix( u.m_file_name, u.m_line_num );
+            m_os << "Entering test " << u.m_type_name << " \"" << u.m_name << "\"" << std::endl;
+            break;
+        }
+        case binary_log::UNIT_FINISH: {
+            unit_info const& u = unit( n[0] );
+
+            print_prefix( u.m_file_name, u.m_line_num );
+            m_os << "Leaving test " << u.m_type_name << " \"" << u.m_name << "\"";
+
+            if( n[1] / 1000 > 0 ) {
+                m_os << "; testing time: " << print_time( n[1] );
+
+                if( n[2] != 0 || n[3] != 0 )
+                    m_os << "; CPU time: " << print_time( n[2] ) << " user, " << print_time( n[3] ) << " system";
+            }
+
+            m_os << std::endl;
+            break;
+        }
+        case binary_log::UNIT_SKIPPED: {
+            unit_info const& u = unit( n[0] );
+
+            print_prefix( u.m_file_name, u.m_line_num );
+            m_os << "Test " << u.m_type_name << " \"" << full_name( n[0] ) << "\"" << " is skipped because " << s[0] << std::endl;
+            break;
+        }
+        case binary_log::EXCEPTION_START:
+            print_prefix( s[0], n[1] );
+            m_os << "fatal error: in \"" << (s[1].is_empty() ? test_phase_identifier( n[0] ) : std::string( s[1].begin(), s[1].size() ))
+                 << "\": " << s[2];
+
+            if( !s[3].is_empty() ) {
+                m_os << '\n';
+                print_prefix( s[3], n[3] );
+
+                m_os << "last checkpoint";
+                if( !s[4].is_empty() )
+                    m_os << ": " << s[4];
+            }
+            break;
+        case binary_log::EXCEPTION_FINISH:
+            m_os << std::endl;
+            break;
+        case binary_log::ENTRY_START:
+            switch( n[1] ) {
+            case unit_test_log_formatter::BOOST_UTL_ET_INFO:
+                print_prefix( s[0], n[2] );
+                m_os << "info: ";
+                break;
+            case unit_test_log_formatter::BOOST_UTL_ET_MESSAGE:
+                break;
+            case unit_test_log_formatter::BOOST_UTL_ET_WARNING:
+                print_prefix( s[0], n[2] );
+                m_os << "warning: in \"" << test_phase_identifier( n[0] ) << "\": ";
+                break;
+            case unit_test_log_formatter::BOOST_UTL_ET_ERROR:
+                print_prefix( s[0], n[2] );
+                m_os << "error: in \"" << test_phase_identifier( n[0] ) << "\": ";
+                break;
+            case unit_test_log_formatter::BOOST_UTL_ET_FATAL_ERROR:
+                print_prefix( s[0], n[2] );
+                m_os << "fatal error: in \"" << test_phase_identifier( n[0] ) << "\": ";
+                break;
+            }
+            break;
+        case binary_log::ENTRY_VALUE:
+            m_os << s[0];
+            break;
+        case binary_log::ENTRY_FINISH:
+            m_os << std::endl;
+            break;
+        case binary_log::CONTEXT_START:
+            m_os << (n[0] == log_successful_tests ? "\nAssertion" : "\nFailure" ) << " occurred in a following context:";
+            break;
+        case binary_log::CONTEXT_VALUE:
+            m_os << "\n    " << s[0];
+            break;
+        case binary_log::CONTEXT_FINISH:
+            m_os.flush();
+            break;
+        default:
+            break;
+        }
+    }
+};
+
+//____________________________________________________________________________//
+
+// Same output as xml_log_formatter
+class xml_writer : public log_writer {
+public:
+    explicit xml_writer( std::ostream& os ) : log_writer( os ), m_value_closed( true ) {}
+
+private:
+    static const_string tu_type_name( unit_info const& u )
+    {
+        return u.m_type == TUT_CASE ? "TestCase" : "TestSuite";
+    }
+
+    virtual void        write_record( log_record const& r )
+    {
+        static literal_string xml_tags[] = { "Info", "Message", "Warning", "Error", "FatalError" };
+
+        std::vector<number> const&          n = r.m_numbers;
+        std::vector<const_string> const&    s = r.m_strings;
+
+        switch( r.m_type ) {
+        case binary_log::LOG_START:
+            m_os << "<TestLog>";
+            break;
+        case binary_log::LOG_FINISH:
+            m_os << "</TestLog>";
+            break;
+        case binary_log::BUILD_INFO:
+            m_os << "<BuildInfo"
+                 << " platform" << attr_value() << s[0]
+                 << " compiler" << attr_value() << s[1]
+                 << " stl"      << attr_value() << s[2]
+                 << " boost=\"" << boost_version( n[0] ) << '\"'
+                 << "/>";
+            break;
+        case binary_log::UNIT_START: {
+            unit_info const& u = unit( n[0] );
+
+            m_os << "<" << tu_type_name( u ) << " name" << attr_value() << u.m_name;
+
+            if( !u.m_file_name.empty() )
+                m_os << " file" << attr_value() << u.m_file_name
+                     << " line" << attr_value() << u.m_line_num;
+
+            m_os << ">";
+            break;
+        }
+        case binary_log::UNIT_FINISH: {
+            unit_info const& u = unit( n[0] );
+
+            if( u.m_type == TUT_CASE )
+                m_os << "<TestingTime>" << n[1] / 1000 << "</TestingTime>"
+                     << "<WallTime>" << n[1] << "</WallTime>"
+                     << "<UserTime>" << n[2] << "</UserTime>"
+                     << "<SystemTime>" << n[3] << "</SystemTime>";
+
+            m_os << "</" << tu_type_name( u ) << ">";
+            break;
+        }
+        case binary_log::UNIT_SKIPPED: {
+            unit_info const& u = unit( n[0] );
+
+            m_os << "<" << tu_type_name( u )
+                 << " name"    << attr_value() << u.m_name
+                 << " skipped" << attr_value() << "yes"
+                 << " reason"  << attr_value() << s[0]
+                 << "/>";
+            break;
+        }
+        case binary_log::EXCEPTION_START:
+            m_os << "<Exception file" << attr_value() << s[0]
+                 << " line"           << attr_value() << n[1];
+
+            if( !s[1].is_empty() )
+                m_os << " function"   << attr_value() << s[1];
+
+            m_os << ">" << cdata() << s[2];
+
+            if( !s[3].is_empty() ) {
+                m_os << "<LastCheckpoint file" << attr_value() << s[3]
+                     << " line"                << attr_value() << n[3]
+                     << ">"
+                     << cdata() << s[4]
+                     << "</LastCheckpoint>";
+            }
+            break;
+        case binary_log::EXCEPTION_FINISH:
+            m_os << "</Exception>";
+            break;
+        case binary_log::ENTRY_START:
+            m_curr_tag = n[1] < sizeof(xml_tags)/sizeof(xml_tags[0]) ? xml_tags[n[1]] : xml_tags[0];
+            m_os << '<' << m_curr_tag
+                 << " file" << attr_value() << s[0]
+                 << " line" << attr_value() << n[2]
+                 << "><![CDATA[";
+
+            m_value_closed = false;
+            break;
+        case binary_log::ENTRY_VALUE:
+            print_escaped_cdata( m_os, s[0] );
+            break;
+        case binary_log::ENTRY_FINISH:
+            if( !m_value_closed ) {
+                m_os << "]]>";
+                m_value_closed = true;
+            }
+
+            m_os << "</" << m_curr_tag << ">";
+            break;
+        case binary_log::CONTEXT_START:
+            if( !m_value_closed ) {
+                m_os << "]]>";
+                m_value_closed = true;
+            }
+
+            m_os << "<Context>";
+            break;
+        case binary_log::CONTEXT_VALUE:
+            m_os << "<Frame>" << cdata() << s[0] << "</Frame>";
+            break;
+        case binary_log::CONTEXT_FINISH:
+            m_os << "</Context>";
+            break;
+        default:
+            break;
+        }
+    }
+
+    const_string        m_curr_tag;
+    bool                m_value_closed;
+};
+
+//____________________________________________________________________________//
+
+// Same output as json_log_formatter: one self-contained JSON object per line, the context frames follow the entry or
+// exception they belong to
+class json_writer : public log_writer {
+public:
+    explicit json_writer( std::ostream& os ) : log_writer( os ), m_entry_in_progress( false ) {}
+
+private:
+    void                print_string( const_string value )
+    {
+        m_os << json_string() << value;
+    }
+
+    void                print_test_case( number tc_id )
+    {
+        m_os << ",\"test_case\":";
+        if( tc_id == INV_TEST_UNIT_ID )
+            m_os << "null";
+        else
+            print_string( full_name( tc_id ) );
+    }
+
+    void                print_unit( char const* event, number id )
+    {
+        unit_info const& u = unit( id );
+
+        m_os << "{\"event\":\"" << event << "\",\"unit\":\"" << (u.m_type == TUT_CASE ? "case" : "suite") << "\",\"name\":";
+        print_string( u.m_name );
+        m_os << ",\"full_name\":";
+        print_string( full_name( id ) );
+    }
+
+    void                finish_entry()
+    {
+        if( !m_entry_in_progress )
+            return;
+
+        m_os << ",\"message\":";
+        print_string( m_entry_value );
+        m_os << "}\n";
+
+        m_entry_in_progress = false;
+    }
+
+    virtual void        write_record( log_record const& r )
+    {
+        static char const* entry_types[] = { "info", "message", "warning", "error", "fatal_error" };
+
+        std::vector<number> const&          n = r.m_numbers;
+        std::vector<const_string> const&    s = r.m_strings;
+
+        switch( r.m_type ) {
+        case binary_log::LOG_START:
+            m_os << "{\"event\":\"log_start\",\"test_cases\":" << n[0] << "}\n";
+            break;
+        case binary_log::LOG_FINISH:
+            m_os << "{\"event\":\"log_finish\"}\n";
+            m_os.flush();
+            break;
+        case binary_log::BUILD_INFO:
+            m_os << "{\"event\":\"build_info\",\"platform\":";
+            print_string( s[0] );
+            m_os << ",\"compiler\":";
+            print_string( s[1] );
+            m_os << ",\"stl\":";
+            print_string( s[2] );
+            m_os << ",\"boost\":\"" << boost_version( n[0] ) << "\"}\n";
+            break;
+        case binary_log::UNIT_START: {
+            unit_info const& u = unit( n[0] );
+
+            print_unit( "unit_start", n[0] );
+            m_os << ",\"file\":";
+            print_string( u.m_file_name );
+            m_os << ",\"line\":" << u.m_line_num << "}\n";
+            m_os.flush();
+            break;
+        }
+        case binary_log::UNIT_FINISH:
+            print_unit( "unit_finish", n[0] );
+            m_os << ",\"wall_ns\":" << n[1] << ",\"user_ns\":" << n[2] << ",\"system_ns\":" << n[3] << "}\n";
+            m_os.flush();
+            break;
+        case binary_log::UNIT_SKIPPED:
+            print_unit( "unit_skipped", n[0] );
+            m_os << ",\"reason\":";
+            print_string( s[0] );
+            m_os << "}\n";
+            m_os.flush();
+            break;
+        case binary_log::EXCEPTION_START:
+            m_os << "{\"event\":\"exception\"";
+            print_test_case( n[0] );
+            m_os << ",\"file\":";
+            print_string( s[0] );
+            m_os << ",\"line\":" << n[1] << ",\"function\":";
+            print_string( s[1] );
+            m_os << ",\"message\":";
+            print_string( s[2] );
+
+            if( !s[3].is_empty() ) {
+                m_os << ",\"checkpoint\":{\"file\":";
+                print_string( s[3] );
+                m_os << ",\"line\":" << n[3] << ",\"message\":";
+                print_string( s[4] );
+                m_os << "}";
+            }
+
+            m_os << "}\n";
+            break;
+        case binary_log::ENTRY_START:
+            m_os << "{\"event\":\"" << (n[1] < sizeof(entry_types)/sizeof(entry_types[0]) ? entry_types[n[1]] : entry_types[0]) << "\"";
+            print_test_case( n[0] );
+            m_os << ",\"file\":";
+            print_string( s[0] );
+            m_os << ",\"line\":" << n[2];
+
+            m_entry_value.clear();
+            m_entry_in_progress = true;
+            break;
+        case binary_log::ENTRY_VALUE:
+            m_entry_value.append( s[0].begin(), s[0].size() );
+            break;
+        case binary_log::ENTRY_FINISH:
+            finish_entry();
+            break;
+        case binary_log::CONTEXT_START:
+            finish_entry();
+            break;
+        case binary_log::CONTEXT_VALUE:
+            m_os << "{\"event\":\"context\",\"frame\":";
+            print_string( s[0] );
+            m_os << "}\n";
+            break;
+        default:
+            break;
+        }
+    }
+
+    bool                m_entry_in_progress;
+    std::string         m_entry_value;
+};
+
+//____________________________________________________________________________//
+
+int main( int argc, char* argv[] )
+{
+    try {
+        cla::parser P;
+
+        P << cla::named_parameter<std::string>( "input" ) - (cla::prefix = "--",cla::separator = "=",cla::guess_name)
+          << cla::named_parameter<std::string>( "format" ) - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional)
+          << cla::named_parameter<std::string>( "output" ) - (cla::prefix = "--",cla::separator = "=",cla::guess_name,cla::optional);
+
+        P.parse( argc, argv );
+
+        std::string input_name = P.get<std::string>( "input" );
+        std::string format( "HRF" );
+        std::string output_name;
+
+        if( P["format"] )
+            format = P.get<std::string>( "format" );
+        if( P["output"] )
+            output_name = P.get<std::string>( "output" );
+
+        std::ifstream input( input_name.c_str(), std::ios::in | std::ios::binary );
+        if( !input ) {
+            std::cerr << "Can't open " << input_name << std::endl;
+            return -1;
+        }
+
+        std::ostringstream log;
+        log << input.rdbuf();
+        std::string const& log_content = log.str();
+
+        std::ofstream output_file;
+        if( !output_name.empty() )
+            output_file.open( output_name.c_str() );
+        std::ostream& output = output_name.empty() ? std::cout : output_file;
+
+        boost::scoped_ptr<log_writer> writer;
+        if( case_ins_eq( const_string( format ), const_string( "XML" ) ) )
+            writer.reset( new xml_writer( output ) );
+        else if( case_ins_eq( const_string( format ), const_string( "JSON" ) ) )
+            writer.reset( new json_writer( output ) );
+        else if( case_ins_eq( const_string( format ), const_string( "HRF" ) ) )
+            writer.reset( new hrf_writer( output ) );
+        else {
+            std::cerr << "Invalid output format " << format << "; expected HRF, XML or JSON" << std::endl;
+            return -1;
+        }
+
+        binary_log_reader reader( log_content );
+        log_record r;
+        bool finished = false;
+
+        while( reader.next( r ) ) {
+            writer->write( r );
+
+            finished = r.m_type == binary_log::LOG_FINISH;
+        }
+
+        output.flush();
+
+        // the log of the test module which did not run to the end is decoded as far as it goes, but it is not complete
+        if( !finished ) {
+            std::cerr << "truncated log: " << input_name << " ends before the end of the test module" << std::endl;
+            return -1;
+        }
+
+        return 0;
+    }
+    catch( rt::logic_error const& ex ) {
+        std::cerr << "Fail to parse command line arguments: " << ex.msg() << std::endl;
+        return -1;
+    }
+    catch( std::runtime_error const& ex ) {
+        std::cerr << ex.what() << std::endl;
+        return -1;
+    }
+}
+
+//____________________________________________________________________________//
+
+// EOF